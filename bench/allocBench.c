@@ -0,0 +1,229 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file allocBench.c
+ * @brief checks stepping, queries and drawing stay off the heap once warmed up
+ *
+ * malloc, calloc and realloc are wrapped so every heap allocation in the
+ * process is counted, including ODE's and raylib's. Each scenario is
+ * built in a fresh context, stepped until it has warmed up, then stepped
+ * again with ray casts every step while the count should stay at zero.
+ * Every step is also drawn, DrawStatics and DrawBodies go through a
+ * recording graphics context so no window is needed. Exits with an
+ * error if any scenario allocates, build and run it with make bench
+ *
+ * @note the wrappers use glibc's __libc_ entry points, Linux only
+ */
+
+#include <stdio.h>
+#include <stddef.h>
+#include <math.h>
+#include "raylibODE.h"
+#include "ragdoll.h"
+#include "vehicle.h"
+
+#define WARM_STEPS 600
+#define CHECK_STEPS 2400
+#define PILE 400
+#define RAGDOLLS 8
+#define CARS 4
+#define RAYS 16
+
+// glibc's own allocator, the wrappers below forward to these
+extern void* __libc_malloc(size_t size);
+extern void* __libc_calloc(size_t n, size_t size);
+extern void* __libc_realloc(void* ptr, size_t size);
+extern void __libc_free(void* ptr);
+
+static bool counting = false;
+static unsigned long heapAllocs = 0;
+
+void* malloc(size_t size)
+{
+	if (counting) heapAllocs++;
+	return __libc_malloc(size);
+}
+
+void* calloc(size_t n, size_t size)
+{
+	if (counting) heapAllocs++;
+	return __libc_calloc(n, size);
+}
+
+void* realloc(void* ptr, size_t size)
+{
+	if (counting) heapAllocs++;
+	return __libc_realloc(ptr, size);
+}
+
+void free(void* ptr)
+{
+	__libc_free(ptr);
+}
+
+typedef struct Scenario {
+	const char* name;
+	void (*build)(PhysicsContext* ctx, GraphicsContext* gfx);
+	void (*update)(PhysicsContext* ctx, GraphicsContext* gfx, int step);
+} Scenario;
+
+static RagDoll* ragdolls[RAGDOLLS];
+static vehicle* cars[CARS];
+static RayCast* rays[RAYS];
+
+static void addGround(PhysicsContext* ctx, GraphicsContext* gfx)
+{
+	dGeomID ground = CreateBoxGeom(ctx, gfx, (Vector3){ 100, 1, 100 }, (Vector3){ 0, -0.5f, 0 });
+	clistAddNode(ctx->statics, ground);
+}
+
+// a heap of mixed shapes much like the fountain example
+static void buildPile(PhysicsContext* ctx, GraphicsContext* gfx)
+{
+	addGround(ctx, gfx);
+	for (int i = 0; i < PILE; i++) {
+		Vector3 pos = { rndf(-4, 4), 1 + i * 0.1f, rndf(-4, 4) };
+		Vector3 rot = { rndf(0, 6), rndf(0, 6), rndf(0, 6) };
+		switch (i % 4) {
+			case 0: CreateBox(ctx, gfx, (Vector3){ .5, .5, .5 }, pos, rot, 10); break;
+			case 1: CreateSphere(ctx, gfx, .3, pos, rot, 10); break;
+			case 2: CreateCylinder(ctx, gfx, .25, .8, pos, rot, 10); break;
+			default: CreateCapsule(ctx, gfx, .2, .6, pos, rot, 10); break;
+		}
+	}
+}
+
+// entities come and go every step, retired ones are reused
+static void churnPile(PhysicsContext* ctx, GraphicsContext* gfx, int step)
+{
+	int n = ctx->entities.table.count;
+	if (!n) return;
+	RetireEntity(ctx, GetEntityAt(ctx, step % n));
+	Vector3 pos = { rndf(-4, 4), 8, rndf(-4, 4) };
+	Vector3 rot = { 0, 0, 0 };
+	switch (step % 4) {
+		case 0: CreateBox(ctx, gfx, (Vector3){ .5, .5, .5 }, pos, rot, 10); break;
+		case 1: CreateSphere(ctx, gfx, .3, pos, rot, 10); break;
+		case 2: CreateCylinder(ctx, gfx, .25, .8, pos, rot, 10); break;
+		default: CreateCapsule(ctx, gfx, .2, .6, pos, rot, 10); break;
+	}
+}
+
+static void buildRagdolls(PhysicsContext* ctx, GraphicsContext* gfx)
+{
+	addGround(ctx, gfx);
+	for (int i = 0; i < RAGDOLLS; i++) {
+		ragdolls[i] = CreateRagdoll(ctx, gfx, (Vector3){ i * 1.5f - 6, 3, 0 });
+	}
+}
+
+static void buildCars(PhysicsContext* ctx, GraphicsContext* gfx)
+{
+	addGround(ctx, gfx);
+	for (int i = 0; i < CARS; i++) {
+		cars[i] = CreateVehicle(ctx, gfx, (Vector3){ i * 6.0f - 9, 2, 0 }, (Vector3){ 3.5, .5, 2.4 }, .8, .6);
+	}
+}
+
+static void driveCars(PhysicsContext* ctx, GraphicsContext* gfx, int step)
+{
+	(void)ctx;
+	(void)gfx;
+	for (int i = 0; i < CARS; i++) {
+		UpdateVehicle(cars[i], 1, (step / 240) % 2 ? .3f : -.3f);
+	}
+}
+
+static const Scenario scenarios[] = {
+	{ "pile", buildPile, NULL },
+	{ "churn", buildPile, churnPile },
+	{ "ragdolls", buildRagdolls, NULL },
+	{ "cars", buildCars, driveCars },
+};
+
+// one StepPhysics call taking a single world step, GetFrameTime is 0
+// without a window so the accumulated time is set directly, then a
+// frame drawn as the examples draw it
+static void step(PhysicsContext* ctx, GraphicsContext* gfx, const Scenario* s, int i)
+{
+	if (s->update) s->update(ctx, gfx, i);
+	ctx->frameTime = 1.5f / 240.0f;
+	StepPhysics(ctx);
+	for (int r = 0; r < RAYS; r++) {
+		CastRay(ctx, rays[r]);
+	}
+
+	ClearDrawRecords(&gfx->backend);
+	DrawStatics(gfx, ctx);
+	DrawBodies(gfx, ctx);
+}
+
+// returns the heap allocations made after warm up
+static unsigned long run(const Scenario* s, GraphicsContext* gfx)
+{
+	PhysicsContext* ctx = CreatePhysics();
+	s->build(ctx, gfx);
+
+	int i = 0;
+	for (; i < WARM_STEPS; i++) step(ctx, gfx, s, i);
+
+	heapAllocs = 0;
+	counting = true;
+	for (; i < WARM_STEPS + CHECK_STEPS; i++) step(ctx, gfx, s, i);
+	counting = false;
+
+	for (int r = 0; r < RAGDOLLS; r++) {
+		if (ragdolls[r]) FreeRagdoll(ctx, ragdolls[r]);
+		ragdolls[r] = NULL;
+	}
+	for (int c = 0; c < CARS; c++) {
+		if (cars[c]) FreeVehicle(ctx, cars[c]);
+		cars[c] = NULL;
+	}
+	FreePhysics(ctx);
+	return heapAllocs;
+}
+
+int main(void)
+{
+	TrackOdeAllocations(true); // ODE's own allocator mallocs every step
+	GraphicsContext* gfx = CreateRecordingGraphics(1280, 720);
+	for (int r = 0; r < RAYS; r++) {
+		float a = r * 2 * PI / RAYS;
+		rays[r] = CreateRayCast(8, (Vector3){ 0, .5f, 0 }, (Vector3){ cosf(a), 0, sinf(a) }, 20);
+	}
+
+	int failed = 0;
+	int count = sizeof(scenarios) / sizeof(scenarios[0]);
+	for (int i = 0; i < count; i++) {
+		unsigned long n = run(&scenarios[i], gfx);
+		printf("%-10s %5i steps after warm up  %6lu heap allocations%s\n",
+			scenarios[i].name, CHECK_STEPS, n, n ? "  FAIL" : "");
+		if (n) failed++;
+	}
+
+	for (int r = 0; r < RAYS; r++) FreeRayCast(rays[r]);
+	FreeGraphics(gfx);
+	return failed ? 1 : 0;
+}
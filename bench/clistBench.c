@@ -0,0 +1,130 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file clistBench.c
+ * @brief micro benchmark for the list library
+ *
+ * Times add, find, delete by data, sort and total on lists of 10k nodes,
+ * both with and without an index. No window or physics is needed, build
+ * and run it with make bench
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "clist.h"
+
+#define NODES 10000
+#define REPEATS 10
+
+static int items[NODES];
+static int order[NODES];
+
+static int cmpItems(cnode_t* n1, cnode_t* n2)
+{
+	return *(int*)n1->data > *(int*)n2->data;
+}
+
+static double msSince(clock_t start)
+{
+	return (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+}
+
+// shuffled visiting order so finds don't just walk from the head
+static void shuffle(void)
+{
+	for (int i = 0; i < NODES; i++) order[i] = i;
+	for (int i = NODES - 1; i > 0; i--) {
+		int j = rand() % (i + 1);
+		int t = order[i]; order[i] = order[j]; order[j] = t;
+	}
+}
+
+static void run(bool indexed)
+{
+	double tAdd = 0, tFind = 0, tSort = 0, tTotal = 0, tDelete = 0;
+	int found = 0, total = 0;
+
+	for (int r = 0; r < REPEATS; r++) {
+		clist_t* list = clistCreateList();
+		if (indexed) clistEnableIndex(list);
+
+		for (int i = 0; i < NODES; i++) items[i] = rand();
+		shuffle();
+
+		clock_t t = clock();
+		for (int i = 0; i < NODES; i++) clistAddNode(list, &items[i]);
+		tAdd += msSince(t);
+
+		t = clock();
+		for (int i = 0; i < NODES; i++) {
+			if (clistFindNode(list, &items[order[i]])) found++;
+		}
+		tFind += msSince(t);
+
+		t = clock();
+		clistSort(list, cmpItems);
+		tSort += msSince(t);
+
+		t = clock();
+		for (int i = 0; i < NODES; i++) total += clistTotal(list);
+		tTotal += msSince(t);
+
+		// check the sort actually sorted
+		for (cnode_t* n = list->head; n && n->next; n = n->next) {
+			if (cmpItems(n, n->next) > 0) {
+				printf("list is not sorted!\n");
+				exit(-1);
+			}
+		}
+
+		t = clock();
+		for (int i = 0; i < NODES; i++) clistDeleteNodeFromData(list, &items[order[i]]);
+		tDelete += msSince(t);
+
+		if (!clistIsEmpty(list) || clistTotal(list) != 0) {
+			printf("list should be empty!\n");
+			exit(-1);
+		}
+		clistFreeList(&list);
+	}
+
+	printf("%-9s add %8.3fms  find %8.3fms  sort %8.3fms  total %8.3fms  delete %8.3fms\n",
+		indexed ? "indexed" : "plain",
+		tAdd / REPEATS, tFind / REPEATS, tSort / REPEATS,
+		tTotal / REPEATS, tDelete / REPEATS);
+	if (found != NODES * REPEATS || total != NODES * NODES * REPEATS) {
+		printf("unexpected results found %i total %i\n", found, total);
+		exit(-1);
+	}
+}
+
+int main(void)
+{
+	srand(1234);
+	printf("%i nodes, average of %i runs\n", NODES, REPEATS);
+	run(false);
+	run(true);
+	return 0;
+}
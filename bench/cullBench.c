@@ -0,0 +1,181 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file cullBench.c
+ * @brief checks and times frustum culling without a window
+ *
+ * A handful of boxes with known answers are tested against fixed camera
+ * setups, then a large grid is culled with CullSetTest and compared box
+ * by box with FrustumTestBox. Exits with an error on any mismatch,
+ * build and run it with make bench
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include <math.h>
+#include "raylib.h"
+#include "raymath.h"
+#include "frustum.h"
+
+#define GRID 64		// GRID^3 boxes
+#define RUNS 100
+
+typedef struct Case {
+	const char* name;
+	Vector3 centre;
+	float half;
+	bool visible;
+} Case;
+
+// camera at the origin looking down +z, 45 degree fov, 0.1 to 100
+static const Case cases[] = {
+	{ "in front",			{ 0, 0, 10 },		.5f,	true },
+	{ "behind",				{ 0, 0, -10 },		.5f,	false },
+	{ "far left",			{ 50, 0, 10 },		.5f,	false },
+	{ "far right",			{ -50, 0, 10 },		.5f,	false },
+	{ "above",				{ 0, 50, 10 },		.5f,	false },
+	{ "below",				{ 0, -50, 10 },		.5f,	false },
+	{ "beyond far",			{ 0, 0, 150 },		.5f,	false },
+	{ "across far",			{ 0, 0, 100 },		1,		true },
+	{ "around camera",		{ 0, 0, 0 },		1,		true },
+	{ "edge of view",		{ 4.5f, 0, 10 },	.5f,	true },
+	{ "just outside",		{ 5.5f, 0, 10 },	.5f,	false },
+	{ "huge",				{ 0, 0, -500 },		1000,	true },
+};
+
+static double msSince(clock_t start)
+{
+	return (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+}
+
+static void boxBounds(Vector3 c, float h, float* aabb)
+{
+	aabb[0] = c.x - h; aabb[1] = c.x + h;
+	aabb[2] = c.y - h; aabb[3] = c.y + h;
+	aabb[4] = c.z - h; aabb[5] = c.z + h;
+}
+
+static int checkCases(const Frustum* f)
+{
+	int failed = 0;
+	CullSet cs = { 0 };
+	int n = sizeof(cases) / sizeof(cases[0]);
+	float aabb[6];
+
+	for (int i = 0; i < n; i++) {
+		boxBounds(cases[i].centre, cases[i].half, aabb);
+		CullSetAdd(&cs, (void*)&cases[i], aabb);
+	}
+	// an unbounded box, like a plane, is always kept
+	float plane[6] = { -INFINITY, INFINITY, -INFINITY, 0, -INFINITY, INFINITY };
+	CullSetAdd(&cs, NULL, plane);
+
+	CullSetTest(&cs, f);
+	for (int i = 0; i < n; i++) {
+		boxBounds(cases[i].centre, cases[i].half, aabb);
+		bool single = FrustumTestBox(f, aabb);
+		if (cs.visible[i] != cases[i].visible || single != cases[i].visible) {
+			printf("FAIL %s: expected %s\n", cases[i].name, cases[i].visible ? "visible" : "culled");
+			failed++;
+		}
+	}
+	if (!cs.visible[n] || !FrustumTestBox(f, plane)) {
+		printf("FAIL unbounded box was culled\n");
+		failed++;
+	}
+	FreeCullSet(&cs);
+	return failed;
+}
+
+// the same answers with the camera moved and turned, the view matrix must
+// be taken into account as well as the projection
+static int checkMovedCamera(void)
+{
+	Camera cam = { 0 };
+	cam.position = (Vector3){ 20, 5, 20 };
+	cam.target = (Vector3){ 20, 5, 30 };
+	cam.up = (Vector3){ 0, 1, 0 };
+	cam.fovy = 45;
+	Frustum f = FrustumFromCamera(cam, 1, 0.1f, 100);
+
+	float aabb[6];
+	int failed = 0;
+	boxBounds((Vector3){ 20, 5, 30 }, .5f, aabb);
+	if (!FrustumTestBox(&f, aabb)) { printf("FAIL moved camera: target culled\n"); failed++; }
+	boxBounds((Vector3){ 0, 0, 10 }, .5f, aabb);
+	if (FrustumTestBox(&f, aabb)) { printf("FAIL moved camera: box behind kept\n"); failed++; }
+
+	// turned to look down -x
+	cam.target = (Vector3){ 10, 5, 20 };
+	f = FrustumFromCamera(cam, 1, 0.1f, 100);
+	boxBounds((Vector3){ 10, 5, 20 }, .5f, aabb);
+	if (!FrustumTestBox(&f, aabb)) { printf("FAIL turned camera: target culled\n"); failed++; }
+	boxBounds((Vector3){ 20, 5, 30 }, .5f, aabb);
+	if (FrustumTestBox(&f, aabb)) { printf("FAIL turned camera: old target kept\n"); failed++; }
+	return failed;
+}
+
+int main(void)
+{
+	Camera cam = { 0 };
+	cam.position = (Vector3){ 0, 0, 0 };
+	cam.target = (Vector3){ 0, 0, 1 };
+	cam.up = (Vector3){ 0, 1, 0 };
+	cam.fovy = 45;
+	Frustum f = FrustumFromCamera(cam, 1, 0.1f, 100);
+
+	int failed = checkCases(&f);
+	failed += checkMovedCamera();
+
+	// a grid around the camera, about an eighth of it in view
+	CullSet cs = { 0 };
+	float aabb[6];
+	for (int i = 0; i < GRID * GRID * GRID; i++) {
+		Vector3 c = { (i % GRID) * 3.0f - GRID * 1.5f, ((i / GRID) % GRID) * 3.0f - GRID * 1.5f, (i / (GRID * GRID)) * 3.0f - GRID * 1.5f };
+		boxBounds(c, .5f, aabb);
+		CullSetAdd(&cs, NULL, aabb);
+	}
+
+	int visible = 0;
+	clock_t t = clock();
+	for (int r = 0; r < RUNS; r++) visible = CullSetTest(&cs, &f);
+	double ms = msSince(t) / RUNS;
+
+	int mismatches = 0;
+	for (int i = 0; i < cs.count; i++) {
+		for (int a = 0; a < 3; a++) {
+			aabb[a*2] = cs.centre[a][i] - cs.extent[a][i];
+			aabb[a*2 + 1] = cs.centre[a][i] + cs.extent[a][i];
+		}
+		if (FrustumTestBox(&f, aabb) != (bool)cs.visible[i]) mismatches++;
+	}
+	if (mismatches) {
+		printf("FAIL %i boxes differ between CullSetTest and FrustumTestBox\n", mismatches);
+		failed++;
+	}
+
+	printf("culled %i boxes, %i visible, %8.3fms per pass\n", cs.count, visible, ms);
+	FreeCullSet(&cs);
+	return failed ? 1 : 0;
+}
@@ -0,0 +1,216 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file drawBench.c
+ * @brief times and checks DrawBodies and DrawStatics without a window
+ *
+ * A 10k entity scene with a few hundred static boxes is drawn through
+ * a recording graphics context, once with everything in view and once
+ * close up where most of it is culled. The recorded draw lists are
+ * checked against the scene, then the camera is turned away and nothing
+ * should be drawn at all. Last the texture atlas is checked, every body
+ * should draw from it, and dropped to count the draw calls it saves.
+ * Build and run it with make bench
+ */
+
+// for clock_gettime, clock() would add up the time of every thread
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <math.h>
+#include <time.h>
+#include "raylibODE.h"
+
+#define ENTITIES 10000
+#define STATICS 400
+#define RUNS 50
+
+static EntityDesc descs[ENTITIES];
+
+static double msSince(struct timespec* start)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - start->tv_sec) * 1000.0 + (now.tv_nsec - start->tv_nsec) / 1e6;
+}
+
+static void makeScene(PhysicsContext* ctx, GraphicsContext* gfx)
+{
+	for (int i = 0; i < ENTITIES; i++) {
+		EntityDesc* d = &descs[i];
+		d->pos = (Vector3){ (i % 100) * 1.5f, 1 + (i / 1000) * 1.5f, ((i / 100) % 10) * 1.5f };
+		d->rot = (Vector3){ rndf(0, 6), rndf(0, 6), rndf(0, 6) };
+		d->mass = 10;
+		switch (i % 4) {
+			case 0: d->shape = SHAPE_BOX; d->size = (Vector3){ .5, .6, .7 }; break;
+			case 1: d->shape = SHAPE_SPHERE; d->size = (Vector3){ .3, 0, 0 }; break;
+			case 2: d->shape = SHAPE_CYLINDER; d->size = (Vector3){ .25, .8, 0 }; break;
+			default: d->shape = SHAPE_CAPSULE; d->size = (Vector3){ .2, .6, 0 }; break;
+		}
+	}
+	SpawnEntities(ctx, gfx, descs, ENTITIES, NULL);
+
+	// a floor of tiles under the grid
+	for (int i = 0; i < STATICS; i++) {
+		Vector3 pos = { (i % 40) * 4.0f - 4, -0.5f, (i / 40) * 4.0f - 12 };
+		clistAddNode(ctx->statics, CreateBoxGeom(ctx, gfx, (Vector3){ 4, 1, 4 }, pos));
+	}
+	BakeStaticRenderBatches(ctx, gfx);
+}
+
+// one frame, statics first as the examples do
+static void drawFrame(PhysicsContext* ctx, GraphicsContext* gfx)
+{
+	ClearDrawRecords(&gfx->backend);
+	DrawStatics(gfx, ctx);
+	DrawBodies(gfx, ctx);
+}
+
+static double timeFrames(PhysicsContext* ctx, GraphicsContext* gfx)
+{
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	for (int i = 0; i < RUNS; i++) drawFrame(ctx, gfx);
+	return msSince(&t) / RUNS;
+}
+
+// with everything in view the body draws should be every entity, where
+// it is, and the static draws one per batch
+static int checkRecords(PhysicsContext* ctx, GraphicsContext* gfx)
+{
+	int bad = 0;
+	RenderBackend* be = &gfx->backend;
+	RenderStats stats = GetRenderStats(gfx);
+	int batches = gfx->staticBatches.count;
+
+	if (stats.bodyGeoms != ENTITIES || stats.bodyGeomsCulled) {
+		printf("FAIL %i of %i bodies drawn, %i culled\n", stats.bodyGeoms, ENTITIES, stats.bodyGeomsCulled);
+		bad++;
+	}
+	if (be->recordCount != batches + ENTITIES) {
+		printf("FAIL %i draws recorded, expected %i\n", be->recordCount, batches + ENTITIES);
+		bad++;
+	}
+
+	// batches are world space, the entities are whatever comes after them
+	double recorded[3] = { 0 }, expected[3] = { 0 };
+	for (int i = 0; i < be->recordCount; i++) {
+		const DrawRecord* d = &be->records[i];
+		bool isBatch = i < batches;
+		if (isBatch && d->mesh != &gfx->staticBatches.batches[i].mesh) bad++;
+		if (!isBatch && (!d->mesh || !d->textureId || d->tint.a != 255)) bad++;
+		if (isBatch) continue;
+		for (int k = 0; k < 3; k++) recorded[k] += d->transform[12 + k];
+	}
+	for (int i = 0; i < ctx->entities.table.count; i++) {
+		const dReal* p = dBodyGetPosition(ctx->entities.bodies[i]);
+		for (int k = 0; k < 3; k++) expected[k] += p[k];
+	}
+	for (int k = 0; k < 3; k++) {
+		if (fabs(recorded[k] - expected[k]) > 1e-3 * ENTITIES) {
+			printf("FAIL recorded positions don't match the bodies\n");
+			bad++;
+			break;
+		}
+	}
+	return bad;
+}
+
+// every body draws from an atlas region, and no two regions overlap
+static int checkAtlas(GraphicsContext* gfx)
+{
+	int bad = 0;
+	const TextureAtlas* atlas = &gfx->atlas;
+	const RenderBackend* be = &gfx->backend;
+	int batches = gfx->staticBatches.count;
+
+	for (int i = batches; i < be->recordCount; i++) {
+		const DrawRecord* d = &be->records[i];
+		if (d->region < 1 || d->region > atlas->count || d->textureId != atlas->pages[0].texture.id) bad++;
+	}
+	if (bad) printf("FAIL %i bodies drawn without the atlas\n", bad);
+
+	for (int i = 1; i <= atlas->count; i++) {
+		const float* a = atlas->regions[i];
+		if (a[0] < 0 || a[1] < 0 || a[0] + a[2] > 1 || a[1] + a[3] > 1) bad++;
+		for (int k = 1; k < i; k++) {
+			const float* b = atlas->regions[k];
+			if (atlas->entries[i - 1].page != atlas->entries[k - 1].page) continue;
+			if (a[0] < b[0] + b[2] && b[0] < a[0] + a[2] && a[1] < b[1] + b[3] && b[1] < a[1] + a[3]) {
+				printf("FAIL atlas regions %i and %i overlap\n", k, i);
+				bad++;
+			}
+		}
+	}
+	return bad;
+}
+
+int main(void)
+{
+	GraphicsContext* gfx = CreateRecordingGraphics(1280, 720);
+	PhysicsContext* ctx = CreatePhysics();
+	makeScene(ctx, gfx);
+	int bad = 0;
+
+	gfx->camera = (Camera){ { 75, 60, 150 }, { 75, 5, 7 }, { 0, 1, 0 }, 45, CAMERA_PERSPECTIVE };
+	double inView = timeFrames(ctx, gfx);
+	bad += checkRecords(ctx, gfx);
+	RenderStats stats = GetRenderStats(gfx);
+	printf("all in view  %8.3fms/frame  %6i draws recorded  %3i body draw calls  %3i static batches\n",
+		inView, gfx->backend.recordCount, stats.bodyDrawCalls, stats.staticDrawCalls);
+
+	gfx->camera = (Camera){ { 20, 8, 30 }, { 20, 4, 7 }, { 0, 1, 0 }, 45, CAMERA_PERSPECTIVE };
+	double closeUp = timeFrames(ctx, gfx);
+	stats = GetRenderStats(gfx);
+	printf("close up     %8.3fms/frame  %6i draws recorded  %6i bodies culled\n",
+		closeUp, gfx->backend.recordCount, stats.bodyGeomsCulled);
+
+	// looking away from the scene
+	gfx->camera = (Camera){ { 75, 5, -50 }, { 75, 5, -100 }, { 0, 1, 0 }, 45, CAMERA_PERSPECTIVE };
+	drawFrame(ctx, gfx);
+	if (gfx->backend.recordCount) {
+		printf("FAIL %i draws recorded looking away from the scene\n", gfx->backend.recordCount);
+		bad++;
+	}
+
+	// without the atlas every texture is its own batch again
+	gfx->camera = (Camera){ { 75, 60, 150 }, { 75, 5, 7 }, { 0, 1, 0 }, 45, CAMERA_PERSPECTIVE };
+	drawFrame(ctx, gfx);
+	bad += checkAtlas(gfx);
+	int packed = gfx->atlas.count;
+	int atlasCalls = GetRenderStats(gfx).bodyDrawCalls;
+	FreeTextureAtlas(&gfx->atlas);
+	drawFrame(ctx, gfx);
+	int ownCalls = GetRenderStats(gfx).bodyDrawCalls;
+	printf("atlas        %3i textures packed  %3i body draw calls, %3i without it\n", packed, atlasCalls, ownCalls);
+	if (atlasCalls >= ownCalls) {
+		printf("FAIL the atlas didn't save any draw calls\n");
+		bad++;
+	}
+
+	if (bad) printf("FAIL %i problems with the recorded draws\n", bad);
+	FreePhysics(ctx);
+	FreeGraphics(gfx);
+	return bad ? 1 : 0;
+}
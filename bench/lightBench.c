@@ -0,0 +1,146 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file lightBench.c
+ * @brief times and checks picking lights from a large set
+ *
+ * 64 point lights are scattered over a scene and the MAX_LIGHTS nearest
+ * are picked for each cell of a grid of regions, as DrawInstances and
+ * the static batches do. The picks are checked against a brute force
+ * search, then the uniforms sent for a frame are counted with and
+ * without change tracking. No window is opened and nothing is really
+ * sent, build and run it with make bench
+ */
+
+// for clock_gettime, clock() would add up the time of every thread
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include "raylibODE.h"
+
+#define LIGHTS 64
+#define GRID 32
+#define RUNS 50
+
+static double msSince(struct timespec* start)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - start->tv_sec) * 1000.0 + (now.tv_nsec - start->tv_nsec) / 1e6;
+}
+
+static Vector3 cellCentre(int i)
+{
+	return (Vector3){ (i % GRID) * 8.0f + 4, 2, (i / GRID) * 8.0f + 4 };
+}
+
+// lights of equal brightness, so the nearest MAX_LIGHTS should be picked
+static int checkPicks(const LightSet* set, Vector3 centre, const Light* picked)
+{
+	float dist[LIGHTS];
+	bool wanted[LIGHTS] = { false };
+	for (int i = 0; i < set->count; i++) dist[i] = Vector3Distance(set->lights[i].position, centre);
+	for (int n = 0; n < MAX_LIGHTS; n++) {
+		int best = -1;
+		for (int i = 0; i < set->count; i++) {
+			if (!wanted[i] && (best < 0 || dist[i] < dist[best])) best = i;
+		}
+		wanted[best] = true;
+	}
+
+	// picks come back in set order
+	int slot = 0;
+	for (int i = 0; i < set->count; i++) {
+		if (!wanted[i]) continue;
+		if (!picked[slot].enabled || !Vector3Equals(picked[slot].position, set->lights[i].position)) return 1;
+		slot++;
+	}
+	return 0;
+}
+
+// a frame's worth of regions, returns the uniforms that were sent
+static int lightFrame(const LightSet* set, LightUniforms* u, Shader shader, bool tracked)
+{
+	int sent = 0;
+	Light picked[MAX_LIGHTS];
+	for (int i = 0; i < GRID * GRID; i++) {
+		SelectLights(set, cellCentre(i), 6, picked);
+		if (!tracked) u->valid = false;
+		sent += UploadLights(u, shader, picked);
+	}
+	return sent;
+}
+
+int main(void)
+{
+	LightSet set = { 0 };
+	for (int i = 0; i < LIGHTS; i++) {
+		Vector3 pos = { rndf(0, GRID * 8.0f), rndf(3, 10), rndf(0, GRID * 8.0f) };
+		AddSetLight(&set, LIGHT_POINT, pos, Vector3Zero(), (Color){ 128, 128, 128, 255 });
+	}
+
+	Light picked[MAX_LIGHTS];
+	int bad = 0;
+	for (int i = 0; i < GRID * GRID; i++) {
+		SelectLights(&set, cellCentre(i), 0, picked);
+		bad += checkPicks(&set, cellCentre(i), picked);
+	}
+
+	struct timespec t;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	for (int r = 0; r < RUNS; r++) {
+		for (int i = 0; i < GRID * GRID; i++) SelectLights(&set, cellCentre(i), 6, picked);
+	}
+	double select = msSince(&t) / RUNS;
+	printf("%i regions from %i lights  %8.3fms\n", GRID * GRID, LIGHTS, select);
+
+	// no shader, every location is -1 so nothing is really sent
+	Shader shader = { 0 };
+	LightUniforms u;
+	memset(&u, 0, sizeof(u));
+	for (int i = 0; i < MAX_LIGHTS; i++) {
+		Light* l = &u.slots[i];
+		l->enabledLoc = l->typeLoc = l->positionLoc = l->targetLoc = l->colorLoc = -1;
+	}
+
+	int every = lightFrame(&set, &u, shader, false);
+	int changed = lightFrame(&set, &u, shader, true);
+	printf("uniforms sent per frame  every time %6i  only changes %6i\n", every, changed);
+
+	// sending the same lights again sends nothing, moving one sends one
+	Light fixed[MAX_LIGHTS];
+	SelectLights(&set, cellCentre(0), 0, fixed);
+	UploadLights(&u, shader, fixed);
+	if (UploadLights(&u, shader, fixed) != 0) bad++;
+	fixed[1].position.y += 1;
+	if (UploadLights(&u, shader, fixed) != 1) bad++;
+	fixed[2].enabled = false;
+	if (UploadLights(&u, shader, fixed) != 1) bad++;
+
+	if (bad) printf("FAIL %i problems picking or sending lights\n", bad);
+	FreeLightSet(&set);
+	return bad ? 1 : 0;
+}
@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file prepBench.c
+ * @brief times building instance transforms for a 10k entity scene
+ *
+ * The old per geom path (OdeToRayMat, MatrixScale, MatrixTranslate and
+ * MatrixMultiply) is timed against gathering the poses into a RenderPrep
+ * and building them in bulk, on one thread and split across threads.
+ * The results are compared with each other. Then the scene settles and
+ * the gather and build is timed again with every geom reusing its cached
+ * transform. No window is opened, build and run it with make bench
+ */
+
+// for clock_gettime, clock() would add up the time of every thread
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <string.h>
+#include <math.h>
+#include <time.h>
+#include "raylibODE.h"
+
+#define ENTITIES 10000
+#define RUNS 50
+
+static EntityDesc descs[ENTITIES];
+static Matrix reference[ENTITIES];
+static TransformCache caches[ENTITIES];
+static InstanceSlot slots[ENTITIES];
+
+static double msSince(struct timespec* start)
+{
+	struct timespec now;
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return (now.tv_sec - start->tv_sec) * 1000.0 + (now.tv_nsec - start->tv_nsec) / 1e6;
+}
+
+static Vector3 shapeScale(dGeomID geom)
+{
+	dReal r, l;
+	dVector3 size;
+	switch (dGeomGetClass(geom)) {
+		case dBoxClass:
+			dGeomBoxGetLengths(geom, size);
+			return (Vector3){ size[0], size[1], size[2] };
+		case dSphereClass:
+			r = dGeomSphereGetRadius(geom);
+			return (Vector3){ r*2, r*2, r*2 };
+		case dCylinderClass:
+			dGeomCylinderGetParams(geom, &r, &l);
+			return (Vector3){ r*2, r*2, l };
+		default:
+			dGeomCapsuleGetParams(geom, &r, &l);
+			return (Vector3){ r*2, r*2, l };
+	}
+}
+
+// how DrawGeom used to build a transform
+static void buildScalar(PhysicsContext* ctx)
+{
+	for (int i = 0; i < ctx->entities.table.count; i++) {
+		dGeomID geom = dBodyGetFirstGeom(ctx->entities.bodies[i]);
+		const dReal* pos = dGeomGetPosition(geom);
+		const dReal* rot = dGeomGetRotation(geom);
+		Vector3 s = shapeScale(geom);
+
+		Matrix matRot;
+		OdeToRayMat(rot, &matRot);
+		Matrix matWorld = MatrixMultiply(matRot, MatrixTranslate(pos[0], pos[1], pos[2]));
+		reference[i] = MatrixMultiply(MatrixScale(s.x, s.y, s.z), matWorld);
+	}
+}
+
+static void gather(PhysicsContext* ctx, InstanceRenderer* r, RenderPrep* prep, Mesh* mesh)
+{
+	BeginInstancing(r);
+	RenderPrepClear(prep);
+	for (int i = 0; i < ctx->entities.table.count; i++) {
+		dGeomID geom = dBodyGetFirstGeom(ctx->entities.bodies[i]);
+		InstanceSlot slot = AddInstance(r, mesh, (AtlasRegion){ 0, 0 }, WHITE, (Vector2){ 1, 1 });
+		RenderPrepAdd(prep, dGeomGetPosition(geom), dGeomGetRotation(geom), shapeScale(geom), slot, NULL);
+	}
+}
+
+// what QueueGeom does for disabled bodies, returns how many were reused
+static int gatherCached(PhysicsContext* ctx, InstanceRenderer* r, RenderPrep* prep, Mesh* mesh)
+{
+	int reused = 0;
+	BeginInstancing(r);
+	RenderPrepClear(prep);
+	for (int i = 0; i < ctx->entities.table.count; i++) {
+		dGeomID geom = dBodyGetFirstGeom(ctx->entities.bodies[i]);
+		const dReal* pos = dGeomGetPosition(geom);
+		const dReal* rot = dGeomGetRotation(geom);
+		Vector3 s = shapeScale(geom);
+		slots[i] = AddInstance(r, mesh, (AtlasRegion){ 0, 0 }, WHITE, (Vector2){ 1, 1 });
+		if (TransformCacheMatch(&caches[i], pos, rot, s)) {
+			memcpy(InstanceTransform(r, slots[i]), caches[i].transform, sizeof(caches[i].transform));
+			reused++;
+			continue;
+		}
+		RenderPrepAdd(prep, pos, rot, s, slots[i], &caches[i]);
+	}
+	RenderPrepBuild(prep, r);
+	return reused;
+}
+
+static int compareSlots(PhysicsContext* ctx, InstanceRenderer* r)
+{
+	int bad = 0;
+	for (int i = 0; i < ctx->entities.table.count; i++) {
+		float16 ref = MatrixToFloatV(reference[i]);
+		float* m = InstanceTransform(r, slots[i]);
+		for (int k = 0; k < 16; k++) {
+			if (fabsf(ref.v[k] - m[k]) > 1e-4f) {
+				bad++;
+				break;
+			}
+		}
+	}
+	return bad;
+}
+
+static int compare(RenderPrep* prep)
+{
+	int bad = 0;
+	for (int i = 0; i < prep->count; i++) {
+		float16 ref = MatrixToFloatV(reference[i]);
+		for (int k = 0; k < 16; k++) {
+			if (fabsf(ref.v[k] - prep->dest[i][k]) > 1e-4f) {
+				bad++;
+				break;
+			}
+		}
+	}
+	return bad;
+}
+
+int main(void)
+{
+	GraphicsContext* gfx = CreateRecordingGraphics(1280, 720);
+	PhysicsContext* ctx = CreatePhysics();
+	for (int i = 0; i < ENTITIES; i++) {
+		EntityDesc* d = &descs[i];
+		d->pos = (Vector3){ (i % 100) * 1.5f, 1 + (i / 1000) * 1.5f, ((i / 100) % 10) * 1.5f };
+		d->rot = (Vector3){ rndf(0, 6), rndf(0, 6), rndf(0, 6) };
+		d->mass = 10;
+		switch (i % 4) {
+			case 0: d->shape = SHAPE_BOX; d->size = (Vector3){ .5, .6, .7 }; break;
+			case 1: d->shape = SHAPE_SPHERE; d->size = (Vector3){ .3, 0, 0 }; break;
+			case 2: d->shape = SHAPE_CYLINDER; d->size = (Vector3){ .25, .8, 0 }; break;
+			default: d->shape = SHAPE_CAPSULE; d->size = (Vector3){ .2, .6, 0 }; break;
+		}
+	}
+	SpawnEntities(ctx, gfx, descs, ENTITIES, NULL);
+
+	InstanceRenderer r = { 0 };
+	RenderPrep prep = { 0 };
+	Mesh mesh = { 0 };
+	struct timespec t;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	for (int i = 0; i < RUNS; i++) buildScalar(ctx);
+	double scalar = msSince(&t) / RUNS;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	for (int i = 0; i < RUNS; i++) gather(ctx, &r, &prep, &mesh);
+	double gathered = msSince(&t) / RUNS;
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	for (int i = 0; i < RUNS; i++) RenderPrepBuild(&prep, &r);
+	double bulk = msSince(&t) / RUNS;
+	int bad = compare(&prep);
+
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	for (int i = 0; i < RUNS; i++) RenderPrepBuildRange(&prep, 0, prep.count);
+	double single = msSince(&t) / RUNS;
+	bad += compare(&prep);
+
+	printf("%i transforms  per geom %8.3fms  gather %8.3fms  bulk %8.3fms (%i threads)  bulk one thread %8.3fms\n",
+		prep.count, scalar, gathered, bulk, prep.threads, single);
+
+	// settled, the first pass fills the caches and the rest reuse them
+	for (int i = 0; i < ctx->entities.table.count; i++) dBodyDisable(ctx->entities.bodies[i]);
+	gatherCached(ctx, &r, &prep, &mesh);
+	bad += compareSlots(ctx, &r);
+	int reused = 0;
+	clock_gettime(CLOCK_MONOTONIC, &t);
+	for (int i = 0; i < RUNS; i++) reused = gatherCached(ctx, &r, &prep, &mesh);
+	double settled = msSince(&t) / RUNS;
+	bad += compareSlots(ctx, &r);
+	if (reused != ctx->entities.table.count) bad++;
+
+	printf("settled  gather and build %8.3fms  %i of %i transforms reused\n", settled, reused, ctx->entities.table.count);
+	if (bad) printf("FAIL %i transforms differ from the per geom path\n", bad);
+
+	FreeRenderPrep(&prep);
+	FreeInstancing(&r);
+	FreePhysics(ctx);
+	FreeGraphics(gfx);
+	return bad ? 1 : 0;
+}
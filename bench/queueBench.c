@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file queueBench.c
+ * @brief checks and times sorting the render queue without a window
+ *
+ * Keys shaped like a frame's draw items, a few shaders, some textures
+ * and meshes and spread out depths, are radix sorted and compared with
+ * qsort, including that equal keys keep the order they were pushed in.
+ * Exits with an error on any mismatch, build and run it with make bench
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#include "raylib.h"
+#include "renderQueue.h"
+
+#define ITEMS 100000
+#define RUNS 20
+
+typedef struct Entry {
+	uint64_t key;
+	int item;
+} Entry;
+
+static Entry entries[ITEMS];
+static uint64_t keys[ITEMS];
+
+// by key then by push order, what a stable sort gives
+static int compareEntries(const void* a, const void* b)
+{
+	const Entry* x = a;
+	const Entry* y = b;
+	if (x->key != y->key) return x->key < y->key ? -1 : 1;
+	return x->item - y->item;
+}
+
+static void fill(RenderQueue* q)
+{
+	RenderQueueClear(q);
+	for (int i = 0; i < ITEMS; i++) RenderQueuePush(q, keys[i], i);
+}
+
+int main(void)
+{
+	srand(1);
+	for (int i = 0; i < ITEMS; i++) {
+		float depth = (float)(rand() % 100000) * 0.01f;
+		keys[i] = RenderKey(RENDER_PASS_OPAQUE, 3 + rand() % 2, 1 + rand() % 12, 1 + rand() % 40, depth * depth);
+		entries[i] = (Entry){ keys[i], i };
+	}
+
+	// the depth field is coarse, so some keys are equal and order matters
+	if (RenderKey(0, 1, 1, 1, 4) >= RenderKey(0, 1, 1, 1, 9)) {
+		printf("FAIL nearer depth doesn't sort first\n");
+		return 1;
+	}
+	if (RenderKey(0, 1, 1, 2, 0) <= RenderKey(0, 1, 1, 1, 1e30f)) {
+		printf("FAIL depth spills into the mesh field\n");
+		return 1;
+	}
+
+	RenderQueue q = { 0 };
+	clock_t t = clock();
+	for (int i = 0; i < RUNS; i++) {
+		fill(&q);
+		RenderQueueSort(&q);
+	}
+	double radix = (double)(clock() - t) * 1000.0 / CLOCKS_PER_SEC / RUNS;
+
+	t = clock();
+	static Entry sorted[ITEMS];
+	for (int i = 0; i < RUNS; i++) {
+		for (int k = 0; k < ITEMS; k++) sorted[k] = entries[k];
+		qsort(sorted, ITEMS, sizeof(Entry), compareEntries);
+	}
+	double quick = (double)(clock() - t) * 1000.0 / CLOCKS_PER_SEC / RUNS;
+
+	int bad = 0;
+	for (int i = 0; i < ITEMS; i++) {
+		if (q.keys[i] != sorted[i].key || q.items[i] != sorted[i].item) bad++;
+	}
+
+	// already sorted keys still come out the same
+	fill(&q);
+	for (int i = 0; i < ITEMS; i++) q.keys[i] = sorted[i].key, q.items[i] = sorted[i].item;
+	RenderQueueSort(&q);
+	for (int i = 0; i < ITEMS; i++) {
+		if (q.keys[i] != sorted[i].key || q.items[i] != sorted[i].item) bad++;
+	}
+
+	printf("%i keys  radix %8.3fms (%i passes)  qsort %8.3fms\n", ITEMS, radix, q.sortPasses, quick);
+	if (bad) printf("FAIL %i keys out of order\n", bad);
+
+	FreeRenderQueue(&q);
+	return bad ? 1 : 0;
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file spawnBench.c
+ * @brief times building a 10k entity scene
+ *
+ * Builds the same scene with individual Create calls and with
+ * SpawnEntities, then tears it down, each in a fresh context. No window
+ * is opened, the graphics context is only used for texture pointers.
+ * Build and run it with make bench
+ */
+
+#include <stdio.h>
+#include <time.h>
+#include "raylibODE.h"
+
+#define ENTITIES 10000
+
+static EntityDesc descs[ENTITIES];
+
+static double msSince(clock_t start)
+{
+	return (double)(clock() - start) * 1000.0 / CLOCKS_PER_SEC;
+}
+
+// a grid of a few repeated shapes, much like a real scene
+static void makeScene(void)
+{
+	for (int i = 0; i < ENTITIES; i++) {
+		EntityDesc* d = &descs[i];
+		d->pos = (Vector3){ (i % 100) * 1.5f, 1 + (i / 1000) * 1.5f, ((i / 100) % 10) * 1.5f };
+		d->rot = (Vector3){ 0, 0, 0 };
+		d->mass = 10;
+		d->texture = NULL;
+		switch (i % 4) {
+			case 0: d->shape = SHAPE_BOX; d->size = (Vector3){ .5, .5, .5 }; break;
+			case 1: d->shape = SHAPE_SPHERE; d->size = (Vector3){ .3, 0, 0 }; break;
+			case 2: d->shape = SHAPE_CYLINDER; d->size = (Vector3){ .25, .8, 0 }; break;
+			default: d->shape = SHAPE_CAPSULE; d->size = (Vector3){ .2, .6, 0 }; break;
+		}
+	}
+}
+
+static void createOneByOne(PhysicsContext* ctx, GraphicsContext* gfx)
+{
+	for (int i = 0; i < ENTITIES; i++) {
+		EntityDesc* d = &descs[i];
+		switch (d->shape) {
+			case SHAPE_BOX: CreateBox(ctx, gfx, d->size, d->pos, d->rot, d->mass); break;
+			case SHAPE_SPHERE: CreateSphere(ctx, gfx, d->size.x, d->pos, d->rot, d->mass); break;
+			case SHAPE_CYLINDER: CreateCylinder(ctx, gfx, d->size.x, d->size.y, d->pos, d->rot, d->mass); break;
+			default: CreateCapsule(ctx, gfx, d->size.x, d->size.y, d->pos, d->rot, d->mass); break;
+		}
+	}
+}
+
+int main(void)
+{
+	GraphicsContext* gfx = CreateRecordingGraphics(1280, 720);
+	makeScene();
+
+	PhysicsContext* ctx = CreatePhysics();
+	clock_t t = clock();
+	createOneByOne(ctx, gfx);
+	double create = msSince(t);
+	t = clock();
+	FreePhysics(ctx);
+	double teardown = msSince(t);
+	printf("%i entities one by one    %8.3fms  teardown %8.3fms\n", ENTITIES, create, teardown);
+
+	ctx = CreatePhysics();
+	t = clock();
+	SpawnEntities(ctx, gfx, descs, ENTITIES, NULL);
+	create = msSince(t);
+	t = clock();
+	FreePhysics(ctx);
+	teardown = msSince(t);
+	printf("%i entities SpawnEntities %8.3fms  teardown %8.3fms\n", ENTITIES, create, teardown);
+
+	FreeGraphics(gfx);
+	return 0;
+}
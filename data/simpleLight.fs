@@ -5,6 +5,7 @@ in vec2 fragTexCoord;
 in vec4 fragColor;
 in vec3 fragPosition;
 in vec3 fragNormal;
+flat in vec4 fragAtlasRect;     // uv offset and size in an atlas page, zero size if not in one
 
 // Input uniform values
 uniform sampler2D texture0;
@@ -41,7 +42,16 @@ uniform vec3 viewPos;
 void main()
 {
     // Texel color fetching from texture sampler
-    vec4 texelColor = texture(texture0, fragTexCoord);
+    vec4 texelColor;
+    if (fragAtlasRect.z > 0.0) {
+        // wrap inside the region, the gradients are of the unwrapped
+        // coordinates so the seam doesn't jump to the smallest mip
+        vec2 dx = dFdx(fragTexCoord) * fragAtlasRect.zw;
+        vec2 dy = dFdy(fragTexCoord) * fragAtlasRect.zw;
+        texelColor = textureGrad(texture0, fragAtlasRect.xy + fract(fragTexCoord) * fragAtlasRect.zw, dx, dy);
+    } else {
+        texelColor = texture(texture0, fragTexCoord);
+    }
     vec3 lightDot = vec3(0.0);
     vec3 normal = normalize(fragNormal);
     vec3 viewD = normalize(viewPos - fragPosition);
@@ -71,7 +81,7 @@ void main()
         }
     }
 
-    finalColor =  (texelColor * ((colDiffuse+vec4(specular,1)) * vec4(lightDot, 1.0)));
+    finalColor =  (texelColor * ((colDiffuse*fragColor+vec4(specular,1)) * vec4(lightDot, 1.0)));
     finalColor += texelColor * (ambient/10.0);
     // gamma
     finalColor = pow(finalColor, vec4(1.0/2.2));
@@ -16,6 +16,7 @@ out vec2 fragTexCoord;
 out vec4 fragColor;
 out vec3 fragPosition;
 out vec3 fragNormal;
+flat out vec4 fragAtlasRect;    // nothing drawn with this shader is in an atlas
 
 // NOTE: Add here your custom variables
 
@@ -23,7 +24,8 @@ void main()
 {
     // Send vertex attributes to fragment shader
     fragTexCoord = vertexTexCoord * texCoordScale;
-    fragColor = vertexColor;
+    fragColor = vertexColor;  // white unless baked static batches put their tint here
+    fragAtlasRect = vec4(0.0);
     fragPosition = vec3(matModel*vec4(vertexPosition, 1.0f));
     mat3 normalMatrix = transpose(inverse(mat3(matModel)));
     fragNormal = normalize(normalMatrix*vertexNormal);
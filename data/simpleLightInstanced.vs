@@ -0,0 +1,39 @@
+#version 330
+
+// Input vertex attributes
+in vec3 vertexPosition;
+in vec2 vertexTexCoord;
+in vec3 vertexNormal;
+
+// Per instance attributes, the locations are fixed above raylib's own
+// so they can't land on an attribute the shared meshes use
+layout(location = 10) in mat4 instanceTransform;
+layout(location = 14) in vec4 instanceTint;
+layout(location = 15) in vec4 instanceUv;     // uv scale then atlas region
+
+// Input uniform values
+uniform mat4 mvp;   // view projection only, the model matrix is per instance
+uniform vec4 atlasRegions[64];  // ATLAS_MAX_REGIONS uv offset and size, the first is zero
+
+// Output vertex attributes (to fragment shader)
+out vec2 fragTexCoord;
+out vec4 fragColor;
+out vec3 fragPosition;
+out vec3 fragNormal;
+flat out vec4 fragAtlasRect;
+
+void main()
+{
+    vec4 worldPosition = instanceTransform*vec4(vertexPosition, 1.0);
+
+    // Send vertex attributes to fragment shader
+    fragTexCoord = vertexTexCoord * instanceUv.xy;
+    fragAtlasRect = atlasRegions[int(instanceUv.z + 0.5)];
+    fragColor = instanceTint;
+    fragPosition = vec3(worldPosition);
+    mat3 normalMatrix = transpose(inverse(mat3(instanceTransform)));
+    fragNormal = normalize(normalMatrix*vertexNormal);
+
+    // Calculate final vertex position
+    gl_Position = mvp*worldPosition;
+}
@@ -81,7 +81,7 @@ int main(void)
     // Create ground "plane"
     gData.planeGeom = dCreateBox(physCtx->space, PLANE_SIZE, PLANE_THICKNESS, PLANE_SIZE);
     dGeomSetPosition(gData.planeGeom, 0, -PLANE_THICKNESS / 2.0, 0);
-    dGeomSetData(gData.planeGeom, CreateGeomInfo(true, &graphics->groundTexture, 25.0f, 25.0f));
+    dGeomSetData(gData.planeGeom, CreateGeomInfo(physCtx, true, UseTexture(graphics->assets, graphics->groundTexture), 25.0f, 25.0f));
 
 	clistAddNode(physCtx->statics, gData.planeGeom);
 	
@@ -216,12 +216,10 @@ int main(void)
 		}
 		        
         bool spcdn = IsKeyDown(KEY_SPACE);  // cache space key status (don't look up for each object iterration    
-        cnode_t* node = physCtx->objList->head;
-
-        while (node != NULL) {
-			entity* ent = node->data;
+        // loop backwards, freeing an entity moves the last one into its place
+        for (int i = GetEntityCount(physCtx) - 1; i >= 0; i--) {
+			entity* ent = GetEntityAt(physCtx, i);
             dBodyID bdy = ent->body;
-            cnode_t* next = node->next; // get the next node now in case we delete this one
             
             // reset entities for setting by collision
             SetEntityHew(ent, WHITE);
@@ -242,11 +240,10 @@ int main(void)
 
             
             if(pos[1]<-10) {
-                FreeEntity(physCtx, ent); // warning deletes global entity list entry, get your next node before doing this!
+                FreeEntity(physCtx, ent); // moves the last entity into this slot, hence the backwards loop
                 CreateRandomEntity(physCtx, graphics, (Vector3){rndf(-3, 3), rndf(6, 12), rndf(-3, 3)}, SHAPE_ALL);
             }
             
-            node = next;
         }
 
 		// Step the physics
@@ -47,7 +47,7 @@ int main(void)
 	Model ground = LoadModel("data/ground2.obj");
 	
 	// framework looks after the physics stuff and rendering
-	CreateStaticTrimesh(physCtx, graphics, ground, &graphics->groundTexture, 2.5f);
+	CreateStaticTrimesh(physCtx, graphics, ground, UseTexture(graphics->assets, graphics->groundTexture), 2.5f);
 
 
 	// vehicle* CreateVehicle(PhysicsContext* pctx, struct GraphicsContext* ctx, Vector3 pos, Vector3 carScale, float wheelRadius, float wheelWidth);
@@ -77,12 +77,10 @@ int main(void)
 		UpdateVehicleCamera(graphics, car);
         
         bool spcdn = IsKeyDown(KEY_SPACE);  // cache space key status (don't look up for each object iterration    
-        cnode_t* node = physCtx->objList->head;
-
-        while (node != NULL) {
-			entity* ent = node->data;
+        // loop backwards, freeing an entity moves the last one into its place
+        for (int i = GetEntityCount(physCtx) - 1; i >= 0; i--) {
+			entity* ent = GetEntityAt(physCtx, i);
             dBodyID bdy = ent->body;
-            cnode_t* next = node->next; // get the next node now in case we delete this one
             const dReal* pos = dBodyGetPosition(bdy);
             if (spcdn) {
                 // apply force if the space key is held
@@ -102,11 +100,10 @@ int main(void)
                 // would be more efficient to just reuse the object and
                 // reposition it with zeroed velocities
                 // but this is used to aid testing
-				FreeEntity(physCtx, ent); // warning deletes global entity list entry, get your next node before doing this!
+				FreeEntity(physCtx, ent); // moves the last entity into this slot, hence the backwards loop
                 CreateRandomEntity(physCtx, graphics, (Vector3){rndf(-3, 3), rndf(6, 12), rndf(-3, 3)}, SHAPE_ALL);
             }
             
-            node = next;
         }
 		
 		float accel = 0;
@@ -73,18 +73,16 @@ int main(void)
 	
 
 	// framework looks after the physics stuff and rendering
-	CreateStaticTrimesh(physCtx, graphics, ground, &graphics->groundTexture, 2.5f);
+	CreateStaticTrimesh(physCtx, graphics, ground, UseTexture(graphics->assets, graphics->groundTexture), 2.5f);
 
     // Create ground plane
     dGeomID planeGeom = dCreateBox(physCtx->space, 1000, PLANE_THICKNESS, 1000);
     dGeomSetPosition(planeGeom, 0, -PLANE_THICKNESS / 2.0, 0);
-    geomInfo* groundInfo = CreateGeomInfo(true, &graphics->groundTexture, 50.0f, 50.0f);
+    geomInfo* groundInfo = CreateGeomInfo(physCtx, true, UseTexture(graphics->assets, graphics->groundTexture), 50.0f, 50.0f);
     dGeomSetData(planeGeom, groundInfo);
     clistAddNode(physCtx->statics, planeGeom);
     groundInfo->surface = &gSurfaces[SURFACE_EARTH];
 
-	Model carBody = LoadModel("data/car-body.obj");
-
 	// make a figure of 8 path
 	#define MAXPATH 32
 	Vector3 path[MAXPATH];
@@ -99,6 +97,7 @@ int main(void)
 	a=0;
 	vehicle* cars[MAXCAR];
 	int carTarget[MAXCAR];
+	Model* carBody = LoadSharedModel("data/car-body.obj"); // one model for every car
 
 
 	// position cars around path
@@ -147,7 +146,7 @@ int main(void)
 		UnflipVehicle(cars[j]); // hack to get everything else in the car to align!
 
 		geomInfo* gi = dGeomGetData(cars[j]->geoms[0]);
-		gi->visual = carBody;
+		gi->visual = *carBody;
 		gi->surface = &gSurfaces[SURFACE_RUBBER]; // make the body bouncy!
 		
 		// use the front marker as the top part of the body
@@ -252,6 +251,7 @@ int main(void)
         DrawText(TextFormat("Phys steps per frame %i",pSteps), 10, 120, 20, WHITE);
         DrawText(TextFormat("Phys time per frame %f",physTime), 10, 140, 20, WHITE);
         DrawText(TextFormat("total time per frame %f",GetFrameTime()), 10, 160, 20, WHITE);
+        DrawRenderStats(graphics, 10, 180);
 
         EndDrawing();
 
@@ -261,11 +261,12 @@ int main(void)
     // De-Initialization
     //--------------------------------------------------------------------------------------
        
+    PrintAssetCache();
     for (int i=0; i<MAXCAR; i++) {
 		FreeVehicle(physCtx, cars[i]);
 	}
+    UnloadSharedModel(carBody);
     UnloadModel(ground);
-    UnloadModel(carBody);
 
     FreePhysics(physCtx);
     FreeGraphics(graphics);
@@ -46,6 +46,9 @@ int main(void)
     // Initialization
     //--------------------------------------------------------------------------------------
 
+    // count ODE's allocations so PrintOdeMemStats has something to show
+    TrackOdeAllocations(true);
+
     // Physics context, holds all physics state
     PhysicsContext* physCtx = CreatePhysics();    
     GraphicsContext* graphics = CreateGraphics(screenWidth, screenHeight, "Raylib and OpenDE");
@@ -61,7 +64,7 @@ int main(void)
     dMatrix3 R_plane;
     dRFromAxisAndAngle(R_plane, 1, 0, -1, M_PI * 0.125);
     dGeomSetRotation(planeGeom, R_plane);
-    dGeomSetData(planeGeom, CreateGeomInfo(true, &graphics->groundTexture, 25.0f, 25.0f));
+    dGeomSetData(planeGeom, CreateGeomInfo(physCtx, true, UseTexture(graphics->assets, graphics->groundTexture), 25.0f, 25.0f));
 
 	clistAddNode(physCtx->statics, planeGeom);
 	
@@ -113,15 +116,12 @@ int main(void)
 		UpdateCameraControl(graphics);
         
         bool spcdn = IsKeyDown(KEY_SPACE);  // cache space key status (don't look up for each object iterration    
-        cnode_t* node = physCtx->objList->head;
-
-        while (node != NULL) {
-			entity* ent = node->data;
+        for (int i = 0; i < GetEntityCount(physCtx); i++) {
+			entity* ent = GetEntityAt(physCtx, i);
             dBodyID bdy = ent->body;
             
 			SetEntityHew(ent, WHITE);
             
-            cnode_t* next = node->next; // get the next node now in case we delete this one
             const dReal* pos = dBodyGetPosition(bdy);
             if (spcdn) {
                 // apply force if the space key is held
@@ -138,14 +138,11 @@ int main(void)
 
             
             if(pos[1]<-10) {
-                // would be more efficient to just reuse the object and
-                // reposition it with zeroed velocities
-                // but this is used to aid testing
-				FreeEntity(physCtx, ent); // warning deletes global entity list entry, get your next node before doing this!
-                CreateRandomEntity(physCtx, graphics, (Vector3){rndf(5, 11), rndf(6, 12), rndf(-3, 3)}, SHAPE_ALL);
+                // reuse the object, repositioning it with zeroed velocities
+                RecycleEntity(physCtx, ent, (Vector3){rndf(5, 11), rndf(6, 12), rndf(-3, 3)},
+                              (Vector3){rndf(0, 6.28), rndf(0, 6.28), rndf(0, 6.28)});
             }
             
-            node = next;
         }
 
 		// Step the physics
@@ -177,6 +174,7 @@ int main(void)
         DrawText(TextFormat("Phys steps per frame %i",pSteps), 10, 120, 20, WHITE);
         DrawText(TextFormat("Phys time per frame %f",physTime), 10, 140, 20, WHITE);
         DrawText(TextFormat("total time per frame %f",GetFrameTime()), 10, 160, 20, WHITE);
+        DrawPhysicsMemoryStats(physCtx, 10, 200);
 
         EndDrawing();
 
@@ -185,6 +183,7 @@ int main(void)
     
     // De-Initialization
     //--------------------------------------------------------------------------------------
+    PrintOdeMemStats();
     FreePhysics(physCtx);
     FreeGraphics(graphics);
 
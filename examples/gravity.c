@@ -130,17 +130,12 @@ int main(void)
                 DrawSphereWires(gravPoint, gravSize, 9, 9, BLUE);
                 DrawSphere(gravPoint, planetSize, GREEN);
                 
-				cnode_t* node = physCtx->objList->head;
-
-				while (node != NULL) 
-				{
-					entity* e = node->data;
-					cnode_t* next = node->next;
+				for (int n = 0; n < GetEntityCount(physCtx); n++) {
+					entity* e = GetEntityAt(physCtx, n);
 					Vector3* v = e->data;
 					for (int i = 1; i < trailSize; i++) {
 						DrawLine3D(v[i-1], v[i], YELLOW);
 					}
-					node = next;
 				}
                 
                 DrawGrid(100,10); // for context (no ground!)
@@ -151,12 +146,9 @@ int main(void)
         EndDrawing();
     }
 
-	cnode_t* node = physCtx->objList->head;
-	while (node != NULL) 
-	{
-		entity* ent = node->data;
+	for (int i = 0; i < GetEntityCount(physCtx); i++) {
+		entity* ent = GetEntityAt(physCtx, i);
 		free(ent->data);
-		node = node->next;
 	}	
     FreePhysics(physCtx);
     FreeGraphics(graphics);
@@ -168,13 +160,10 @@ void updateGravity(PhysicsContext* physCtx, GraphicsContext* graphics )
 {
 	StepPhysics(physCtx);
 
-	cnode_t* node = physCtx->objList->head;
-
-	while (node != NULL) 
-	{
-		entity* ent = node->data;
+	// loop backwards, freeing an entity moves the last one into its place
+	for (int i = GetEntityCount(physCtx) - 1; i >= 0; i--) {
+		entity* ent = GetEntityAt(physCtx, i);
 		dBodyID bdy = ent->body;
-		cnode_t* next = node->next; // get the next node now in case we delete this one
 		const dReal* pos = dBodyGetPosition(bdy);
 		
 		Vector3* pv = (Vector3*)pos;	// not sure if I like this!
@@ -198,9 +187,8 @@ void updateGravity(PhysicsContext* physCtx, GraphicsContext* graphics )
 				
 				// as an alternatice you can use this with a smaller radius
 				free(ent->data);
-				FreeEntity(physCtx, ent); // warning deletes global entity list entry, get your next node before doing this!
+				FreeEntity(physCtx, ent); // moves the last entity into this slot, hence the backwards loop
 				CreateOrbiter(physCtx, graphics);
-				node = next;
 				continue;
 			}
 			dBodyAddForce(bdy, f.x, f.y, f.z);
@@ -210,9 +198,8 @@ void updateGravity(PhysicsContext* physCtx, GraphicsContext* graphics )
 					
 		if(pos[1]<-10) {
 			free(ent->data);
-			FreeEntity(physCtx, ent); // warning deletes global entity list entry, get your next node before doing this!
+			FreeEntity(physCtx, ent); // moves the last entity into this slot, hence the backwards loop
 			CreateOrbiter(physCtx, graphics);
-			node = next;
 			continue;
 		}
 		
@@ -223,7 +210,6 @@ void updateGravity(PhysicsContext* physCtx, GraphicsContext* graphics )
 			}
 			v[trailSize-1] = (Vector3){pos[0], pos[1], pos[2]};
 		}
-		node = next;
 	}
 
 }
@@ -25,19 +25,21 @@
 #include <math.h>
  
 #include "raylibODE.h"
+#include "prefab.h"
 
 
 // instances slops, level sections and corners from an array of coordinates
 void LoadLevel(PhysicsContext* physCtx, GraphicsContext* graphics);
 
-// creates an array of multipistons, and other support geoms to
-// provide a marble lift
-MultiPiston** CreateLift(PhysicsContext* physCtx,
+// builds a marble lift from multipistons and support geoms, once,
+// and captures it as a prefab the level's lifts are stamped out from
+Prefab* CreateLiftPrefab(PhysicsContext* physCtx,
                          GraphicsContext* graphics,
-                         Vector3 position,
-                         float yaw,
                          float strength);
 
+// drive a lift's pistons, every other piston is 180 degrees out of phase
+void SetLiftVelocity(PrefabInstance* lift, int frameCount);
+
 #define screenWidth 1920/1.2
 #define screenHeight 1080/1.2
 
@@ -144,24 +146,22 @@ int main(void)
 	
 
 	
-	MultiPiston** lift1 = CreateLift(physCtx,
-							graphics,
-							(Vector3){0.f, 0.4f, 0.0f},
-							0,
-							1000.0f);
+	Prefab* liftPrefab = CreateLiftPrefab(physCtx, graphics, 1000.0f);
+	const Vector3 upAxis = (Vector3){0.f, 1.f, 0.f};
 
-	
-	MultiPiston** lift2 = CreateLift(physCtx,
-                                graphics,
-                                (Vector3){6.f, 4.f, 8.f},
-                                PI,
-                                1000.0f);
-
-	MultiPiston** lift3 = CreateLift(physCtx,
-                                graphics,
-                                (Vector3){-10.f, 11.f, -18.f},
-                                0,
-                                1000.0f);
+	PrefabInstance* lifts[3];
+	lifts[0] = InstantiatePrefab(physCtx, graphics, liftPrefab,
+							(Vector3){0.f, 0.4f, 0.0f},
+							QuaternionFromAxisAngle(upAxis, 0));
+	lifts[1] = InstantiatePrefab(physCtx, graphics, liftPrefab,
+							(Vector3){6.f, 4.f, 8.f},
+							QuaternionFromAxisAngle(upAxis, PI));
+	lifts[2] = InstantiatePrefab(physCtx, graphics, liftPrefab,
+							(Vector3){-10.f, 11.f, -18.f},
+							QuaternionFromAxisAngle(upAxis, 0));
+
+	// the track and lift ends never move, draw them as a few merged meshes
+	BakeStaticRenderBatches(physCtx, graphics);
                                                                 	
 	int frameCount = 0;
 	int released = 0;
@@ -170,13 +170,8 @@ int main(void)
 	
     while (!WindowShouldClose())
     {
-		for(int i=0; i < MAX_PISTON; i++) {
-			float offset = 0.f;
-			// every other piston is 180 degrees out of phase
-			if (i % 2 == 0) offset = M_PI;
-			SetMultiPistonVelocity(lift1[i], sin(((float)frameCount)/60.0f+offset));
-			SetMultiPistonVelocity(lift2[i], sin(((float)frameCount)/60.0f+offset));
-			SetMultiPistonVelocity(lift3[i], sin(((float)frameCount)/60.0f+offset));
+		for (int i = 0; i < 3; i++) {
+			SetLiftVelocity(lifts[i], frameCount);
 		}
 		
 		
@@ -194,16 +189,14 @@ int main(void)
 		UpdateCameraControl(graphics);
         StepPhysics(physCtx);
         
-		cnode_t* node = physCtx->objList->head;
-
-        while (node != NULL) {
-			entity* ent = node->data;
+		// loop backwards, freeing an entity moves the last one into its place
+        for (int i = GetEntityCount(physCtx) - 1; i >= 0; i--) {
+			entity* ent = GetEntityAt(physCtx, i);
             dBodyID bdy = ent->body;
-            cnode_t* next = node->next; // get the next node now in case we delete this one
             const dReal* pos = dBodyGetPosition(bdy);
 
             if(pos[1]<-10) {
-                FreeEntity(physCtx, ent); // warning deletes global entity list entry, get your next node before doing this!
+                FreeEntity(physCtx, ent); // moves the last entity into this slot, hence the backwards loop
                 //entity* e = CreateSphere(physCtx, graphics, 0.55, dropPoint, Vector3Zero(), 1);
 				//dBodySetAutoDisableFlag(e->body, 0);
 				//geomInfo* gi = dGeomGetData(dBodyGetFirstGeom(e->body));
@@ -211,7 +204,6 @@ int main(void)
 				released--;
             }
             
-            node = next;
         }
 
         // drawing
@@ -227,19 +219,11 @@ int main(void)
         EndDrawing();
     }
 
-    FreePhysics(physCtx);
-    FreeGraphics(graphics);
-    
-    // TODO make this easier !
-    for (int i = 0; i < MAX_PISTON; i++)
-    {
-		FreeMultiPiston(lift1[i]);
-		FreeMultiPiston(lift2[i]);
-		FreeMultiPiston(lift3[i]);
+    for (int i = 0; i < 3; i++) {
+		FreePrefabInstance(physCtx, lifts[i]);
 	}
-	free(lift1);
-	free(lift2);
-	free(lift3);
+    FreePhysics(physCtx); // frees the lift prefab too
+    FreeGraphics(graphics);
 	
     CloseWindow();
     return 0;
@@ -375,139 +359,105 @@ void LoadLevel(PhysicsContext* physCtx, GraphicsContext* graphics) {
 
 
 
-MultiPiston** CreateLift(PhysicsContext* physCtx,
+// each piston has 3 sections, 2 sliding joints and a pin holding its base
+#define LIFT_PISTON_JOINTS 3
+
+Prefab* CreateLiftPrefab(PhysicsContext* physCtx,
                          GraphicsContext* graphics,
-                         Vector3 position,
-                         float yaw,
                          float strength)
 {
-    Vector3 upAxis = (Vector3){0.f, 1.f, 0.f};
-
-    // Allocate multipiston array using raylib allocator
-    MultiPiston** mp = (MultiPiston**)MemAlloc(sizeof(MultiPiston*) * MAX_PISTON);
-
-    dMatrix3 R_yaw;
-    dRFromAxisAndAngle(R_yaw, 0, 1, 0, yaw);
+    dBodyID bodies[MAX_PISTON * 3];
+    dJointID joints[MAX_PISTON * LIFT_PISTON_JOINTS];
+    dGeomID statics[3];
 
     // Pistons 
+    dMatrix3 R_piston;
+    dRFromEulerAngles(R_piston,
+                      0,
+                      M_PI_2,
+                      (-M_PI/16.f) * 7.f);
+
     for (int i = 0; i < MAX_PISTON; i++)
     {
-        Vector3 localPos = (Vector3){10.f, -3.8f + i*1.4f, 7.6f + i*1.6f};
-
-        Vector3 worldPos = Vector3Add(
-            position,
-            Vector3RotateByAxisAngle(localPos, upAxis, yaw)
-        );
-
-        Vector3 axis = Vector3RotateByAxisAngle(
-            (Vector3){1.f,0.f,0.f},
-            upAxis,
-            yaw
-        );
-
-        mp[i] = CreateMultiPiston(physCtx, graphics,
-                                  worldPos,
-                                  axis,
+        Vector3 pos = (Vector3){10.f, -3.8f + i*1.4f, 7.6f + i*1.6f};
+
+        MultiPiston* mp = CreateMultiPiston(physCtx, graphics,
+                                  pos,
+                                  (Vector3){1.f, 0.f, 0.f},
                                   3,
                                   2.0f,
                                   1.2f,
                                   strength);
 
-        dMatrix3 R_local;
-        dMatrix3 R_final;
-
-        dRFromEulerAngles(R_local,
-                          0,
-                          M_PI_2,
-                          (-M_PI/16.f) * 7.f);
-
-        dMultiply0(R_final, R_yaw, R_local, 3, 3, 3);
-        dBodySetRotation(mp[i]->sections[0]->body, R_final);
-        PinEntityToWorld(physCtx, mp[i]->sections[0]);
+        // turn the whole piston about its base so the captured joints
+        // are already lined up
+        const dReal* base = dBodyGetPosition(mp->sections[0]->body);
+        dVector3 origin = { base[0], base[1], base[2] };
+        for (int j = 0; j < mp->count; j++) {
+            dBodyID bdy = mp->sections[j]->body;
+            const dReal* p = dBodyGetPosition(bdy);
+            dReal rel[3] = { p[0] - origin[0], p[1] - origin[1], p[2] - origin[2] };
+            dBodySetPosition(bdy,
+                origin[0] + R_piston[0]*rel[0] + R_piston[1]*rel[1] + R_piston[2]*rel[2],
+                origin[1] + R_piston[4]*rel[0] + R_piston[5]*rel[1] + R_piston[6]*rel[2],
+                origin[2] + R_piston[8]*rel[0] + R_piston[9]*rel[1] + R_piston[10]*rel[2]);
+            dBodySetRotation(bdy, R_piston);
+            bodies[i*3 + j] = bdy;
+        }
+        joints[i*LIFT_PISTON_JOINTS] = mp->joints[0];
+        joints[i*LIFT_PISTON_JOINTS + 1] = mp->joints[1];
+        joints[i*LIFT_PISTON_JOINTS + 2] = PinEntityToWorld(physCtx, mp->sections[0]);
+
+        // the joints and sections are in the arrays now, only the wrapper goes
+        free(mp->joints);
+        free(mp->sections);
+        free(mp);
     }
 
-    // -------------------------------------------------
-    // Lift End
-    // -------------------------------------------------
+    // lift end and the two rails
+    const Vector3 sizes[3] = { {2.f,.1f,4.f}, {.1f,.8f,13.f}, {.1f,.8f,13.f} };
+    const Vector3 places[3] = { {10.f, 5.f, 16.7f}, {9.2f, 2.f, 12.f}, {10.8f, 2.f, 12.f} };
+    const float tilts[3] = { 7.f, 3.5f, 3.5f };
+    for (int i = 0; i < 3; i++)
     {
-        Vector3 localPos = (Vector3){10.f, 5.f, 16.7f};
-
-        Vector3 worldPos = Vector3Add(
-            position,
-            Vector3RotateByAxisAngle(localPos, upAxis, yaw)
-        );
-
-        dGeomID liftEnd = CreateBoxGeom(
-            physCtx,
-            graphics,
-            (Vector3){2.f,.1f,4.f},
-            worldPos
-        );
-
+        statics[i] = CreateBoxGeom(physCtx, graphics, sizes[i], places[i]);
         dMatrix3 R_tilt;
-        dMatrix3 R_final;
-
-        dRFromAxisAndAngle(R_tilt, 1, 0, 0, -(M_PI/16.f) * 7.f);
-        dMultiply0(R_final, R_yaw, R_tilt, 3, 3, 3);
-        dGeomSetRotation(liftEnd, R_final);
-        clistAddNode(physCtx->statics, liftEnd);
+        dRFromAxisAndAngle(R_tilt, 1, 0, 0, -(M_PI/16.f) * tilts[i]);
+        dGeomSetRotation(statics[i], R_tilt);
     }
 
-    // -------------------------------------------------
-    // Rail 1
-    // -------------------------------------------------
-    {
-        Vector3 localPos = (Vector3){9.2f, 2.f, 12.f};
-        Vector3 worldPos = Vector3Add(
-            position,
-            Vector3RotateByAxisAngle(localPos, upAxis, yaw)
-        );
-
-        dGeomID liftRail1 = CreateBoxGeom(
-            physCtx,
-            graphics,
-            (Vector3){.1f,.8f,13.f},
-            worldPos
-        );
-
-        dMatrix3 R_tilt;
-        dMatrix3 R_final;
+    Prefab* pf = CapturePrefab(physCtx, graphics, "lift", Vector3Zero(),
+                               bodies, MAX_PISTON * 3,
+                               joints, MAX_PISTON * LIFT_PISTON_JOINTS,
+                               statics, 3);
 
-        dRFromAxisAndAngle(R_tilt, 1, 0, 0, -(M_PI/16.f) * 3.5f);
-        dMultiply0(R_final, R_yaw, R_tilt, 3, 3, 3);
-        dGeomSetRotation(liftRail1, R_final);
-        clistAddNode(physCtx->statics, liftRail1);
+    // the template has served its purpose
+    for (int i = 0; i < MAX_PISTON * LIFT_PISTON_JOINTS; i++) {
+        FreeJoint(physCtx, joints[i]);
+    }
+    for (int i = 0; i < MAX_PISTON * 3; i++) {
+        FreeEntity(physCtx, GetBodyEntity(physCtx, bodies[i]));
+    }
+    for (int i = 0; i < 3; i++) {
+        FreeGeomInfo(physCtx, dGeomGetData(statics[i]));
+        dGeomDestroy(statics[i]);
     }
 
-    // -------------------------------------------------
-    // Rail 2
-    // -------------------------------------------------
-    {
-        Vector3 localPos = (Vector3){10.8f, 2.f, 12.f};
-
-        Vector3 worldPos = Vector3Add(
-            position,
-            Vector3RotateByAxisAngle(localPos, upAxis, yaw)
-        );
-
-        dGeomID liftRail2 = CreateBoxGeom(
-            physCtx,
-            graphics,
-            (Vector3){.1f,.8f,13.f},
-            worldPos
-        );
-
-        dMatrix3 R_tilt;
-        dMatrix3 R_final;
-
-        dRFromAxisAndAngle(R_tilt, 1, 0, 0, -(M_PI/16.f) * 3.5f);
-
-        dMultiply0(R_final, R_yaw, R_tilt, 3, 3, 3);
-
-        dGeomSetRotation(liftRail2, R_final);
+    return AddPrefab(physCtx, pf);
+}
 
-        clistAddNode(physCtx->statics, liftRail2);
+void SetLiftVelocity(PrefabInstance* lift, int frameCount)
+{
+    for (int i = 0; i < MAX_PISTON; i++) {
+        float offset = 0.f;
+        if (i % 2 == 0) offset = M_PI;
+        float velocity = sin(((float)frameCount)/60.0f+offset);
+
+        // like SetMultiPistonVelocity, the sliding sections are woken too
+        for (int j = 0; j < 2; j++) {
+            dJointID slider = lift->joints[i*LIFT_PISTON_JOINTS + j];
+            dJointSetSliderParam(slider, dParamVel, velocity);
+            dBodyEnable(dJointGetBody(slider, 1));
+        }
     }
-
-    return mp;
 }
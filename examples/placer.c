@@ -39,7 +39,7 @@ int main(void)
     // Create ground plane
     dGeomID planeGeom = dCreateBox(physCtx->space, PLANE_SIZE, PLANE_THICKNESS, PLANE_SIZE);
     dGeomSetPosition(planeGeom, 0, -PLANE_THICKNESS / 2.0, 0);
-    dGeomSetData(planeGeom, CreateGeomInfo(true, &graphics->groundTexture, 25.0f, 25.0f));
+    dGeomSetData(planeGeom, CreateGeomInfo(physCtx, true, UseTexture(graphics->assets, graphics->groundTexture), 25.0f, 25.0f));
     clistAddNode(physCtx->statics, planeGeom);
 
     // Initial random objects
@@ -77,11 +77,10 @@ int main(void)
 		bool spcdn = IsKeyDown(KEY_SPACE);  // cache space key status (don't look up for each object iterration  
 
         // check world bounds and add force if needed
-        cnode_t* node = physCtx->objList->head;
-        while (node != NULL) {
-            entity* ent = node->data;
+        // loop backwards, freeing an entity moves the last one into its place
+        for (int i = GetEntityCount(physCtx) - 1; i >= 0; i--) {
+            entity* ent = GetEntityAt(physCtx, i);
             dBodyID bdy = ent->body;
-            cnode_t* next = node->next; // get the next node now in case we delete this one
             const dReal* pos = dBodyGetPosition(bdy);
             if (spcdn) {
                 // apply force if the space key is held
@@ -98,9 +97,8 @@ int main(void)
 
 
             if(pos[1] < -10) {
-                FreeEntity(physCtx, ent); // warning deletes global entity list entry, get your next node before doing this!
+                FreeEntity(physCtx, ent); // moves the last entity into this slot, hence the backwards loop
             }
-            node = next;
         }
 
         StepPhysics(physCtx);
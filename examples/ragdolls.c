@@ -23,6 +23,7 @@
  
 #include "raylibODE.h"
 #include "ragdoll.h"
+#include "prefab.h"
 
 #define screenWidth 1920/1.2
 #define screenHeight 1080/1.2
@@ -51,10 +52,15 @@ int main(void)
     //dRFromAxisAndAngle(R_plane, 1, 0, -1, M_PI * 0.125);
     dRFromAxisAndAngle(R_plane, 0, 0, 1, 0);
     dGeomSetRotation(planeGeom, R_plane);
-    dGeomSetData(planeGeom, CreateGeomInfo(true, &graphics->groundTexture, 25.0f, 25.0f));
+    dGeomSetData(planeGeom, CreateGeomInfo(physCtx, true, UseTexture(graphics->assets, graphics->groundTexture), 25.0f, 25.0f));
 
 	clistAddNode(physCtx->statics, planeGeom);
 
+	// the ragdoll is described in a file, without it CreateRagdoll
+	// falls back to its built in one
+	Prefab* ragdollPrefab = LoadPrefab("data/ragdoll.prefab");
+	if (ragdollPrefab) AddPrefab(physCtx, ragdollPrefab);
+
 	RagDoll* rd[NRAGDOLLS];
 	for (int i=0; i<NRAGDOLLS; i++) {
 		rd[i] = CreateRagdoll(physCtx, graphics, GetRagdollSpawnPosition());
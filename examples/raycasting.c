@@ -54,7 +54,7 @@ int main(void)
     dGeomSetPosition(planeGeom, 0, -PLANE_THICKNESS / 2.0, 0);
     SetGeomOrientationEuler(planeGeom, -M_PI/10.0f, 0, 0);
     
-    geomInfo* groundInfo = CreateGeomInfo(true, &dotTex, 25.0f, 25.0f);
+    geomInfo* groundInfo = CreateGeomInfo(physCtx, true, &dotTex, 25.0f, 25.0f);
     groundInfo->surface = &gSurfaces[SURFACE_ICE];
     dGeomSetData(planeGeom, groundInfo);
     
@@ -109,22 +109,17 @@ int main(void)
 		}
 		stepFrame = false;
         if (IsKeyPressed(KEY_T)) stepFrame = true;
-        cnode_t* node = physCtx->objList->head;
-
-
-		
-        while (node != NULL) {
-			entity* ent = node->data;
+        // loop backwards, freeing an entity moves the last one into its place
+        for (int i = GetEntityCount(physCtx) - 1; i >= 0; i--) {
+			entity* ent = GetEntityAt(physCtx, i);
             dBodyID bdy = ent->body;
                         
-            cnode_t* next = node->next; // get the next node now in case we delete this one
             const dReal* pos = dBodyGetPosition(bdy);
 
             if(pos[1]<-10) {
-				FreeEntity(physCtx, ent); // warning deletes global entity list entry, get your next node before doing this!
+				FreeEntity(physCtx, ent); // moves the last entity into this slot, hence the backwards loop
             }
             
-            node = next;
         }
 
         if (frameCount % 60 == 0 && frameCount!=lastFrameCount) {
@@ -259,9 +254,9 @@ int main(void)
     }
 
     UnloadTexture(dotTex);
-    free(redCast);
-    free(greenCast);
-    free(blueCast);
+    FreeRayCast(redCast);
+    FreeRayCast(greenCast);
+    FreeRayCast(blueCast);
     // De-Initialization
     //--------------------------------------------------------------------------------------
     FreePhysics(physCtx);
@@ -49,7 +49,7 @@ int main(void)
     // Create ground "plane"
     dGeomID planeGeom = dCreateBox(physCtx->space, PLANE_SIZE+2, PLANE_THICKNESS, PLANE_SIZE+2);
     dGeomSetPosition(planeGeom, 0, -PLANE_THICKNESS / 2.0, 0);
-    geomInfo* groundInfo = CreateGeomInfo(true, &graphics->groundTexture, 50.0f, 50.0f);
+    geomInfo* groundInfo = CreateGeomInfo(physCtx, true, UseTexture(graphics->assets, graphics->groundTexture), 50.0f, 50.0f);
     groundInfo->surface = &gSurfaces[SURFACE_EARTH];
     dGeomSetData(planeGeom, groundInfo);
     dGeomSetCategoryBits(planeGeom, WALL_GROUP);
@@ -120,12 +120,10 @@ int main(void)
 		}
         
         bool spcdn = IsKeyDown(KEY_SPACE);  // cache space key status (don't look up for each object iterration    
-        cnode_t* node = physCtx->objList->head;
-
-        while (node != NULL) {
-			entity* ent = node->data;
+        // loop backwards, freeing an entity moves the last one into its place
+        for (int i = GetEntityCount(physCtx) - 1; i >= 0; i--) {
+			entity* ent = GetEntityAt(physCtx, i);
             dBodyID bdy = ent->body;
-            cnode_t* next = node->next; // get the next node now in case we delete this one
             const dReal* pos = dBodyGetPosition(bdy);
             if (spcdn) {
                 // apply force if the space key is held
@@ -142,13 +140,12 @@ int main(void)
 
             
             if(pos[1]<-10) {
-                FreeEntity(physCtx, ent); // warning deletes global entity list entry, get your next node before doing this!
+                FreeEntity(physCtx, ent); // moves the last entity into this slot, hence the backwards loop
                 entity* e = CreateRandomEntity(physCtx, graphics, (Vector3){rndf(-3, 3), rndf(6, 12), rndf(-3, 3)}, SHAPE_ALL & ~SHAPE_DUMBBELL);
 				geomInfo* gi = dGeomGetData(dBodyGetFirstGeom(e->body));
 				gi->surface = &gSurfaces[SURFACE_RUBBER];
             }
             
-            node = next;
         }
 
 		// Step the physics
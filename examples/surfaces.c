@@ -51,7 +51,7 @@ int main(void)
     dMatrix3 R_plane;
     dRFromAxisAndAngle(R_plane, 1, 0, 0, M_PI * 0.125);
     dGeomSetRotation(planeGeom, R_plane);
-    geomInfo* groundInfo = CreateGeomInfo(true, &graphics->groundTexture, 25.0f, 25.0f);
+    geomInfo* groundInfo = CreateGeomInfo(physCtx, true, UseTexture(graphics->assets, graphics->groundTexture), 25.0f, 25.0f);
     groundInfo->surface = &gSurfaces[SURFACE_EARTH];
     dGeomSetData(planeGeom, groundInfo);
     
@@ -83,15 +83,13 @@ int main(void)
 		UpdateCameraControl(graphics);
         
         bool spcdn = IsKeyDown(KEY_SPACE);  // cache space key status (don't look up for each object iterration    
-        cnode_t* node = physCtx->objList->head;
-
-        while (node != NULL) {
-			entity* ent = node->data;
+        // loop backwards, freeing an entity moves the last one into its place
+        for (int i = GetEntityCount(physCtx) - 1; i >= 0; i--) {
+			entity* ent = GetEntityAt(physCtx, i);
             dBodyID bdy = ent->body;
             
 			SetEntityHew(ent, WHITE);
             
-            cnode_t* next = node->next; // get the next node now in case we delete this one
             const dReal* pos = dBodyGetPosition(bdy);
             if (spcdn) {
                 // apply force if the space key is held
@@ -111,11 +109,10 @@ int main(void)
                 // would be more efficient to just reuse the object and
                 // reposition it with zeroed velocities
                 // but this is used to aid testing
-				FreeEntity(physCtx, ent); // warning deletes global entity list entry, get your next node before doing this!
+				FreeEntity(physCtx, ent); // moves the last entity into this slot, hence the backwards loop
                 //CreateRandomEntity(physCtx, graphics, (Vector3){rndf(5, 11), rndf(6, 12), rndf(-3, 3)}, SHAPE_ALL);
             }
             
-            node = next;
         }
 
 		// Step the physics
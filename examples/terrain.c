@@ -45,7 +45,7 @@ int main(void)
 	Model ground = LoadModel("data/ground2.obj");
 	
 	// framework looks after the physics stuff and rendering
-	CreateStaticTrimesh(physCtx, graphics, ground, &graphics->groundTexture, 2.5f);
+	CreateStaticTrimesh(physCtx, graphics, ground, UseTexture(graphics->assets, graphics->groundTexture), 2.5f);
 
 
 	// Create random simple objects with random textures
@@ -71,12 +71,10 @@ int main(void)
 		UpdateCameraControl(graphics);
         
         bool spcdn = IsKeyDown(KEY_SPACE);  // cache space key status (don't look up for each object iterration    
-        cnode_t* node = physCtx->objList->head;
-
-        while (node != NULL) {
-			entity* ent = node->data;
+        // loop backwards, freeing an entity moves the last one into its place
+        for (int i = GetEntityCount(physCtx) - 1; i >= 0; i--) {
+			entity* ent = GetEntityAt(physCtx, i);
             dBodyID bdy = ent->body;
-            cnode_t* next = node->next; // get the next node now in case we delete this one
             const dReal* pos = dBodyGetPosition(bdy);
             if (spcdn) {
                 // apply force if the space key is held
@@ -93,14 +91,13 @@ int main(void)
 
             
             if(pos[1]<-10) {
-                // would be more efficient to just reuse the object and
-                // reposition it with zeroed velocities
-                // but this is used to aid testing
-                FreeEntity(physCtx, ent); // warning deletes global entity list entry, get your next node before doing this!
+                // retired bodies are reused by the next create of the same
+                // shape, so this respawns a random shape without destroying
+                // and recreating bodies and geoms (dumbbells are just freed)
+                RetireEntity(physCtx, ent); // moves the last entity into this slot, hence the backwards loop
                 CreateRandomEntity(physCtx, graphics, (Vector3){rndf(-3, 3), rndf(6, 12), rndf(-3, 3)}, SHAPE_ALL);
             }
             
-            node = next;
         }
 
 		// Step the physics
@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file arena.h
+ * @brief Chunked bump allocator released all at once
+ *
+ * Allocations are carved out of large chunks and can't be freed
+ * individually, instead the whole arena is released in one go. Each
+ * physics context has one that backs all the framework's own memory
+ * so tearing a context down doesn't have to visit every allocation.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+typedef struct ArenaChunk ArenaChunk;
+
+typedef struct Arena {
+	const char* name;		/**< used when reporting usage */
+	size_t chunkSize;		/**< size of each new chunk, bigger requests get their own */
+	ArenaChunk* chunks;		/**< newest chunk first, allocations come from this one */
+	size_t used;			/**< bytes handed out */
+	size_t reserved;		/**< bytes allocated from the heap */
+} Arena;
+
+void ArenaInit(Arena* arena, const char* name, size_t chunkSize);
+void* ArenaAlloc(Arena* arena, size_t size);
+void ArenaFree(Arena* arena);
+void ArenaPrintUsage(Arena* arena);
+
+#endif // ARENA_H
@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file assetLoader.h
+ * @brief Textures registered by name and loaded when first used
+ *
+ * Registering costs nothing, a texture is only loaded once something
+ * asks for it with UseTexture. The image is decoded on a worker thread
+ * and uploaded by UpdateAssetLoader on the main thread, until then the
+ * texture is raylib's 1x1 white one. The Texture pointer handed out
+ * never changes, so a geomInfo can hold it straight away and simply
+ * draws with the real texture once it has arrived.
+ *
+ * Given an atlas with SetAssetAtlas, each texture is also packed into it
+ * as it is uploaded, see textureAtlas.h.
+ */
+
+#ifndef ASSETLOADER_H
+#define ASSETLOADER_H
+
+#include <stdbool.h>
+#include "raylib.h"
+#include "textureAtlas.h"
+
+/**
+ * @brief a registered texture, 0 is none
+ *
+ * A struct so it can't be mixed up with a plain int.
+ */
+typedef struct TextureHandle {
+	int id;
+} TextureHandle;
+
+typedef struct AssetLoader AssetLoader;
+
+AssetLoader* CreateAssetLoader(bool upload);
+void FreeAssetLoader(AssetLoader* al);
+void SetAssetAtlas(AssetLoader* al, TextureAtlas* atlas);
+TextureHandle RegisterTexture(AssetLoader* al, const char* name, const char* path);
+TextureHandle RegisterGeneratedTexture(AssetLoader* al, const char* name, Image (*generate)(void));
+TextureHandle FindTexture(AssetLoader* al, const char* name);
+TextureHandle TextureHandleOf(AssetLoader* al, const Texture* texture);
+Texture* UseTexture(AssetLoader* al, TextureHandle h);
+bool TextureReady(AssetLoader* al, TextureHandle h);
+int UpdateAssetLoader(AssetLoader* al);
+void WaitForAssets(AssetLoader* al);
+
+#endif // ASSETLOADER_H
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file assets.h
+ * @brief Reference counted cache of models and cooked trimeshes
+ *
+ * The cache isn't tied to a physics or graphics context, loading the same
+ * path twice returns the same Model and only the last unload really
+ * releases it. Textures are the graphics context's asset loader's job,
+ * see assetLoader.h. Trimesh collision data is cooked once per mesh and
+ * shared by every geom made from it.
+ */
+
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include "raylib.h"
+#include <ode/ode.h>
+
+/**
+ * @brief collision data cooked from a mesh, shared by any number of geoms
+ *
+ * ODE doesn't copy the vertices, so the mesh must outlive the last geom
+ * using it.
+ */
+typedef struct SharedTrimesh {
+	const float* vertices;	/**< the mesh vertex data, this is the cache key */
+	int* indices;			/**< triangle indices built for ODE */
+	int indexCount;
+	dTriMeshDataID triData;	/**< the cooked data, give this to dCreateTriMesh */
+	int refs;
+} SharedTrimesh;
+
+Model* LoadSharedModel(const char* path);
+void UnloadSharedModel(Model* model);
+SharedTrimesh* AcquireTrimesh(Mesh mesh);
+void ReleaseTrimesh(SharedTrimesh* trimesh);
+void PrintAssetCache(void);
+
+#endif // ASSETS_H
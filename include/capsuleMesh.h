@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file capsuleMesh.h
+ * @brief Capsule meshes shared by every capsule geom of a similar shape
+ *
+ * A capsule is its radius scaled uniformly, so meshes are only needed
+ * per length to radius ratio. Ratios are rounded to CAPSULE_RATIO_STEP
+ * and each gets radius 1 meshes, one per level of detail, each built the
+ * first time it is drawn and kept until the graphics context goes.
+ */
+
+#ifndef CAPSULEMESH_H
+#define CAPSULEMESH_H
+
+#include "raylib.h"
+#include "meshLod.h"
+
+#define CAPSULE_MESHES 32			// distinct ratios kept, after that the nearest is used
+#define CAPSULE_RATIO_STEP 32.0f	// ratios are rounded to 1/CAPSULE_RATIO_STEP
+
+/**
+ * @brief unit radius capsule meshes, one for each length to radius ratio seen
+ */
+typedef struct CapsuleMeshes {
+	int count;
+	float ratio[CAPSULE_MESHES];	/**< rounded cylinder length of each mesh */
+	Mesh meshes[CAPSULE_MESHES][LOD_LEVELS];	/**< fixed so batches can hold the address */
+} CapsuleMeshes;
+
+Mesh GenMeshCapsule(float radius, float length, int slices, int rings);
+Mesh* GetCapsuleMesh(CapsuleMeshes* cm, float radius, float length, int lod);
+void FreeCapsuleMeshes(CapsuleMeshes* cm);
+
+#endif // CAPSULEMESH_H
@@ -1,6 +1,8 @@
 #ifndef __CLIST_H
 #define __CLIST_H
 
+#include "pool.h"
+
 /**
  * structure representing a node in a list
  */
@@ -12,6 +14,7 @@ struct __cnode
     struct __cnode* prev; /**< pointer to the previous node in the list */
     struct __cnode* next; /**< pointer to the next node in the list */
     void*           data; /**< pointer to the data this node is tracking */
+    struct __cnode* hashNext; /**< next node in the same index bucket */
     /*@}*/
 };
 
@@ -26,12 +29,19 @@ struct __clist
     /*@{*/
     cnode_t* head; /**< the first node in the list */
     cnode_t* tail; /**< the last node in the list */
+    Pool*    nodePool; /**< where nodes come from, ownPool unless shared */
+    Pool     ownPool;  /**< the list's private node slab */
+    int      count;    /**< number of nodes, kept up to date as nodes come and go */
+    unsigned version;  /**< changes every time a node is added or removed */
+    cnode_t** index;   /**< optional data pointer to node buckets, NULL if not indexed */
+    int      indexSize; /**< number of buckets, always a power of 2 */
     /*@}*/
 };
 
 
 
 clist_t*clistCreateList();
+clist_t*clistCreateListPooled(Pool* nodePool);
 cnode_t*clistAddNode(clist_t* list, void* data);
 cnode_t*clistInsertNode(clist_t* list, cnode_t* node, void* data);
 cnode_t*clistFindNode(clist_t* list, void* ptr);
@@ -39,11 +49,13 @@ void clistDeleteNode(clist_t* list, cnode_t** node);
 void clistDeleteNodeFromData(clist_t*, void*);
 void clistEmptyList(clist_t* list);
 void clistFreeList(clist_t** list);
+void clistAbandonList(clist_t** list);
 
 void clistIterateForward(clist_t * list, void(nodeFunction)(cnode_t* node));
 void clistIterateBackward(clist_t * list, void(nodeFunction)(cnode_t* node));
 void clistSort(clist_t * list, int(cmpFunction)(cnode_t* node1, cnode_t* node2));
 int clistTotal(clist_t* list);
 int clistIsEmpty(clist_t* list);
+void clistEnableIndex(clist_t* list);
 
 #endif
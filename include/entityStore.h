@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file entityStore.h
+ * @brief Dense entity storage addressed by generational handles
+ *
+ * Entities live in fixed size pages so an entity* stays valid for the
+ * whole life of the entity, while a dense swap-remove array of handles
+ * and body ids gives the per frame loops something linear to walk.
+ */
+
+#ifndef ENTITYSTORE_H
+#define ENTITYSTORE_H
+
+#include <stdint.h>
+#include <ode/ode.h>
+#include "arena.h"
+#include "handleTable.h"
+
+/**
+ * @brief a stable reference to an entity
+ *
+ * A HandleTable handle, the slot is also where the entity lives in the
+ * pages, so a handle to a freed entity will never resolve to whatever
+ * reuses its slot.
+ */
+typedef uint32_t EntityHandle;
+
+#define ENTITY_HANDLE_NONE	0
+#define ENTITY_PAGE_SIZE	256
+
+// Forward declaration - entity is defined in raylibODE.h
+struct entity;
+
+/**
+ * @brief backing store for all the entities in a physics context
+ *
+ * table.handles and bodies are packed in step, table.count long,
+ * removing an entity moves the last one into the hole, so iterate
+ * backwards if you free as you go.
+ */
+typedef struct EntityStore {
+	struct entity** pages;	/**< ENTITY_PAGE_SIZE entities per page, pages never move */
+	int pageCount;
+	HandleTable table;		/**< one slot per page entry, dense handle of each live entity */
+	dBodyID* bodies;		/**< dense, body of each live entity */
+	Arena* arena;			/**< if set entity pages come from here */
+} EntityStore;
+
+void EntityStoreInit(EntityStore* es, Arena* arena);
+void EntityStoreFree(EntityStore* es);
+void EntityStoreReserve(EntityStore* es, int count);
+struct entity* EntityStoreAdd(EntityStore* es, dBodyID body);
+void EntityStoreRemove(EntityStore* es, struct entity* ent);
+struct entity* EntityStoreGet(EntityStore* es, EntityHandle h);
+struct entity* EntityStoreAt(EntityStore* es, int i);
+
+#endif // ENTITYSTORE_H
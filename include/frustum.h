@@ -0,0 +1,69 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file frustum.h
+ * @brief Camera frustum culling of axis aligned boxes
+ *
+ * Boxes are gathered into a CullSet, struct of arrays so the test over
+ * all of them is a handful of tight loops the compiler can vectorise.
+ * Nothing here touches the GPU, a frustum can be built from any view
+ * projection matrix.
+ */
+
+#ifndef FRUSTUM_H
+#define FRUSTUM_H
+
+#include <stdbool.h>
+#include "raylib.h"
+
+/**
+ * @brief six planes facing inwards, a point p is inside a plane when
+ * x*p.x + y*p.y + z*p.z + w >= 0
+ */
+typedef struct Frustum {
+	Vector4 planes[6];	/**< left, right, bottom, top, near, far */
+} Frustum;
+
+/**
+ * @brief boxes to be culled, as centres and half extents
+ */
+typedef struct CullSet {
+	int count;
+	int capacity;
+	void** items;			/**< whatever each box belongs to, geoms for the framework */
+	float* centre[3];
+	float* extent[3];
+	unsigned char* visible;	/**< set by CullSetTest */
+} CullSet;
+
+Frustum FrustumFromMatrix(Matrix viewProjection);
+Frustum FrustumFromCamera(Camera camera, float aspect, float nearPlane, float farPlane);
+bool FrustumTestBox(const Frustum* f, const float* aabb);
+
+void CullSetClear(CullSet* cs);
+void CullSetAdd(CullSet* cs, void* item, const float* aabb);
+int CullSetTest(CullSet* cs, const Frustum* f);
+void FreeCullSet(CullSet* cs);
+
+#endif // FRUSTUM_H
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+/**
+ * @file handleTable.h
+ * @brief Generational handles over a packed array
+ *
+ * The bookkeeping shared by the entity store and the joint registry,
+ * each of those keeps its own payload arrays in step with handles[].
+ */
+
+#ifndef HANDLETABLE_H
+#define HANDLETABLE_H
+
+#include <stdint.h>
+
+/**
+ * The low HANDLE_INDEX_BITS of a handle are its slot, the remaining
+ * bits are a generation count that is bumped every time the slot is
+ * released, so a stale handle never resolves to whatever reuses the
+ * slot. Generation 0 is never used so 0 is never a valid handle.
+ */
+#define HANDLE_INDEX_BITS	20
+#define HANDLE_INDEX_MASK	((1u << HANDLE_INDEX_BITS) - 1)
+#define HANDLE_GEN_MASK		((1u << (32 - HANDLE_INDEX_BITS)) - 1)
+
+/**
+ * @brief slot bookkeeping and the dense array of live handles
+ *
+ * handles[0..count) is always packed, removing a handle moves the last
+ * one into the hole, the owner must do the same to its payload arrays.
+ */
+typedef struct HandleTable {
+	uint32_t* generation;	/**< per slot generation count */
+	int* denseIndex;		/**< per slot position in the dense arrays, -1 when free */
+	int* freeSlots;			/**< stack of released slots */
+	int freeCount;
+	int slotCount;			/**< slots handed out so far (high water mark) */
+	int slotCapacity;
+
+	uint32_t* handles;		/**< dense, handle of each live item */
+	int count;				/**< number of live items */
+	int capacity;
+} HandleTable;
+
+void HandleTableInit(HandleTable* ht);
+void HandleTableFree(HandleTable* ht);
+int HandleTableFreeSlots(const HandleTable* ht);
+void HandleTableGrowSlots(HandleTable* ht, int slots);
+void HandleTableGrowDense(HandleTable* ht, int capacity);
+uint32_t HandleTableAdd(HandleTable* ht);
+int HandleTableRemove(HandleTable* ht, uint32_t h);
+int HandleTableFind(const HandleTable* ht, uint32_t h);
+
+#endif // HANDLETABLE_H
@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file instancing.h
+ * @brief Instanced drawing of the framework's primitive meshes
+ *
+ * Instead of one draw call per box, sphere and cylinder (three for a
+ * capsule), geoms are queued into batches keyed by mesh and texture and
+ * each batch is drawn with a single instanced call. Transform, tint and
+ * uv scale travel per instance, so the shared models are never touched.
+ * With a texture atlas so does the region of it to use, so everything
+ * packed into a page is one batch per mesh.
+ */
+
+#ifndef INSTANCING_H
+#define INSTANCING_H
+
+#include "raylib.h"
+#include "rlights.h"
+#include "renderQueue.h"
+#include "textureAtlas.h"
+
+/**
+ * @brief per instance data, laid out as the instancing shader reads it
+ */
+typedef struct Instance {
+	float transform[16];	/**< column major model matrix */
+	float tint[4];			/**< rgba 0-1 */
+	float uvScale[2];		/**< texture coordinate scale */
+	float region;			/**< atlas region, 0 for the whole texture, read with uvScale as one vec4 */
+	float pad;
+} Instance;
+
+/**
+ * @brief the instances of one mesh with one texture
+ */
+typedef struct InstanceBatch {
+	Mesh* mesh;
+	unsigned int textureId;
+	int count;
+	int capacity;
+	int base;				/**< where this batch starts in the instance buffer */
+	Instance* instances;
+} InstanceBatch;
+
+/**
+ * @brief where a queued instance lives, its transform is filled in later
+ */
+typedef struct InstanceSlot {
+	int batch;
+	int index;
+} InstanceSlot;
+
+/**
+ * @brief the batches and GPU buffer used for instanced drawing
+ *
+ * Batches and their arrays are kept between frames, once they have grown
+ * to fit a scene queuing and drawing allocate nothing.
+ */
+typedef struct InstanceRenderer {
+	Shader shader;			/**< the instancing variant of simpleLight */
+	int transformLoc;		/**< first of four vec4 attribute locations */
+	int tintLoc;
+	int uvLoc;				/**< uv scale and atlas region */
+	int atlasLoc;			/**< the atlasRegions uniform */
+	const TextureAtlas* atlas;	/**< NULL or the atlas the regions are in */
+	int atlasVersion;		/**< of the regions last sent */
+	LightUniforms lights;	/**< this shader's light uniforms, sent only when they change */
+	unsigned int vbo;
+	int vboCapacity;		/**< in instances */
+	InstanceBatch* batches;
+	int batchCount;
+	int batchCapacity;
+	int drawCalls;			/**< made by the last DrawInstances */
+	int instanceCount;		/**< drawn by the last DrawInstances */
+	int triangles;			/**< drawn by the last DrawInstances */
+	int stateChanges;		/**< texture and mesh binds made by the last DrawInstances */
+	RenderQueue queue;		/**< the batches in the order they are drawn */
+} InstanceRenderer;
+
+void InitInstancing(InstanceRenderer* r, Shader shader, const TextureAtlas* atlas);
+void FreeInstancing(InstanceRenderer* r);
+void BeginInstancing(InstanceRenderer* r);
+InstanceSlot AddInstance(InstanceRenderer* r, Mesh* mesh, AtlasRegion texture,
+					Color tint, Vector2 uvScale);
+float* InstanceTransform(InstanceRenderer* r, InstanceSlot slot);
+void SortInstanceBatches(InstanceRenderer* r, Vector3 viewPos);
+void DrawInstances(InstanceRenderer* r, Vector3 viewPos, const Light* lights, const LightSet* sceneLights);
+
+#endif // INSTANCING_H
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file jointRegistry.h
+ * @brief Tracks the joints in a physics context
+ *
+ * Like entities, joints are addressed by generational handles and kept
+ * in dense arrays, so they can be iterated, torn down in bulk and have
+ * motor parameters written in one tight loop.
+ */
+
+#ifndef JOINTREGISTRY_H
+#define JOINTREGISTRY_H
+
+#include <stdint.h>
+#include <ode/ode.h>
+#include "handleTable.h"
+
+/**
+ * @brief a stable reference to a registered joint
+ *
+ * A struct so it can't be mixed up with an EntityHandle, the id is a
+ * HandleTable handle just like an entity's.
+ */
+typedef struct JointHandle {
+	uint32_t id;
+} JointHandle;
+
+/**
+ * @brief what made a joint, so related joints can be dealt with together
+ */
+typedef enum JointKind {
+	JOINT_USER = 0,		/**< registered by the user */
+	JOINT_ROTOR,		/**< CreateRotor */
+	JOINT_PISTON,		/**< CreatePiston and multi pistons */
+	JOINT_PIN,			/**< PinEntities and PinEntityToWorld */
+	JOINT_VEHICLE,		/**< wheels and marker of a vehicle */
+	JOINT_RAGDOLL,		/**< ragdoll limbs */
+	JOINT_KIND_COUNT,
+	JOINT_ANY = JOINT_KIND_COUNT	/**< matches every kind when freeing */
+} JointKind;
+
+/**
+ * @brief registry of all the joints in a physics context
+ *
+ * table.handles, joints and kinds are packed in step, table.count long,
+ * removing a joint moves the last one into the hole, so iterate
+ * backwards if you free as you go.
+ */
+typedef struct JointRegistry {
+	HandleTable table;		/**< slots and the dense handle of each joint */
+	dJointID* joints;		/**< dense, the joints themselves */
+	unsigned char* kinds;	/**< dense, JointKind of each joint */
+} JointRegistry;
+
+void JointRegistryInit(JointRegistry* jr);
+void JointRegistryFree(JointRegistry* jr);
+JointHandle JointRegistryAdd(JointRegistry* jr, dJointID joint, JointKind kind);
+void JointRegistryRemove(JointRegistry* jr, JointHandle h);
+dJointID JointRegistryGet(JointRegistry* jr, JointHandle h);
+
+#endif // JOINTREGISTRY_H
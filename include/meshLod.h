@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file meshLod.h
+ * @brief Coarser versions of the built in primitive meshes
+ *
+ * A sphere a few pixels across doesn't need two thousand triangles.
+ * Each primitive has LOD_LEVELS meshes, finest first, and every geom
+ * keeps the level it was last drawn at. The level only changes once
+ * the geom's size on screen is clearly past a threshold, so something
+ * sat near one doesn't flicker between levels.
+ */
+
+#ifndef MESHLOD_H
+#define MESHLOD_H
+
+#include "raylib.h"
+
+#define LOD_LEVELS 4
+#define LOD_HYSTERESIS 0.15f	// fraction past a threshold before the level changes
+
+/**
+ * @brief the levels of one primitive, finest first
+ */
+typedef struct MeshLod {
+	Mesh* levels[LOD_LEVELS];	/**< level 0 is the primitive model's own mesh */
+	Mesh owned[LOD_LEVELS];		/**< the coarser levels, generated */
+	int ownedCount;
+} MeshLod;
+
+void InitSphereLod(MeshLod* lod, Mesh* finest);
+void InitCylinderLod(MeshLod* lod, Mesh* finest);
+void FreeMeshLod(MeshLod* lod);
+Mesh GenMeshCylinderFaceted(int sides);
+float LodScreenSize(Camera camera, int screenHeight, Vector3 pos, float size);
+int SelectLod(int current, float pixels);
+
+#endif // MESHLOD_H
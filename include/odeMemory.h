@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file odeMemory.h
+ * @brief Tracked allocator for ODE's own allocations
+ *
+ * ODE allocates internally for bodies, joints, contacts and stepper
+ * scratch space. Once installed these handlers route its small
+ * allocations through size class pools and keep count of what it uses,
+ * so allocation churn inside a step can be seen (and then cut).
+ *
+ * ODE's handlers are global, they must be installed before ODE is
+ * initialised and can't be removed while anything ODE allocated is
+ * still alive. They aren't thread safe, so they are only installed if
+ * TrackOdeAllocations(true) is called before the first CreatePhysics,
+ * and only then if every world is stepped from the same thread.
+ * FreePhysics releases them once nothing ODE allocated is left.
+ */
+
+#ifndef ODEMEMORY_H
+#define ODEMEMORY_H
+
+#include <stddef.h>
+#include <stdbool.h>
+
+/**
+ * @brief what ODE has allocated through the tracked handlers
+ */
+typedef struct OdeMemStats {
+	bool installed;			/**< false if the handlers aren't in use, everything else is 0 */
+	size_t liveBytes;		/**< bytes ODE currently holds */
+	size_t peakBytes;		/**< most bytes ODE has held at once */
+	unsigned long allocs;	/**< allocations (including reallocs that moved) since start up */
+	unsigned long frees;
+	unsigned long stepAllocs;	/**< allocations made during the last StepPhysics */
+	size_t stepBytes;		/**< bytes allocated during the last StepPhysics */
+	int steps;				/**< world steps taken during the last StepPhysics */
+} OdeMemStats;
+
+void TrackOdeAllocations(bool enable);
+void InstallOdeAllocator(void);
+void ReleaseOdeAllocator(void);
+bool OdeAllocatorWanted(void);
+void OdeMemStepBegin(void);
+void OdeMemStepEnd(int steps);
+OdeMemStats GetOdeMemStats(void);
+void PrintOdeMemStats(void);
+
+#endif // ODEMEMORY_H
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file pool.h
+ * @brief Fixed size slab pool with a free list
+ *
+ * Items are carved out of pages that are never moved, released items go
+ * on an intrusive free list and are handed out again before any new page
+ * is allocated, so once a scene has warmed up creating and destroying
+ * objects doesn't touch the heap.
+ */
+
+#ifndef POOL_H
+#define POOL_H
+
+#include <stddef.h>
+#include <stdbool.h>
+#include "arena.h"
+
+typedef struct Pool {
+	const char* name;	/**< used when reporting usage */
+	size_t itemSize;	/**< rounded up to keep items aligned */
+	int itemsPerPage;
+	void** pages;
+	int pageCount;
+	void* freeList;		/**< released items, linked through their first bytes */
+	int live;			/**< items currently handed out */
+	int highWater;		/**< most items ever handed out at once */
+	Arena* arena;		/**< if set pages come from here and are never freed individually */
+} Pool;
+
+void PoolInit(Pool* pool, const char* name, size_t itemSize, int itemsPerPage, Arena* arena);
+void* PoolAlloc(Pool* pool);
+void PoolRelease(Pool* pool, void* item);
+void PoolReserve(Pool* pool, int count);
+void PoolFree(Pool* pool);
+void PoolPrintUsage(Pool* pool);
+
+#endif // POOL_H
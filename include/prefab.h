@@ -0,0 +1,171 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file prefab.h
+ * @brief Templates of bodies, geoms and joints that can be stamped out
+ *
+ * A prefab records everything needed to build an assembly, a ragdoll,
+ * vehicle or marble lift say, relative to a root point. Making a copy is
+ * one transform applied to precomputed data, the masses, limits and
+ * materials are just copied. Prefabs can be captured from objects built
+ * the usual way, assembled in code with the PrefabAdd functions, or
+ * saved to and loaded from a text file.
+ */
+
+#ifndef PREFAB_H
+#define PREFAB_H
+
+#include <stdbool.h>
+#include "raylibODE.h"
+
+#define PREFAB_WORLD	-1	/**< body index meaning the static world */
+#define PREFAB_NO_KIND	-1	/**< joint kind for joints left out of the registry */
+
+/**
+ * @brief the graphics context textures a prefab geom can use
+ *
+ * Textures are referred to by slot rather than pointer so a prefab isn't
+ * tied to one GraphicsContext and can be written to disk.
+ */
+typedef enum PrefabTexture {
+	PREFAB_TEX_NONE = 0,	/**< an invisible geom */
+	PREFAB_TEX_BOX0,
+	PREFAB_TEX_BOX1,
+	PREFAB_TEX_SPHERE0,
+	PREFAB_TEX_SPHERE1,
+	PREFAB_TEX_SPHERE2,
+	PREFAB_TEX_CYLINDER0,
+	PREFAB_TEX_CYLINDER1,
+	PREFAB_TEX_CAPSULE0,
+	PREFAB_TEX_CAPSULE1,
+	PREFAB_TEX_GROUND,
+	PREFAB_TEX_COUNT
+} PrefabTexture;
+
+/**
+ * @brief a body, its mass is in body space so it's the same for every copy
+ */
+typedef struct PrefabBody {
+	dVector3 pos;			/**< relative to the root */
+	dQuaternion rot;		/**< relative to the root */
+	dMass mass;
+	bool autoDisable;
+	bool finiteRotation;
+	bool gravity;			/**< affected by the world's gravity */
+	float linearDamping;
+	float angularDamping;
+	float maxAngularSpeed;	/**< 0 for no limit */
+} PrefabBody;
+
+/**
+ * @brief a geom, either attached to one of the prefab's bodies or static
+ *
+ * size is the lengths of a box, x is the radius of a sphere and x, y
+ * the radius and length of a cylinder or capsule
+ */
+typedef struct PrefabGeom {
+	int body;				/**< owning body or PREFAB_WORLD for a static geom */
+	int shape;				/**< dBoxClass, dSphereClass, dCylinderClass or dCapsuleClass */
+	Vector3 size;
+	dVector3 pos;			/**< offset from the body, from the root when static */
+	dQuaternion rot;
+	unsigned char texture;	/**< PrefabTexture */
+	unsigned char surface;	/**< SurfaceType */
+	bool collidable;
+	float uvScaleU;
+	float uvScaleV;
+	unsigned long category;
+	unsigned long collide;
+} PrefabGeom;
+
+/**
+ * @brief a joint between two of the prefab's bodies, or a body and the world
+ *
+ * Only the parameters that make sense for the joint type are applied,
+ * the suspension values are only used by hinge2 joints. bounce and the
+ * ERP and CFM values are those of the first axis, an ERP or CFM of 0
+ * leaves the value the joint takes from the world.
+ */
+typedef struct PrefabJoint {
+	int type;				/**< dJointTypeBall, Hinge, Slider, Universal, Hinge2 or Fixed */
+	int body1;
+	int body2;				/**< PREFAB_WORLD to attach to the world */
+	dVector3 anchor;		/**< relative to the root */
+	dVector3 axis1;
+	dVector3 axis2;
+	float lo, hi;
+	float lo2, hi2;
+	float fmax, fmax2;
+	float vel, vel2;		/**< motor target velocities */
+	float bounce;
+	float erp, cfm;
+	float stopERP, stopCFM;
+	float suspensionERP, suspensionCFM;
+	int kind;				/**< JointKind to register as or PREFAB_NO_KIND */
+} PrefabJoint;
+
+typedef struct Prefab {
+	char name[64];
+	PrefabBody* bodies;
+	PrefabGeom* geoms;		/**< a body's geoms are kept together, in the order they were made */
+	PrefabJoint* joints;
+	int bodyCount, bodyCapacity;
+	int geomCount, geomCapacity;
+	int jointCount, jointCapacity;
+} Prefab;
+
+/**
+ * @brief what InstantiatePrefab made, the arrays match the prefab's
+ */
+typedef struct PrefabInstance {
+	const Prefab* prefab;
+	dBodyID* bodies;
+	dGeomID* geoms;			/**< static geoms included */
+	dJointID* joints;
+} PrefabInstance;
+
+Prefab* CreatePrefab(const char* name);
+void FreePrefab(Prefab* pf);
+int PrefabAddBody(Prefab* pf, const PrefabBody* body);
+int PrefabAddGeom(Prefab* pf, const PrefabGeom* geom);
+int PrefabAddJoint(Prefab* pf, const PrefabJoint* joint);
+
+Prefab* CapturePrefab(PhysicsContext* ctx, GraphicsContext* gfxCtx, const char* name, Vector3 root,
+                      const dBodyID* bodies, int bodyCount, const dJointID* joints, int jointCount,
+                      const dGeomID* statics, int staticCount);
+// see prefab.c for the file format
+bool SavePrefab(const Prefab* pf, const char* path);
+Prefab* LoadPrefab(const char* path);
+
+// the context owns prefabs added to it, they're freed with it
+Prefab* AddPrefab(PhysicsContext* ctx, Prefab* pf);
+Prefab* GetPrefab(PhysicsContext* ctx, const char* name);
+void FreePrefabs(PhysicsContext* ctx);
+
+void StampPrefab(PhysicsContext* ctx, GraphicsContext* gfxCtx, const Prefab* pf, Vector3 pos, Quaternion rot,
+                 dBodyID* bodies, dGeomID* geoms, dJointID* joints);
+PrefabInstance* InstantiatePrefab(PhysicsContext* ctx, GraphicsContext* gfxCtx, const Prefab* pf, Vector3 pos, Quaternion rot);
+void FreePrefabInstance(PhysicsContext* ctx, PrefabInstance* inst);
+
+#endif // PREFAB_H
@@ -56,13 +56,17 @@ typedef enum {
     RAGDOLL_BODY_COUNT         // Total count
 } RagdollBodyPart;
 
+#define RAGDOLL_JOINT_COUNT 9  // neck, shoulders, elbows, hips, knees
+
 
 // Forward declaration - GraphicsContext is defined in init.h
 struct GraphicsContext;
+struct Prefab;
 
 // Rag doll functions - generic for neural network muscle control
 //RagDoll* CreateRagdoll(dSpaceID space, dWorldID world, Vector3 position, struct GraphicsContext* ctx);
 RagDoll* CreateRagdoll(struct PhysicsContext* pctx, struct GraphicsContext* ctx, Vector3 position);
+struct Prefab* GetRagdollPrefab(struct PhysicsContext* pctx, struct GraphicsContext* ctx);
 
 void UpdateRagdollMotors(RagDoll *ragdoll, float *motorForces);
 void DrawRagdoll(RagDoll *ragdoll, struct GraphicsContext* ctx);
@@ -31,6 +31,18 @@
 #include <ode/ode.h>
 #include "clist.h"
 #include "surface.h"
+#include "entityStore.h"
+#include "assets.h"
+#include "assetLoader.h"
+#include "odeMemory.h"
+#include "jointRegistry.h"
+#include "instancing.h"
+#include "frustum.h"
+#include "renderPrep.h"
+#include "meshLod.h"
+#include "capsuleMesh.h"
+#include "staticBatch.h"
+#include "renderBackend.h"
 
 
 
@@ -55,20 +67,97 @@ enum SHAPE_TYPE {
 	SHAPE_ALL		= 0x20 - 1,
 };
 
+/**
+ * @brief describes one entity for SpawnEntities
+ *
+ * How size is used depends on the shape
+ * - SHAPE_BOX      x, y, z are the lengths of the sides
+ * - SHAPE_SPHERE   x is the radius
+ * - SHAPE_CYLINDER x is the radius, y the length
+ * - SHAPE_CAPSULE  x is the radius, y the length
+ * - SHAPE_DUMBBELL x is the shaft radius, y the shaft length, z the end radius
+ */
+typedef struct EntityDesc {
+	unsigned char shape;	/**< a single SHAPE_ value */
+	Vector3 size;
+	Vector3 pos;
+	Vector3 rot;			/**< Euler angles */
+	float mass;
+	struct Texture* texture; /**< NULL picks one like CreateBox etc do */
+} EntityDesc;
+
+// box, sphere, cylinder and capsule bodies can be retired and reused
+#define RETIRED_SHAPES 4
+
 typedef struct entity {
 	dBodyID body;/**< ODE physics body for this entity */
-	cnode_t* node; /**< all entities are in a global list, this is its list node */
+	cnode_t* node; /**< entities are also kept in objList for older code, this is its list node */
 	void* data; /**< user data pointer tag on extra meta data to a geom. */
+	EntityHandle handle; /**< stable handle, this is what the body's data points at */
 } entity;
 
+/**
+ * @brief how much memory a physics context is using, see GetPhysicsMemoryStats
+ *
+ * The counts are kept up to date as things are created and destroyed,
+ * so reading them doesn't have to walk the scene.
+ */
+typedef struct PhysicsMemoryStats {
+	int entities;
+	size_t entityBytes;
+	int geomInfos;			/**< pooled geomInfo, ones you allocate yourself aren't counted */
+	size_t geomInfoBytes;
+	size_t visualBytes;		/**< the part of geomInfoBytes used by the embedded Model */
+	int listNodes;
+	size_t listNodeBytes;
+	int trimeshes;			/**< static trimesh geoms */
+	size_t trimeshBytes;	/**< their indices, a shared mesh is counted by each geom, the vertices belong to the model */
+	int contactJoints;		/**< contacts made during the last StepPhysics */
+	int userJoints;			/**< joints in the context's registry */
+	int rayCasts;			/**< process wide, ray casts don't belong to a context */
+	size_t rayCastBytes;	/**< process wide, not part of totalBytes */
+	size_t frameworkBytes;	/**< heap held by the context's arena and entity store */
+	size_t odeBytes;		/**< process wide, ODE's memory for every world, 0 unless TrackOdeAllocations(true), not part of totalBytes */
+	size_t totalBytes;		/**< this context's own memory, frameworkBytes and trimeshBytes */
+} PhysicsMemoryStats;
+
+/**
+ * @brief what DrawBodies and DrawStatics drew during the last frame
+ */
+typedef struct RenderStats {
+	int bodyGeoms;			/**< body geoms inside the camera frustum */
+	int bodyGeomsCulled;	/**< body geoms skipped as outside it */
+	int bodyDrawCalls;		/**< instanced draws made by DrawBodies */
+	int bodyStateChanges;	/**< texture and mesh binds made by DrawBodies */
+	int staticGeoms;
+	int staticGeomsCulled;
+	int staticDrawCalls;
+	int staticStateChanges;
+	int bodyTriangles;		/**< triangles in the instanced draws */
+	int staticTriangles;
+	int bodyLods[LOD_LEVELS];	/**< primitive geoms drawn at each level of detail */
+	int staticLods[LOD_LEVELS];
+	int bodyReused;			/**< cached transforms used instead of built */
+	int staticReused;
+} RenderStats;
+
 // Physics context - holds all physics state
 typedef struct PhysicsContext {
     dWorldID world;
     dSpaceID space;             
     dJointGroupID contactgroup;
+    dGeomID ray; // reused by PickEntity and CastRay, in no space
     float frameTime; // cumlative frame time
-	clist_t* objList;
+	Arena arena; // backs entities, pooled geomInfo and list nodes
+	EntityStore entities; // dense storage for all the dynamic entities
+	JointRegistry joints; // every joint made by the framework or registered by the user
+	clist_t* objList; // compatibility list of entities, prefer GetEntityAt or ForEachEntity
 	clist_t* statics; // list of static ode geoms
+	clist_t* retired[RETIRED_SHAPES]; // bodies parked by RetireEntity, per shape, for reuse
+	clist_t* prefabs; // templates added with AddPrefab, freed with the context
+	Pool geomPool; // geomInfo allocations
+	Pool nodePool; // list nodes for objList and statics
+	PhysicsMemoryStats memStats; // running counters, read them with GetPhysicsMemoryStats
 	void* data; // user data pointer
 } PhysicsContext;
 
@@ -109,10 +198,16 @@ typedef struct geomInfo {
      * @{ */
     int* indices;           /**< Pointer to the array of vertex indices. */
     dTriMeshDataID triData; /**< ODE/Physics-specific trimesh data identifier. */
+    SharedTrimesh* trimesh; /**< if set indices and triData are shared from the asset cache */
     /** @} */
 
     TriggerCallback triggerOnCollide;  /**< If this is non-NULL, the geom acts as a ghost/trigger */
     void* data; /**< user data pointer tag on extra meta data to a geom. */
+    bool pooled; /**< came from the physics context's pool, set by CreateGeomInfo, false (zeroed) in your own allocations */
+    unsigned char lod; /**< level of detail it was last drawn at */
+    TransformCache transform; /**< kept while it is static or its body is disabled */
+    bool baked; /**< drawn as part of a static batch, see BakeStaticRenderBatches */
+    bool visualTextured; /**< visual's first material shows texture, kept in step as it loads */
 } geomInfo;
 
 
@@ -147,18 +242,35 @@ typedef struct GraphicsContext {
     Model box;
     Model ball;
     Model cylinder;
+    MeshLod ballLod;                // ball's mesh then coarser spheres
+    MeshLod cylinderLod;            // cylinder's mesh then coarser cylinders
+    CapsuleMeshes capsules;         // one unit capsule per length to radius ratio
     
-    
-    // TODO capsules really need their own textures not cylinder texutres
-    // Texture arrays for different geometry types
-    Texture sphereTextures[3];      // ball.png, beach-ball.png, earth.png
-    Texture boxTextures[2];         // crate.png, grid.png
-    Texture cylinderTextures[2];    // drum.png, cylinder2.png
-    Texture groundTexture;          // grass.png
+    // The framework's textures for different geometry types, these are
+    // handles, UseTexture(assets, handle) gives the Texture* and starts
+    // loading it the first time
+    AssetLoader* assets;            // textures and models loaded when first used
+    TextureHandle sphereTextures[3];    // ball.png, beach-ball.png, earth.png
+    TextureHandle boxTextures[2];       // crate.png, grid.png
+    TextureHandle cylinderTextures[2];  // drum.png, cylinder2.png
+    TextureHandle capsuleTextures[2];   // generated, banded and checked
+    TextureHandle groundTexture;        // grass.png
+    TextureAtlas atlas;             // loaded textures packed so instanced draws share them
     
     Camera camera;
     Shader shader;
+    Shader instanceShader;          // simpleLight with per instance transform, tint, uv scale and atlas region
+    InstanceRenderer instancing;    // batches the primitives for DrawBodies and DrawStatics
+    CullSet culling;                // geom bounds gathered for frustum culling
+    RenderPrep prep;                // poses waiting to become instance transforms
+    StaticBatches staticBatches;    // static primitives merged by BakeStaticRenderBatches
+    RenderStats renderStats;        // read with GetRenderStats
+    RenderBackend backend;          // where draws go, see CreateRecordingGraphics
+    int lodCounts[LOD_LEVELS];      // geoms queued at each level since the last FlushGeoms
+    int reusedTransforms;           // cached transforms queued since the last FlushGeoms
     Light lights[MAX_LIGHTS];
+    LightSet sceneLights;           // any number of lights, each batch gets the MAX_LIGHTS nearest it
+    LightUniforms lightUniforms;    // shader's light uniforms, for lighting static batches from sceneLights
 } GraphicsContext;
 
 
@@ -184,6 +296,8 @@ typedef struct vehicle {
 
 // Initialize graphics resources and window
 GraphicsContext* CreateGraphics(int width, int height, const char* title);
+// a graphics context with no window that records its draws
+GraphicsContext* CreateRecordingGraphics(int width, int height);
 
 // Initialize the physics world and create all objects
 // Returns pointer to PhysicsContext
@@ -196,8 +310,27 @@ void FreeGraphics(GraphicsContext* ctx);
 
 entity* CreateBaseEntity(PhysicsContext* ctx);
 
+// register an existing body with the framework
+entity* AttachEntity(PhysicsContext* ctx, dBodyID bdy);
+
+// entity lookup and iteration
+typedef void (*EntityCallback)(PhysicsContext* ctx, entity* ent, void* user);
+entity* GetEntity(PhysicsContext* ctx, EntityHandle h);
+entity* GetBodyEntity(PhysicsContext* ctx, dBodyID bdy);
+int GetEntityCount(PhysicsContext* ctx);
+entity* GetEntityAt(PhysicsContext* ctx, int i);
+void ForEachEntity(PhysicsContext* ctx, EntityCallback fn, void* user);
+
 // Helper to allocate geomInfo with collision flag, optional texture, and UV scale
-geomInfo* CreateGeomInfo(bool collidable, Texture* texture, float uvScaleU, float uvScaleV);
+geomInfo* CreateGeomInfo(PhysicsContext* ctx, bool collidable, Texture* texture, float uvScaleU, float uvScaleV);
+void FreeGeomInfo(PhysicsContext* ctx, geomInfo* gi);
+
+// print the usage and high water marks of the context's allocation pools
+void PrintPoolUsage(PhysicsContext* ctx);
+PhysicsMemoryStats GetPhysicsMemoryStats(PhysicsContext* ctx);
+void DrawPhysicsMemoryStats(PhysicsContext* ctx, int x, int y);
+RenderStats GetRenderStats(GraphicsContext* ctx);
+void DrawRenderStats(GraphicsContext* ctx, int x, int y);
 
 // create a geom only but with geomInfo attched
 dGeomID CreateSphereGeom(PhysicsContext* ctx, GraphicsContext* gfxCtx, float radius, Vector3 pos);
@@ -214,6 +347,7 @@ entity* CreateDumbbell(PhysicsContext* ctx, GraphicsContext* gfxCtx, float shaft
 
 // add a random simple physics object to the world
 entity* CreateRandomEntity(PhysicsContext* ctx, GraphicsContext* gfxCtx, Vector3 pos, unsigned char mask);
+void SpawnEntities(PhysicsContext* ctx, GraphicsContext* gfxCtx, const EntityDesc* descs, int n, entity** out);
 
 // return a reference to an entity the mouse is pointing to...
 entity* PickEntity(PhysicsContext* physCtx, GraphicsContext* gfxCtx, Vector3* hitPoint);
@@ -223,10 +357,12 @@ void SetEntityHew(entity* ent, Color c);
 dJointID CreateRotor(PhysicsContext* physCtx, entity* from, entity* to, Vector3 axis);
 
 // free a body, freeing its geoms first
-void FreeBodyAndGeoms(dBodyID bdy);
+void FreeBodyAndGeoms(PhysicsContext* ctx, dBodyID bdy);
 
 //void drawAllSpaceGeoms(dSpaceID space, struct GraphicsContext* ctx);
 void DrawGeom(dGeomID geom, struct GraphicsContext* ctx);
+void QueueGeom(dGeomID geom, struct GraphicsContext* ctx);
+void FlushGeoms(struct GraphicsContext* ctx);
 
 // draw all the bodies in the object list
 void DrawBodies(struct GraphicsContext* ctx, PhysicsContext* pctx);
@@ -235,6 +371,10 @@ void DrawBodies(struct GraphicsContext* ctx, PhysicsContext* pctx);
 // draw static geoms
 void DrawStatics(struct GraphicsContext* ctx, PhysicsContext* pctx);
 
+// merge static primitives into a few meshes that DrawStatics draws
+void BakeStaticRenderBatches(PhysicsContext* ctx, GraphicsContext* gfxCtx);
+void DrawStaticRenderBatches(GraphicsContext* gfxCtx);
+
 // Random float in range [min, max]
 float rndf(float min, float max);
 
@@ -242,6 +382,8 @@ float rndf(float min, float max);
 int StepPhysics(PhysicsContext* physCtx);
 
 void FreeEntity(PhysicsContext* physCtx, entity* ent);
+void RetireEntity(PhysicsContext* ctx, entity* ent);
+void RecycleEntity(PhysicsContext* ctx, entity* ent, Vector3 pos, Vector3 rot);
 
 void SetPistonLimits(dJointID joint, float min, float max);
 dJointID CreatePiston(PhysicsContext* physCtx, entity* entA, entity* entB, float strength);
@@ -267,7 +409,17 @@ dGeomID CreateBoxGeom(PhysicsContext* ctx, GraphicsContext* gfxCtx, Vector3 size
 
 void SetGeomOrientationEuler(dGeomID g, float p, float y, float r);
 
-void FreeMultiPiston(MultiPiston* mp);
+void FreeMultiPiston(PhysicsContext* physCtx, MultiPiston* mp);
+
+JointHandle RegisterJoint(PhysicsContext* ctx, dJointID joint, JointKind kind);
+JointHandle GetJointHandle(dJointID joint);
+dJointID GetJoint(PhysicsContext* ctx, JointHandle h);
+int GetJointCount(PhysicsContext* ctx);
+dJointID GetJointAt(PhysicsContext* ctx, int i);
+JointKind GetJointKindAt(PhysicsContext* ctx, int i);
+void FreeJoint(PhysicsContext* ctx, dJointID joint);
+void FreeJoints(PhysicsContext* ctx, JointKind kind);
+void SetJointMotors(PhysicsContext* ctx, const JointHandle* handles, const float* velocity, const float* fmax, int n);
 
 void SetEntitySurfaces(entity* ent, SurfaceMaterial* mat);
 
@@ -275,6 +427,7 @@ void UpdateRotorPID(RotorPID* pid, dJointID joint);
 RotorPID CreateRotorPID(float p, float i, float d, float lo, float hi);
 
 RayCast* CreateRayCast(int maxHits, Vector3 pos, Vector3 direction, dReal length);
+void FreeRayCast(RayCast* rc);
 void CastRay(PhysicsContext* physCtx, RayCast* rc);
 
 #endif // RAYLIBODE_H
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file renderBackend.h
+ * @brief Where the framework's draws end up
+ *
+ * DrawBodies, DrawStatics, DrawRagdoll and the visual models of geoms
+ * don't call raylib to draw, they go through the graphics context's
+ * backend. The raylib backend draws as normal. The recording backend
+ * draws nothing, it keeps a list of what would have been drawn, so the
+ * CPU side of rendering can be timed and checked without a window.
+ */
+
+#ifndef RENDERBACKEND_H
+#define RENDERBACKEND_H
+
+#include "raylib.h"
+#include "rlights.h"
+#include "instancing.h"
+
+/**
+ * @brief one mesh drawn once, as captured by the recording backend
+ */
+typedef struct DrawRecord {
+	const Mesh* mesh;		/**< the mesh drawn, without a window nothing has a vertex array id */
+	unsigned int textureId;	/**< the diffuse texture, or its atlas page */
+	int region;				/**< the atlas region, 0 for the whole texture */
+	float transform[16];	/**< column major model matrix */
+	Color tint;
+} DrawRecord;
+
+typedef struct RenderBackend RenderBackend;
+
+/**
+ * @brief the draws the framework makes, with the recording backend's list
+ */
+struct RenderBackend {
+	/** draw an instance renderer's batches, filling in its draw counts */
+	void (*drawInstances)(RenderBackend* be, InstanceRenderer* r, Vector3 viewPos,
+							const Light* lights, const LightSet* sceneLights);
+	/** send MAX_LIGHTS lights to a shader, only what changed */
+	void (*uploadLights)(RenderBackend* be, LightUniforms* u, Shader shader, const Light* lights);
+	/** draw a single mesh */
+	void (*drawMesh)(RenderBackend* be, const Mesh* mesh, Material material, Matrix transform);
+	/** the view projection matrix culling is done with */
+	Matrix (*viewProjection)(RenderBackend* be, Camera camera);
+	/** height of the view in pixels, for picking levels of detail */
+	int (*screenHeight)(RenderBackend* be);
+
+	int width;				/**< recording only, size of the pretend view */
+	int height;
+	DrawRecord* records;	/**< recording only, everything drawn since ClearDrawRecords */
+	int recordCount;
+	int recordCapacity;
+};
+
+void InitRaylibBackend(RenderBackend* be);
+void InitRecordingBackend(RenderBackend* be, int width, int height);
+void ClearDrawRecords(RenderBackend* be);
+void FreeRenderBackend(RenderBackend* be);
+
+#endif // RENDERBACKEND_H
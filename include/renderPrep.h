@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file renderPrep.h
+ * @brief Builds instance transforms in bulk from ODE poses
+ *
+ * Drawing queues an entry per instance holding the geom's ODE position
+ * and rotation, the scale of its shape and where its transform goes.
+ * RenderPrepBuild then turns the lot into column major matrices in one
+ * pass over struct of arrays storage, four at a time with SSE where it
+ * is available and split across threads for big scenes. The threads are
+ * started by the first big build and kept until FreeRenderPrep, so
+ * later builds don't create any.
+ *
+ * Geoms that are not moving can keep their last transform in a
+ * TransformCache, it is reused for as long as the pose it was built
+ * from is unchanged and those geoms never reach the build at all.
+ */
+
+#ifndef RENDERPREP_H
+#define RENDERPREP_H
+
+#include "raylib.h"
+#include "instancing.h"
+
+#define RENDER_PREP_THREADS 4			// most threads a build is split over
+#define RENDER_PREP_MT_THRESHOLD 8192	// fewer entries than this are built on one thread
+
+/**
+ * @brief a geom's last built transform and the pose it was built from
+ */
+typedef struct TransformCache {
+	float pose[15];			/**< position, rotation rows and scale */
+	float transform[16];
+	bool valid;				/**< transform was built from pose */
+} TransformCache;
+
+typedef struct PrepPool PrepPool;
+
+/**
+ * @brief the poses waiting to be turned into transforms
+ */
+typedef struct RenderPrep {
+	int count;
+	int capacity;
+	float* rot[9];			/**< rotation, row major, ODE's padding dropped */
+	float* pos[3];
+	float* scale[3];		/**< along the geom's local axes */
+	InstanceSlot* slots;	/**< where each transform is written */
+	TransformCache** cache;	/**< also written here when not NULL */
+	float** dest;			/**< the slots resolved to pointers during the build */
+	int threads;			/**< threads used by the last build */
+	PrepPool* pool;			/**< worker threads, NULL until a build is big enough */
+} RenderPrep;
+
+void RenderPrepClear(RenderPrep* p);
+void RenderPrepAdd(RenderPrep* p, const float* pos, const float* rot, Vector3 scale,
+					InstanceSlot slot, TransformCache* cache);
+void RenderPrepBuild(RenderPrep* p, InstanceRenderer* r);
+void RenderPrepBuildRange(RenderPrep* p, int from, int to);
+void FreeRenderPrep(RenderPrep* p);
+bool TransformCacheMatch(TransformCache* c, const float* pos, const float* rot, Vector3 scale);
+
+#endif // RENDERPREP_H
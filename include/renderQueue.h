@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file renderQueue.h
+ * @brief Draw items ordered by packed 64 bit sort keys
+ *
+ * Each draw item pushes a key holding, from the top bit down, its pass,
+ * shader, texture, mesh and depth, along with an item number saying
+ * what to draw. Sorting the keys groups the items that share state, so
+ * drawing them in order binds each shader, texture and mesh as few times
+ * as possible, and items with the same state are drawn front to back.
+ */
+
+#ifndef RENDERQUEUE_H
+#define RENDERQUEUE_H
+
+#include <stdint.h>
+
+// bits of each key field, pass at the top and depth at the bottom
+#define RENDER_KEY_PASS_BITS 4
+#define RENDER_KEY_SHADER_BITS 8
+#define RENDER_KEY_TEXTURE_BITS 16
+#define RENDER_KEY_MESH_BITS 16
+#define RENDER_KEY_DEPTH_BITS 20
+
+#define RENDER_PASS_OPAQUE 0
+
+/**
+ * @brief keys and what they draw, sorted together
+ */
+typedef struct RenderQueue {
+	int count;
+	int capacity;
+	uint64_t* keys;
+	int* items;			/**< the caller's draw item for each key */
+	uint64_t* spareKeys;	/**< radix sort scatters into these then swaps */
+	int* spareItems;
+	int sortPasses;		/**< byte passes the last sort needed */
+} RenderQueue;
+
+uint64_t RenderKey(unsigned int pass, unsigned int shader, unsigned int texture, unsigned int mesh, float depthSq);
+void RenderQueueClear(RenderQueue* q);
+void RenderQueuePush(RenderQueue* q, uint64_t key, int item);
+void RenderQueueSort(RenderQueue* q);
+void FreeRenderQueue(RenderQueue* q);
+
+#endif // RENDERQUEUE_H
@@ -66,6 +66,22 @@ typedef enum {
     LIGHT_POINT
 } LightType;
 
+// A shader's light uniforms and the values last sent to them, so only
+// the ones that change are sent again
+typedef struct {
+    Light slots[MAX_LIGHTS];    // uniform locations and last sent values
+    bool valid;                 // false sends everything on the next upload
+    int uniformsSent;           // running count, for measuring
+} LightUniforms;
+
+// Any number of lights, the most relevant MAX_LIGHTS are picked from it
+// for whatever is being drawn
+typedef struct {
+    Light* lights;              // only type, enabled, position, target and color are used
+    int count;
+    int capacity;
+} LightSet;
+
 #ifdef __cplusplus
 extern "C" {            // Prevents name mangling of functions
 #endif
@@ -76,6 +92,13 @@ extern "C" {            // Prevents name mangling of functions
 Light CreateLight(int type, Vector3 position, Vector3 target, Color color, Shader shader);   // Create a light and get shader locations
 void UpdateLightValues(Shader shader, Light light);         // Send light properties to shader
 
+void InitLightUniforms(LightUniforms* u, Shader shader);    // Get the shader locations of MAX_LIGHTS lights
+int UploadLights(LightUniforms* u, Shader shader, const Light* lights); // Send MAX_LIGHTS lights, only what changed
+
+int AddSetLight(LightSet* set, int type, Vector3 position, Vector3 target, Color color); // Add a light, returns its index
+void SelectLights(const LightSet* set, Vector3 centre, float radius, Light* out);        // Pick MAX_LIGHTS for a region
+void FreeLightSet(LightSet* set);
+
 #ifdef __cplusplus
 }
 #endif
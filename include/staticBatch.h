@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file staticBatch.h
+ * @brief Static primitives merged into a few meshes
+ *
+ * Static geoms don't move, so their boxes, spheres, cylinders and
+ * capsules can be transformed once into world space and merged with
+ * others using the same texture. Each geom's tint goes into its vertex
+ * colours and its uv scale into its texture coordinates. Batches are
+ * also split by a coarse grid so the frustum can still cull them.
+ */
+
+#ifndef STATICBATCH_H
+#define STATICBATCH_H
+
+#include <stdbool.h>
+#include "raylib.h"
+
+#define STATIC_BATCH_CELL 32.0f	// size of the grid cells batches are split by
+
+/**
+ * @brief static geoms sharing a texture and a grid cell
+ */
+typedef struct StaticBatch {
+	const Texture* texture;	/**< as the geoms hold it, its id is read when drawn as it may still be loading */
+	int cell[3];
+	Mesh mesh;			/**< world space, unindexed, with vertex colours */
+	float aabb[6];		/**< minx maxx miny maxy minz maxz, as dGeomGetAABB */
+	int geoms;			/**< how many geoms were merged into it */
+} StaticBatch;
+
+/**
+ * @brief the graphics context's baked statics
+ */
+typedef struct StaticBatches {
+	StaticBatch* batches;
+	int count;
+	int capacity;
+	bool baked;			/**< BakeStaticRenderBatches has been called */
+	unsigned staticVersion;	/**< the statics list's version when they were baked */
+} StaticBatches;
+
+void FreeStaticBatches(StaticBatches* sb);
+
+#endif // STATICBATCH_H
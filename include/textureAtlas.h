@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file textureAtlas.h
+ * @brief Small textures packed into a few big pages
+ *
+ * The framework's instanced batches are keyed by mesh and texture, so a
+ * scene of boxes with two textures, spheres with three and so on makes a
+ * draw call for every pairing. Packed into an atlas page they all share
+ * one texture and a mesh is one draw call whatever it is textured with.
+ *
+ * Each packed texture gets a region of a page, numbered so instances can
+ * say which one they use. The instancing shader looks the region up and
+ * wraps texture coordinates inside it, so uv scales above 1 still tile.
+ * A gutter copied from the opposite edges surrounds each region so
+ * filtering at the seams picks up the texels tiling would.
+ */
+
+#ifndef TEXTUREATLAS_H
+#define TEXTUREATLAS_H
+
+#include <stdbool.h>
+#include "raylib.h"
+
+#define ATLAS_MAX_PAGES 4
+#define ATLAS_MAX_REGIONS 64	// must match atlasRegions in data/simpleLightInstanced.vs
+#define ATLAS_GUTTER 4			// texels around each region
+#define ATLAS_PAGE_SIZE 2048
+
+/**
+ * @brief what to bind for a texture and where in it to look
+ */
+typedef struct AtlasRegion {
+	unsigned int textureId;	/**< the page it was packed into, or the texture itself */
+	int index;				/**< its region, 0 for the whole texture */
+} AtlasRegion;
+
+/**
+ * @brief one row of regions on a page, as tall as the first put in it
+ */
+typedef struct AtlasShelf {
+	int y;
+	int height;
+	int used;				/**< width taken so far */
+} AtlasShelf;
+
+/**
+ * @brief one page texture and the shelves packed into it
+ */
+typedef struct AtlasPage {
+	Texture texture;
+	AtlasShelf* shelves;
+	int shelfCount;
+	int shelfCapacity;
+	int top;				/**< the height the shelves take up */
+} AtlasPage;
+
+/**
+ * @brief a texture that was packed, keyed by the pointer its users hold
+ */
+typedef struct AtlasEntry {
+	const Texture* texture;
+	int page;
+} AtlasEntry;
+
+/**
+ * @brief the pages, what is packed in them and where
+ */
+typedef struct TextureAtlas {
+	bool upload;			/**< false for recording graphics, nothing touches the GPU */
+	int pageSize;
+	AtlasPage pages[ATLAS_MAX_PAGES];
+	int pageCount;
+	AtlasEntry entries[ATLAS_MAX_REGIONS - 1];	/**< entry i is region i + 1 */
+	int count;
+	float regions[ATLAS_MAX_REGIONS][4];	/**< uv offset and size of each region, as the shader takes them */
+	int version;			/**< changes each time a texture is packed */
+} TextureAtlas;
+
+void InitTextureAtlas(TextureAtlas* atlas, int pageSize, bool upload);
+void FreeTextureAtlas(TextureAtlas* atlas);
+bool AtlasReserve(TextureAtlas* atlas, const Texture* texture, int width, int height);
+bool AtlasAddImage(TextureAtlas* atlas, const Texture* texture, Image image);
+AtlasRegion AtlasFind(const TextureAtlas* atlas, const Texture* texture);
+
+#endif // TEXTUREATLAS_H
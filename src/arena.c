@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file arena.c
+ * @brief Chunked bump allocator released all at once
+ *
+ * Short lived worlds (training episodes, tests) create and destroy whole
+ * physics contexts constantly, with the framework's memory in an arena
+ * that costs a handful of frees rather than one per object.
+ *
+ * @author Chris Camacho (codifies - http://bedroomcoders.co.uk/)
+ * @date 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "arena.h"
+
+#define ARENA_ALIGN 16
+
+struct ArenaChunk {
+	ArenaChunk* next;
+	size_t size;		/**< usable bytes after the header */
+	size_t offset;		/**< next free byte */
+};
+
+// header rounded up so the first allocation is aligned
+#define CHUNK_HEADER ((sizeof(ArenaChunk) + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1))
+
+/**
+ * @brief prepare an empty arena, no memory is allocated until first use
+ *
+ * @param arena the arena to initialise
+ * @param name a name to use when reporting usage
+ * @param chunkSize how much to allocate from the heap at once
+ */
+void ArenaInit(Arena* arena, const char* name, size_t chunkSize)
+{
+	arena->name = name;
+	arena->chunkSize = chunkSize;
+	arena->chunks = NULL;
+	arena->used = 0;
+	arena->reserved = 0;
+}
+
+/**
+ * @brief allocate from the arena
+ *
+ * The memory is 16 byte aligned and uninitialised, it stays valid until
+ * the arena is freed
+ *
+ * @param arena the arena
+ * @param size number of bytes wanted
+ * @return the allocation
+ */
+void* ArenaAlloc(Arena* arena, size_t size)
+{
+	size = (size + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+
+	ArenaChunk* chunk = arena->chunks;
+	if (!chunk || chunk->offset + size > chunk->size) {
+		size_t chunkSize = size > arena->chunkSize ? size : arena->chunkSize;
+		chunk = malloc(CHUNK_HEADER + chunkSize);
+		if (!chunk) {
+			printf("Couldn't allocate memory for the %s arena\n", arena->name);
+			exit(-1);
+		}
+		chunk->size = chunkSize;
+		chunk->offset = 0;
+		// an oversized one off goes behind the current chunk so
+		// the space left in that can still be used
+		if (arena->chunks && chunkSize > arena->chunkSize) {
+			chunk->next = arena->chunks->next;
+			arena->chunks->next = chunk;
+		} else {
+			chunk->next = arena->chunks;
+			arena->chunks = chunk;
+		}
+		arena->reserved += chunkSize;
+	}
+
+	void* p = (char*)chunk + CHUNK_HEADER + chunk->offset;
+	chunk->offset += size;
+	arena->used += size;
+	return p;
+}
+
+/**
+ * @brief release everything allocated from the arena
+ *
+ * The arena can be used again afterwards
+ *
+ * @param arena the arena to release
+ */
+void ArenaFree(Arena* arena)
+{
+	ArenaChunk* chunk = arena->chunks;
+	while (chunk) {
+		ArenaChunk* next = chunk->next;
+		free(chunk);
+		chunk = next;
+	}
+	arena->chunks = NULL;
+	arena->used = 0;
+	arena->reserved = 0;
+}
+
+/**
+ * @brief print how much of an arena is in use
+ *
+ * @param arena the arena to report on
+ */
+void ArenaPrintUsage(Arena* arena)
+{
+	printf("%-10s used %8zu bytes  reserved %8zu bytes\n",
+		arena->name, arena->used, arena->reserved);
+}
@@ -0,0 +1,392 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file assetLoader.c
+ * @brief Textures registered by name and loaded when first used
+ *
+ * One worker thread, started by the first texture asked for, takes
+ * textures off a queue and decodes them. Only the worker touches an
+ * entry's state and image once it is queued, and only under the lock,
+ * everything else about an entry belongs to the main thread. Entries
+ * are allocated individually so the pointers handed out never move.
+ *
+ * @author Chris Camacho (codifies - http://bedroomcoders.co.uk/)
+ * @date 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "assetLoader.h"
+#include "rlgl.h"
+
+#define ASSET_GROW 16
+
+enum { TEXTURE_QUEUED, TEXTURE_DECODED, TEXTURE_TAKEN };
+
+typedef struct LazyTexture {
+	Texture texture;			// first, this is what UseTexture hands out
+	char* name;
+	char* path;					// NULL if generated
+	Image (*generate)(void);
+	bool requested;				// main thread, UseTexture has been called
+	bool ready;					// main thread, uploaded or given up on
+	bool uploaded;				// main thread, texture is ours to unload
+	int state;					// under the lock once queued
+	Image image;				// under the lock, decoded and waiting for upload
+	struct LazyTexture* next;	// under the lock, the job queue
+} LazyTexture;
+
+struct AssetLoader {
+	bool upload;				// false for recording graphics, nothing touches the GPU
+	LazyTexture** textures;
+	int textureCount;
+	int textureCapacity;
+	int inFlight;				// main thread, requested but not yet uploaded
+	TextureAtlas* atlas;		// main thread, NULL or where textures are packed
+
+	pthread_mutex_t lock;
+	pthread_cond_t wake;		// the worker waits on this for jobs
+	pthread_cond_t done;		// WaitForAssets waits on this for decodes
+	pthread_t worker;
+	bool started;
+	bool quit;
+	LazyTexture* jobs;
+	LazyTexture* lastJob;
+	int decoded;				// decoded and not yet taken for upload
+};
+
+static void* loaderRealloc(void* ptr, size_t size)
+{
+	void* p = RL_REALLOC(ptr, size);
+	if (!p) {
+		printf("Couldn't allocate memory for asset loader\n");
+		exit(-1);
+	}
+	return p;
+}
+
+static char* copyString(const char* s)
+{
+	if (!s) return NULL;
+	char* p = loaderRealloc(NULL, strlen(s) + 1);
+	strcpy(p, s);
+	return p;
+}
+
+/**
+ * @brief an empty loader
+ *
+ * @param upload false for a loader that never touches the GPU, its
+ * textures are ready straight away with made up ids,
+ * CreateRecordingGraphics uses one
+ * @return the loader, free it with FreeAssetLoader
+ */
+AssetLoader* CreateAssetLoader(bool upload)
+{
+	AssetLoader* al = loaderRealloc(NULL, sizeof(AssetLoader));
+	memset(al, 0, sizeof(*al));
+	al->upload = upload;
+	pthread_mutex_init(&al->lock, NULL);
+	pthread_cond_init(&al->wake, NULL);
+	pthread_cond_init(&al->done, NULL);
+	return al;
+}
+
+static void* assetWorker(void* arg)
+{
+	AssetLoader* al = arg;
+	pthread_mutex_lock(&al->lock);
+	for (;;) {
+		while (!al->jobs && !al->quit) pthread_cond_wait(&al->wake, &al->lock);
+		if (al->quit) break;
+
+		LazyTexture* t = al->jobs;
+		al->jobs = t->next;
+		if (!al->jobs) al->lastJob = NULL;
+		pthread_mutex_unlock(&al->lock);
+
+		// path and generate never change once registered
+		Image img = t->path ? LoadImage(t->path) : t->generate();
+
+		pthread_mutex_lock(&al->lock);
+		t->image = img;
+		t->state = TEXTURE_DECODED;
+		al->decoded++;
+		pthread_cond_signal(&al->done);
+	}
+	pthread_mutex_unlock(&al->lock);
+	return NULL;
+}
+
+/**
+ * @brief stop the worker and unload everything that was loaded
+ *
+ * Pointers from UseTexture are no longer valid.
+ */
+void FreeAssetLoader(AssetLoader* al)
+{
+	if (!al) return;
+	if (al->started) {
+		pthread_mutex_lock(&al->lock);
+		al->quit = true;
+		pthread_cond_broadcast(&al->wake);
+		pthread_mutex_unlock(&al->lock);
+		pthread_join(al->worker, NULL);
+	}
+
+	// the worker has gone, nothing needs the lock now
+	for (int i = 0; i < al->textureCount; i++) {
+		LazyTexture* t = al->textures[i];
+		if (t->uploaded) UnloadTexture(t->texture);
+		if (t->requested && !t->ready && t->state == TEXTURE_DECODED) UnloadImage(t->image);
+		RL_FREE(t->name);
+		RL_FREE(t->path);
+		RL_FREE(t);
+	}
+	RL_FREE(al->textures);
+	pthread_cond_destroy(&al->done);
+	pthread_cond_destroy(&al->wake);
+	pthread_mutex_destroy(&al->lock);
+	RL_FREE(al);
+}
+
+/**
+ * @brief pack textures into an atlas as they arrive
+ *
+ * Textures that have already arrived aren't packed, set it before using
+ * any. A loader that doesn't upload gives every texture 256x256 of it.
+ *
+ * @param al the loader
+ * @param atlas the atlas, it must outlive the loader or be unset first,
+ * NULL to stop packing
+ */
+void SetAssetAtlas(AssetLoader* al, TextureAtlas* atlas)
+{
+	al->atlas = atlas;
+}
+
+/**
+ * @brief look up a texture by the name it was registered with
+ *
+ * @return its handle, id 0 if there isn't one
+ */
+TextureHandle FindTexture(AssetLoader* al, const char* name)
+{
+	for (int i = 0; i < al->textureCount; i++) {
+		if (strcmp(al->textures[i]->name, name) == 0) return (TextureHandle){ i + 1 };
+	}
+	return (TextureHandle){ 0 };
+}
+
+/**
+ * @brief which registered texture a pointer from UseTexture belongs to
+ *
+ * Nothing is loaded, so it is safe for asking about textures that may
+ * never have been used.
+ *
+ * @return its handle, id 0 if it isn't one of this loader's
+ */
+TextureHandle TextureHandleOf(AssetLoader* al, const Texture* texture)
+{
+	for (int i = 0; i < al->textureCount; i++) {
+		if (&al->textures[i]->texture == texture) return (TextureHandle){ i + 1 };
+	}
+	return (TextureHandle){ 0 };
+}
+
+static TextureHandle addTexture(AssetLoader* al, const char* name, const char* path, Image (*generate)(void))
+{
+	TextureHandle h = FindTexture(al, name);
+	if (h.id) return h;
+
+	if (al->textureCount == al->textureCapacity) {
+		al->textureCapacity = al->textureCapacity ? al->textureCapacity * 2 : ASSET_GROW;
+		al->textures = loaderRealloc(al->textures, al->textureCapacity * sizeof(LazyTexture*));
+	}
+	LazyTexture* t = loaderRealloc(NULL, sizeof(LazyTexture));
+	memset(t, 0, sizeof(*t));
+	t->name = copyString(name);
+	t->path = copyString(path);
+	t->generate = generate;
+	al->textures[al->textureCount++] = t;
+	return (TextureHandle){ al->textureCount };
+}
+
+/**
+ * @brief register an image file as a texture, nothing is loaded yet
+ *
+ * @param al the loader
+ * @param name what it is looked up by, registering a name again returns
+ * the first registration
+ * @param path the image file
+ * @return its handle
+ */
+TextureHandle RegisterTexture(AssetLoader* al, const char* name, const char* path)
+{
+	return addTexture(al, name, path, NULL);
+}
+
+/**
+ * @brief register a texture made by a function, nothing is made yet
+ *
+ * @param al the loader
+ * @param name what it is looked up by
+ * @param generate makes the image, it is called on the worker thread so
+ * it mustn't touch the GPU, GenImage functions are fine
+ * @return its handle
+ */
+TextureHandle RegisterGeneratedTexture(AssetLoader* al, const char* name, Image (*generate)(void))
+{
+	return addTexture(al, name, NULL, generate);
+}
+
+// upload a decoded image, a failed one leaves the white placeholder
+static void finishTexture(AssetLoader* al, LazyTexture* t, Image img)
+{
+	t->ready = true;
+	if (!img.data) {
+		printf("Couldn't load texture %s\n", t->path ? t->path : t->name);
+		return;
+	}
+	t->texture = LoadTextureFromImage(img);
+	t->uploaded = true;
+	if (al->atlas) AtlasAddImage(al->atlas, &t->texture, img);
+	UnloadImage(img);
+}
+
+static void requestTexture(AssetLoader* al, LazyTexture* t, int id)
+{
+	t->requested = true;
+	if (!al->upload) {
+		t->texture = (Texture){ id, 256, 256, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+		t->ready = true;
+		if (al->atlas) AtlasReserve(al->atlas, &t->texture, t->texture.width, t->texture.height);
+		return;
+	}
+	t->texture = (Texture){ rlGetTextureIdDefault(), 1, 1, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+
+	if (!al->started) {
+		al->started = pthread_create(&al->worker, NULL, assetWorker, al) == 0;
+	}
+	if (!al->started) {
+		// couldn't get a thread, load it here instead
+		finishTexture(al, t, t->path ? LoadImage(t->path) : t->generate());
+		return;
+	}
+
+	pthread_mutex_lock(&al->lock);
+	t->state = TEXTURE_QUEUED;
+	t->next = NULL;
+	if (al->lastJob) al->lastJob->next = t;
+	else al->jobs = t;
+	al->lastJob = t;
+	pthread_cond_signal(&al->wake);
+	pthread_mutex_unlock(&al->lock);
+	al->inFlight++;
+}
+
+/**
+ * @brief get a texture, the first call starts loading it
+ *
+ * Until UpdateAssetLoader has uploaded it the texture is raylib's white
+ * 1x1 one. The pointer stays the same throughout, hold on to it.
+ *
+ * @param al the loader
+ * @param h the texture
+ * @return the texture, NULL if h isn't a registered texture
+ */
+Texture* UseTexture(AssetLoader* al, TextureHandle h)
+{
+	if (h.id < 1 || h.id > al->textureCount) return NULL;
+	LazyTexture* t = al->textures[h.id - 1];
+	if (!t->requested) requestTexture(al, t, h.id);
+	return &t->texture;
+}
+
+/**
+ * @brief has a texture arrived, or failed to
+ */
+bool TextureReady(AssetLoader* al, TextureHandle h)
+{
+	if (h.id < 1 || h.id > al->textureCount) return false;
+	return al->textures[h.id - 1]->ready;
+}
+
+/**
+ * @brief upload the textures the worker has finished decoding
+ *
+ * Must be called on the main thread, DrawBodies and DrawStatics call it
+ * for the graphics context's loader.
+ *
+ * @return how many textures were uploaded
+ */
+int UpdateAssetLoader(AssetLoader* al)
+{
+	if (!al->inFlight) return 0;
+
+	pthread_mutex_lock(&al->lock);
+	int waiting = al->decoded;
+	pthread_mutex_unlock(&al->lock);
+	if (!waiting) return 0;
+
+	int uploaded = 0;
+	for (int i = 0; i < al->textureCount; i++) {
+		LazyTexture* t = al->textures[i];
+		if (!t->requested || t->ready) continue;
+
+		pthread_mutex_lock(&al->lock);
+		bool decoded = t->state == TEXTURE_DECODED;
+		Image img = t->image;
+		if (decoded) {
+			t->state = TEXTURE_TAKEN;
+			al->decoded--;
+		}
+		pthread_mutex_unlock(&al->lock);
+		if (!decoded) continue;
+
+		finishTexture(al, t, img);
+		al->inFlight--;
+		uploaded++;
+	}
+	return uploaded;
+}
+
+/**
+ * @brief wait for every texture asked for so far and upload them
+ *
+ * For a program that would rather have a loading pause than white
+ * textures popping in.
+ */
+void WaitForAssets(AssetLoader* al)
+{
+	while (al->inFlight) {
+		pthread_mutex_lock(&al->lock);
+		while (!al->decoded) pthread_cond_wait(&al->done, &al->lock);
+		pthread_mutex_unlock(&al->lock);
+		UpdateAssetLoader(al);
+	}
+}
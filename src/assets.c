@@ -0,0 +1,193 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file assets.c
+ * @brief Reference counted cache of models and cooked trimeshes
+ *
+ * There are only ever a handful of assets so each kind is kept in a
+ * plain list and looked up by walking it, entries are allocated
+ * individually so the pointers handed out never move.
+ *
+ * @author Chris Camacho (codifies - http://bedroomcoders.co.uk/)
+ * @date 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "clist.h"
+#include "assets.h"
+
+typedef struct SharedModel {
+	Model model;	// first so a Model* is also the entry
+	char* path;
+	int refs;
+} SharedModel;
+
+static clist_t* models = NULL;
+static clist_t* trimeshes = NULL;
+
+static void* assetAlloc(size_t size, const char* path)
+{
+	void* p = RL_CALLOC(1, size);
+	if (!p) {
+		printf("Couldn't allocate memory for asset %s\n", path);
+		exit(-1);
+	}
+	return p;
+}
+
+static char* copyPath(const char* path)
+{
+	char* p = assetAlloc(strlen(path) + 1, path);
+	strcpy(p, path);
+	return p;
+}
+
+// the lists are created on first use and freed when they empty again
+static void dropIfEmpty(clist_t** list)
+{
+	if (*list && clistIsEmpty(*list)) clistFreeList(list);
+}
+
+/**
+ * @brief load a model, or share one already loaded from the same path
+ *
+ * @param path the model file
+ * @return the shared model, don't UnloadModel it, use UnloadSharedModel
+ */
+Model* LoadSharedModel(const char* path)
+{
+	if (!models) models = clistCreateList();
+
+	for (cnode_t* node = models->head; node; node = node->next) {
+		SharedModel* sm = node->data;
+		if (strcmp(sm->path, path) == 0) {
+			sm->refs++;
+			return &sm->model;
+		}
+	}
+
+	SharedModel* sm = assetAlloc(sizeof(SharedModel), path);
+	sm->model = LoadModel(path);
+	sm->path = copyPath(path);
+	sm->refs = 1;
+	clistAddNode(models, sm);
+	return &sm->model;
+}
+
+/**
+ * @brief give up a reference to a shared model
+ *
+ * The model is unloaded once nothing else is using it
+ *
+ * @param model a model from LoadSharedModel
+ */
+void UnloadSharedModel(Model* model)
+{
+	cnode_t* node = models ? clistFindNode(models, model) : NULL;
+	if (!node) {
+		printf("UnloadSharedModel: model wasn't from LoadSharedModel\n");
+		return;
+	}
+	SharedModel* sm = node->data;
+	if (--sm->refs > 0) return;
+
+	UnloadModel(sm->model);
+	clistDeleteNode(models, &node);
+	RL_FREE(sm->path);
+	RL_FREE(sm);
+	dropIfEmpty(&models);
+}
+
+/**
+ * @brief get cooked collision data for a mesh
+ *
+ * The first call for a mesh builds the index array and ODE's collision
+ * tree, later calls with the same mesh (or a copy of the Mesh struct,
+ * Models are often passed by value) just add a reference.
+ *
+ * @param mesh the mesh to collide with, its vertices must stay loaded
+ * @return the shared trimesh, release it with ReleaseTrimesh
+ */
+SharedTrimesh* AcquireTrimesh(Mesh mesh)
+{
+	if (!trimeshes) trimeshes = clistCreateList();
+
+	for (cnode_t* node = trimeshes->head; node; node = node->next) {
+		SharedTrimesh* tm = node->data;
+		if (tm->vertices == mesh.vertices) {
+			tm->refs++;
+			return tm;
+		}
+	}
+
+	int nV = mesh.vertexCount;
+	SharedTrimesh* tm = assetAlloc(sizeof(SharedTrimesh), "trimesh");
+	tm->vertices = mesh.vertices;
+	tm->indices = assetAlloc(nV * sizeof(int), "trimesh");
+	for (int i = 0; i < nV; i++) tm->indices[i] = i;
+	tm->indexCount = nV;
+
+	tm->triData = dGeomTriMeshDataCreate();
+	dGeomTriMeshDataBuildSingle(tm->triData, mesh.vertices, 3 * sizeof(float), nV,
+	                            tm->indices, nV, 3 * sizeof(int));
+	tm->refs = 1;
+	clistAddNode(trimeshes, tm);
+	return tm;
+}
+
+/**
+ * @brief give up a reference to cooked trimesh data
+ *
+ * Once the last geom using it has gone the ODE data and indices are freed
+ *
+ * @param trimesh the shared trimesh from AcquireTrimesh
+ */
+void ReleaseTrimesh(SharedTrimesh* trimesh)
+{
+	if (--trimesh->refs > 0) return;
+
+	dGeomTriMeshDataDestroy(trimesh->triData);
+	RL_FREE(trimesh->indices);
+	clistDeleteNodeFromData(trimeshes, trimesh);
+	RL_FREE(trimesh);
+	dropIfEmpty(&trimeshes);
+}
+
+/**
+ * @brief print what's in the cache and how many users each asset has
+ */
+void PrintAssetCache(void)
+{
+	for (cnode_t* node = models ? models->head : NULL; node; node = node->next) {
+		SharedModel* sm = node->data;
+		printf("model    %3i refs  %s\n", sm->refs, sm->path);
+	}
+	for (cnode_t* node = trimeshes ? trimeshes->head : NULL; node; node = node->next) {
+		SharedTrimesh* tm = node->data;
+		printf("trimesh  %3i refs  %p\n", tm->refs, (void*)tm->vertices);
+	}
+}
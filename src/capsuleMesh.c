@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file capsuleMesh.c
+ * @brief Capsule meshes shared by every capsule geom of a similar shape
+ *
+ * The mesh is a lathe along local z, the same axis ODE uses. Rows of
+ * vertices run from the bottom pole to the top one, the last row of the
+ * lower cap and the first of the upper cap both sit on the equator so
+ * the quads between them are the cylinder. Texture v follows the
+ * distance along the surface so a texture isn't squashed onto the caps.
+ *
+ * @author Chris Camacho (codifies - http://bedroomcoders.co.uk/)
+ * @date 2026
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "capsuleMesh.h"
+
+// slices around the axis and rings from the equator to each pole, per level
+static const int capsuleSlices[LOD_LEVELS] = { 24, 16, 10, 6 };
+static const int capsuleRings[LOD_LEVELS] = { 8, 5, 3, 2 };
+
+/**
+ * @brief generate a capsule mesh along z, uploaded if there is a window
+ *
+ * @param radius radius of the cylinder and both caps
+ * @param length length of the cylinder between the cap centres
+ * @param slices vertices around the axis
+ * @param rings rings on each cap from the equator to the pole
+ * @return the mesh, unload with UnloadMesh
+ */
+Mesh GenMeshCapsule(float radius, float length, int slices, int rings)
+{
+	Mesh mesh = { 0 };
+	int rows = (rings + 1) * 2;
+	int cols = slices + 1;		// the seam is doubled for its uvs
+
+	mesh.vertexCount = rows * cols;
+	mesh.triangleCount = (rows - 1) * slices * 2;
+	mesh.vertices = RL_CALLOC(mesh.vertexCount * 3, sizeof(float));
+	mesh.normals = RL_CALLOC(mesh.vertexCount * 3, sizeof(float));
+	mesh.texcoords = RL_CALLOC(mesh.vertexCount * 2, sizeof(float));
+	mesh.indices = RL_CALLOC(mesh.triangleCount * 3, sizeof(unsigned short));
+
+	float capArc = PI * 0.5f * radius;
+	float total = capArc * 2 + length;
+	int v = 0;
+	for (int row = 0; row < rows; row++) {
+		int top = row > rings;
+		int ring = top ? row - rings - 1 : row;
+		// -pi/2 at the bottom pole, 0 on both equators, pi/2 at the top pole
+		float phi = PI * 0.5f * ((float)ring / rings - (top ? 0 : 1));
+		float ny = sinf(phi);
+		float across = cosf(phi);
+		float z = ny * radius + (top ? length : -length) * 0.5f;
+		float s = capArc + phi * radius + (top ? length : 0);
+
+		for (int i = 0; i < cols; i++, v++) {
+			float theta = 2 * PI * i / slices;
+			float nx = cosf(theta) * across;
+			float nz = sinf(theta) * across;
+			mesh.vertices[v*3 + 0] = nx * radius;
+			mesh.vertices[v*3 + 1] = nz * radius;
+			mesh.vertices[v*3 + 2] = z;
+			mesh.normals[v*3 + 0] = nx;
+			mesh.normals[v*3 + 1] = nz;
+			mesh.normals[v*3 + 2] = ny;
+			mesh.texcoords[v*2 + 0] = (float)i / slices;
+			mesh.texcoords[v*2 + 1] = 1.0f - s / total;
+		}
+	}
+
+	int t = 0;
+	for (int row = 0; row < rows - 1; row++) {
+		for (int i = 0; i < slices; i++) {
+			unsigned short a = (unsigned short)(row * cols + i);
+			unsigned short b = (unsigned short)(a + cols);
+			mesh.indices[t++] = a;
+			mesh.indices[t++] = a + 1;
+			mesh.indices[t++] = b;
+			mesh.indices[t++] = a + 1;
+			mesh.indices[t++] = b + 1;
+			mesh.indices[t++] = b;
+		}
+	}
+
+	if (IsWindowReady()) UploadMesh(&mesh, false);
+	return mesh;
+}
+
+/**
+ * @brief the shared mesh for a capsule, draw it scaled by the radius
+ *
+ * @param cm the graphics context's capsule meshes
+ * @param radius the capsule's radius
+ * @param length the capsule's cylinder length
+ * @param lod level of detail, 0 is the finest
+ * @return a radius 1 mesh of the nearest ratio, generating it if needed
+ */
+Mesh* GetCapsuleMesh(CapsuleMeshes* cm, float radius, float length, int lod)
+{
+	float ratio = radius > 0 ? roundf(length / radius * CAPSULE_RATIO_STEP) / CAPSULE_RATIO_STEP : 0;
+	int nearest = -1;
+	float best = INFINITY;
+	for (int i = 0; i < cm->count && best > 0; i++) {
+		float d = fabsf(cm->ratio[i] - ratio);
+		if (d < best) { best = d; nearest = i; }
+	}
+	if (best > 0 && cm->count < CAPSULE_MESHES) {
+		nearest = cm->count++;
+		cm->ratio[nearest] = ratio;
+	}
+
+	Mesh* mesh = &cm->meshes[nearest][lod];
+	if (!mesh->vertexCount) {
+		*mesh = GenMeshCapsule(1.0f, cm->ratio[nearest], capsuleSlices[lod], capsuleRings[lod]);
+	}
+	return mesh;
+}
+
+/**
+ * @brief unload every capsule mesh
+ */
+void FreeCapsuleMeshes(CapsuleMeshes* cm)
+{
+	for (int i = 0; i < cm->count; i++) {
+		for (int l = 0; l < LOD_LEVELS; l++) {
+			if (cm->meshes[i][l].vertexCount) UnloadMesh(cm->meshes[i][l]);
+		}
+	}
+	memset(cm, 0, sizeof(*cm));
+}
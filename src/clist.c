@@ -4,14 +4,19 @@
 
 
 #include <stdlib.h>
+#include <stdint.h>
 #include "clist.h"
 
+#define CLIST_PAGE_NODES 64
+#define CLIST_INDEX_MIN 64
+
 /** @brief
  *   creates a list
  *
  *   @details
  *   Allocates space for the list structure clearing the
- *   head and tail pointer ready for use.
+ *   head and tail pointer ready for use. Nodes are carved from a
+ *   small slab owned by the list rather than malloc'd one at a time.
  *
  *   @return provides a pointer to the newly created list
  */
@@ -29,6 +34,99 @@ clist_t*clistCreateList()
     }
     new->head = NULL;
     new->tail = NULL;
+    new->count = 0;
+    new->version = 0;
+    new->index = NULL;
+    new->indexSize = 0;
+    PoolInit(&new->ownPool, "list node", sizeof(cnode_t), CLIST_PAGE_NODES, NULL);
+    new->nodePool = &new->ownPool;
+    return(new);
+}
+
+/** @brief
+ *   creates a list that takes its nodes from a pool
+ *
+ *   @details
+ *   Identical to clistCreateList except nodes are taken from and returned
+ *   to nodePool instead of being individually malloc'd, several lists can
+ *   share the same pool. The pool must outlive the list.
+ *
+ *   @param [in] nodePool a pool initialised with sizeof(cnode_t) items
+ *
+ *   @return provides a pointer to the newly created list
+ */
+clist_t*clistCreateListPooled(Pool* nodePool)
+{
+    clist_t* new = clistCreateList();
+
+    new->nodePool = nodePool;
+    return(new);
+}
+
+// spread pointers over the buckets, the low bits are alignment so drop them
+static int hashPtr(clist_t* list, void* ptr)
+{
+    uint32_t h = (uint32_t)((uintptr_t)ptr >> 4) * 2654435761u;
+
+    return((int)(h >> 8) & (list->indexSize - 1));
+}
+
+static void indexAdd(clist_t* list, cnode_t* node)
+{
+    int b = hashPtr(list, node->data);
+
+    node->hashNext = list->index[b];
+    list->index[b] = node;
+}
+
+static void indexRemove(clist_t* list, cnode_t* node)
+{
+    cnode_t** link = &list->index[hashPtr(list, node->data)];
+
+    while (*link != NULL) {
+        if (*link == node) {
+            *link = node->hashNext;
+            return;
+        }
+        link = &(*link)->hashNext;
+    }
+}
+
+// (re)build the index with at least twice as many buckets as nodes
+static void indexRebuild(clist_t* list)
+{
+    int size = CLIST_INDEX_MIN;
+
+    while (size < list->count * 2) {
+        size *= 2;
+    }
+    free(list->index);
+    list->index = calloc(size, sizeof(cnode_t*));
+    if (!list->index) {
+        printf("Couldn't allocate memory for a list index\n");
+        exit(-1);
+    }
+    list->indexSize = size;
+    for (cnode_t* node = list->head; node != NULL; node = node->next) {
+        indexAdd(list, node);
+    }
+}
+
+// node allocation and bookkeeping common to add and insert
+static cnode_t* allocNode(clist_t* list, void* data)
+{
+    cnode_t* new = PoolAlloc(list->nodePool);
+
+    new->data = data;
+    new->hashNext = NULL;
+    list->count++;
+    list->version++;
+    if (list->index) {
+        if (list->count > list->indexSize) {
+            indexRebuild(list); // new node isn't linked yet, added below
+        }
+        indexAdd(list, new);
+    }
     return(new);
 }
 
@@ -46,7 +144,7 @@ clist_t*clistCreateList()
  */
 cnode_t*clistAddNode(clist_t* list, void* data)
 {
-    cnode_t* new = malloc(sizeof(cnode_t));
+    cnode_t* new = allocNode(list, data);
 
     if (!new) {
         printf("Couldn't allocate memory for a list\n");
@@ -61,7 +159,6 @@ cnode_t*clistAddNode(clist_t* list, void* data)
         list->head = new;
     }
     list->tail = new;
-    new->data  = data;
     return(new);
 }
 
@@ -82,7 +179,7 @@ cnode_t*clistAddNode(clist_t* list, void* data)
  */
 cnode_t*clistInsertNode(clist_t* list, cnode_t* node, void* data)
 {
-    cnode_t* new = malloc(sizeof(cnode_t));
+    cnode_t* new = allocNode(list, data);
 
     if (!new) {
         printf("Couldn't allocate memory for a node\n");
@@ -97,7 +194,6 @@ cnode_t*clistInsertNode(clist_t* list, cnode_t* node, void* data)
     if (list->head == node) {
         list->head = new;
     }
-    new->data = data;
     return(new);
 }
 
@@ -105,10 +201,11 @@ cnode_t*clistInsertNode(clist_t* list, cnode_t* node, void* data)
  *   search for a node in the list
  *
  *   @details
- *   brute force search for a node pointing to specific data
- *   generally you should be iterating lists and not dealing
- *   with specific nodes individually but this could come
- *   in handy
+ *   search for a node pointing to specific data, this is a
+ *   brute force search unless the list has an index (see
+ *   clistEnableIndex). Generally you should be iterating lists
+ *   and not dealing with specific nodes individually but this
+ *   could come in handy
  *
  *   @param [in] list the list you want to find the node in
  *   @param [in] ptr finds the node that points to this data
@@ -118,8 +215,20 @@ cnode_t*clistInsertNode(clist_t* list, cnode_t* node, void* data)
  */
 cnode_t*clistFindNode(clist_t* list, void* ptr)
 {
-    cnode_t* node = list->head;
+    cnode_t* node;
 
+    if (list->index) {
+        node = list->index[hashPtr(list, ptr)];
+        while (node != NULL) {
+            if (node->data == ptr) {
+                return(node);
+            }
+            node = node->hashNext;
+        }
+        return(NULL);
+    }
+
+    node = list->head;
     while (node != NULL) {
         if (node->data == ptr) {
             return(node);
@@ -159,7 +268,12 @@ void clistDeleteNode(clist_t* list, cnode_t** pnode)
     if (list->tail == node) {
         list->tail = node->prev;
     }
-    free(*pnode);
+    if (list->index) {
+        indexRemove(list, node);
+    }
+    list->count--;
+    list->version++;
+    PoolRelease(list->nodePool, *pnode);
     *pnode = 0;
 }
 
@@ -219,6 +333,28 @@ void clistEmptyList(clist_t* list)
 void clistFreeList(clist_t** list)
 {
     clistEmptyList(*list);
+    PoolFree(&(*list)->ownPool);
+    free((*list)->index);
+    free(*list);
+    *list = NULL;
+}
+
+/** @brief free a list without visiting its nodes
+ *
+ * @details
+ * for lists whose nodes come from a shared pool that is itself about to
+ * be released (or its arena freed), only the list header and index are
+ * freed. The nodes are simply forgotten so this doesn't depend on the
+ * length of the list. Don't use this on a list with its own nodes or
+ * whose pool is going to carry on being used.
+ *
+ * @param [in,out] list The address of the list pointer. It will be freed
+ * and then set to NULL.
+ */
+void clistAbandonList(clist_t** list)
+{
+    PoolFree(&(*list)->ownPool);
+    free((*list)->index);
     free(*list);
     *list = NULL;
 }
@@ -278,52 +414,84 @@ void clistIterateBackward(clist_t* list, void (*nodeFunction)(cnode_t* node))
  * sort a list
  *
  * @details
- * does a simple bubble sort on a list depending on node compare callback
+ * does a stable bottom up merge sort on a list depending on node compare
+ * callback, O(n log n) and no allocation. Nodes are relinked rather than
+ * having their data swapped so a node keeps pointing at the same data.
  *
  * @param [in] list         the list to iterate
  * @param [in] cmpFunction  the callback which should return 1 if n1 > n2
  */
 void clistSort(clist_t* list, int(*cmpFunction)(cnode_t* n1, cnode_t* n2))
 {
-    bool      hasSwapped = true;
-    cnode_t* node1, * node2;
-
-    while (hasSwapped == true) {
-        hasSwapped = false;
-        node1      = list->head;
-        while (node1 != NULL) {
-            node2 = node1->next;
-            if (node2 != NULL) {
-                if (cmpFunction(node1, node2) > 0) {
-                    void* v;
-                    v = node1->data;
-                    node1->data = node2->data;
-                    node2->data = v;
-                    hasSwapped  = true;
+    cnode_t* head = list->head;
+    int      width = 1;
+    int      merges;
+
+    if (head == NULL) {
+        return;
+    }
+
+    // merge runs of width nodes, singly linked, until one run covers the list
+    do {
+        cnode_t* p = head;
+        cnode_t* tail = NULL;
+
+        head   = NULL;
+        merges = 0;
+        while (p != NULL) {
+            cnode_t* q = p;
+            int      psize = 0, qsize = width;
+
+            merges++;
+            while (psize < width && q != NULL) {
+                psize++;
+                q = q->next;
+            }
+            while (psize > 0 || (qsize > 0 && q != NULL)) {
+                cnode_t* e;
+
+                // take from p on ties to keep the sort stable
+                if (psize == 0) {
+                    e = q; q = q->next; qsize--;
+                } else if (qsize == 0 || q == NULL || cmpFunction(p, q) <= 0) {
+                    e = p; p = p->next; psize--;
+                } else {
+                    e = q; q = q->next; qsize--;
                 }
+                if (tail != NULL) {
+                    tail->next = e;
+                } else {
+                    head = e;
+                }
+                tail = e;
             }
-            node1 = node1->next;
+            p = q;
         }
+        tail->next = NULL;
+        width *= 2;
+    } while (merges > 1);
+
+    // restore the back links
+    cnode_t* prev = NULL;
+    for (cnode_t* node = head; node != NULL; node = node->next) {
+        node->prev = prev;
+        prev = node;
     }
+    list->head = head;
+    list->tail = prev;
 }
 
 /** @brief number of items in list
  *
- *   @details This iterrates the list counting all the nodes
+ *   @details The count is maintained as nodes are added and
+ *   deleted so this doesn't need to walk the list
  *
  *   @param [in] list the list you wish to total
  *   @result [out] the number of nodes in the list
  */
 int clistTotal(clist_t* list)
 {
-    int      c    = 0;
-    cnode_t* node = list->head;
-
-    while (node != NULL) {
-        c++;
-        node = node->next;
-    }
-    return(c);
+    return(list->count);
 }
 
 /** @brief is list empty?
@@ -337,3 +505,21 @@ int clistIsEmpty(clist_t* list)
 {
     return(!list->head);
 }
+
+/** @brief index a list by data pointer
+ *
+ *   @details after this clistFindNode and clistDeleteNodeFromData are
+ *   hash lookups instead of walking the list. The index is kept up to
+ *   date as nodes are added and deleted, it costs a little on each add
+ *   and delete so only enable it on lists you search. Sorting doesn't
+ *   affect the index.
+ *
+ *   @param [in] list the list to index
+ */
+void clistEnableIndex(clist_t* list)
+{
+    if (list->index) {
+        return;
+    }
+    indexRebuild(list);
+}
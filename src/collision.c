@@ -101,6 +101,7 @@ void nearCallback(void *data, dGeomID o1, dGeomID o2)
 			//contact[i].surface.bounce_vel = 0.001;
 
             dJointID c = dJointCreateContact(ctx->world, ctx->contactgroup, &contact[i]);
+            ctx->memStats.contactJoints++;
             dJointAttach(c, b1, b2);
         }
     }
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file entityStore.c
+ * @brief Dense entity storage addressed by generational handles
+ *
+ * The framework used to keep every entity in a linked list, each one a
+ * separate allocation with its own list node. Entities are now carved
+ * out of pages and a packed array of body ids is kept alongside, so
+ * drawing or updating every entity is a straight walk over memory.
+ *
+ * @author Chris Camacho (codifies - http://bedroomcoders.co.uk/)
+ * @date 2026
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "raylibODE.h"
+#include "entityStore.h"
+
+static void* storeRealloc(void* ptr, size_t size)
+{
+	void* p = RL_REALLOC(ptr, size);
+	if (!p) {
+		printf("Couldn't allocate memory for the entity store\n");
+		exit(-1);
+	}
+	return p;
+}
+
+/**
+ * @brief prepare an empty store
+ *
+ * @param es the store to initialise
+ * @param arena take entity pages from this arena, or NULL to use the heap
+ */
+void EntityStoreInit(EntityStore* es, Arena* arena)
+{
+	memset(es, 0, sizeof(EntityStore));
+	HandleTableInit(&es->table);
+	es->arena = arena;
+}
+
+/**
+ * @brief release all the memory used by a store
+ *
+ * @note this only releases the store, any ODE bodies the entities refer
+ * to must already have been destroyed
+ *
+ * @param es the store to release
+ */
+void EntityStoreFree(EntityStore* es)
+{
+	for (int i = 0; !es->arena && i < es->pageCount; i++) {
+		RL_FREE(es->pages[i]);
+	}
+	RL_FREE(es->pages);
+	RL_FREE(es->bodies);
+	HandleTableFree(&es->table);
+	memset(es, 0, sizeof(EntityStore));
+}
+
+// add another page of slots, only the small per slot arrays are moved
+static void addPage(EntityStore* es)
+{
+	HandleTableGrowSlots(&es->table, (es->pageCount + 1) * ENTITY_PAGE_SIZE);
+
+	es->pages = storeRealloc(es->pages, (es->pageCount + 1) * sizeof(entity*));
+	if (es->arena) {
+		es->pages[es->pageCount] = ArenaAlloc(es->arena, ENTITY_PAGE_SIZE * sizeof(entity));
+	} else {
+		es->pages[es->pageCount] = storeRealloc(NULL, ENTITY_PAGE_SIZE * sizeof(entity));
+	}
+	es->pageCount++;
+}
+
+// grow the dense arrays, the table's handles and our bodies stay in step
+static void growDense(EntityStore* es, int capacity)
+{
+	HandleTableGrowDense(&es->table, capacity);
+	es->bodies = storeRealloc(es->bodies, es->table.capacity * sizeof(dBodyID));
+}
+
+static entity* slotEntity(EntityStore* es, uint32_t h)
+{
+	uint32_t slot = h & HANDLE_INDEX_MASK;
+	return &es->pages[slot / ENTITY_PAGE_SIZE][slot % ENTITY_PAGE_SIZE];
+}
+
+/**
+ * @brief make room for more entities up front
+ *
+ * @param es the store
+ * @param count how many more entities will be added
+ */
+void EntityStoreReserve(EntityStore* es, int count)
+{
+	// released slots are reused first, then fresh ones
+	while (HandleTableFreeSlots(&es->table) < count) {
+		addPage(es);
+	}
+
+	int need = es->table.count + count;
+	if (need > es->table.capacity) growDense(es, need);
+}
+
+/**
+ * @brief take a new entity from the store
+ *
+ * The entity is cleared, given a handle and appended to the dense arrays
+ *
+ * @param es the store
+ * @param body the ODE body the entity wraps
+ * @return the new entity, this pointer remains valid until it is removed
+ */
+entity* EntityStoreAdd(EntityStore* es, dBodyID body)
+{
+	if (HandleTableFreeSlots(&es->table) == 0) addPage(es);
+	if (es->table.count == es->table.capacity) {
+		growDense(es, es->table.capacity ? es->table.capacity * 2 : ENTITY_PAGE_SIZE);
+	}
+
+	es->bodies[es->table.count] = body;
+	EntityHandle h = HandleTableAdd(&es->table);
+
+	entity* ent = slotEntity(es, h);
+	memset(ent, 0, sizeof(entity));
+	ent->body = body;
+	ent->handle = h;
+	return ent;
+}
+
+/**
+ * @brief return an entity to the store
+ *
+ * The last entity in the dense arrays is moved into the hole left behind
+ * and the slot's generation is bumped so stale handles stop resolving.
+ *
+ * @param es the store
+ * @param ent the entity to remove
+ */
+void EntityStoreRemove(EntityStore* es, entity* ent)
+{
+	int d = HandleTableRemove(&es->table, ent->handle);
+	if (d < 0) return;
+	if (d != es->table.count) es->bodies[d] = es->bodies[es->table.count];
+
+	ent->handle = ENTITY_HANDLE_NONE;
+	ent->body = 0;
+}
+
+/**
+ * @brief look up an entity from its handle
+ *
+ * @param es the store
+ * @param h the handle
+ * @return the entity or NULL if the handle is stale or invalid
+ */
+entity* EntityStoreGet(EntityStore* es, EntityHandle h)
+{
+	if (HandleTableFind(&es->table, h) < 0) return NULL;
+	return slotEntity(es, h);
+}
+
+/**
+ * @brief get the entity at a position in the dense array
+ *
+ * @param es the store
+ * @param i index from 0 to table.count-1
+ * @return the entity
+ */
+entity* EntityStoreAt(EntityStore* es, int i)
+{
+	return slotEntity(es, es->table.handles[i]);
+}
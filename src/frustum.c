@@ -0,0 +1,222 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file frustum.c
+ * @brief Camera frustum culling of axis aligned boxes
+ *
+ * Planes are pulled straight out of the view projection matrix. A box
+ * is culled when it is wholly behind any one plane, its centre's
+ * distance is compared with its extent projected onto the plane normal.
+ * Like most frustum tests this is conservative, a box near a corner of
+ * the frustum can be kept when it is actually just outside.
+ *
+ * @author Chris Camacho (codifies - http://bedroomcoders.co.uk/)
+ * @date 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+
+#include "raylib.h"
+#include "raymath.h"
+#include "frustum.h"
+
+#define CULL_GROW 256
+#define CULL_HUGE 1e30f		// extent given to unbounded boxes (planes)
+
+static void* cullRealloc(void* ptr, size_t size)
+{
+	void* p = RL_REALLOC(ptr, size);
+	if (!p) {
+		printf("Couldn't allocate memory for culling\n");
+		exit(-1);
+	}
+	return p;
+}
+
+static Vector4 normalisePlane(float x, float y, float z, float w)
+{
+	float len = sqrtf(x*x + y*y + z*z);
+	if (len > 0) {
+		x /= len; y /= len; z /= len; w /= len;
+	}
+	return (Vector4){ x, y, z, w };
+}
+
+/**
+ * @brief extract the frustum planes from a view projection matrix
+ *
+ * @param viewProjection MatrixMultiply(view, projection), as raylib
+ * orders them
+ */
+Frustum FrustumFromMatrix(Matrix viewProjection)
+{
+	Matrix m = viewProjection;
+	Frustum f;
+
+	// rows of the matrix as it is applied to column vectors
+	f.planes[0] = normalisePlane(m.m3 + m.m0, m.m7 + m.m4, m.m11 + m.m8, m.m15 + m.m12);	// left
+	f.planes[1] = normalisePlane(m.m3 - m.m0, m.m7 - m.m4, m.m11 - m.m8, m.m15 - m.m12);	// right
+	f.planes[2] = normalisePlane(m.m3 + m.m1, m.m7 + m.m5, m.m11 + m.m9, m.m15 + m.m13);	// bottom
+	f.planes[3] = normalisePlane(m.m3 - m.m1, m.m7 - m.m5, m.m11 - m.m9, m.m15 - m.m13);	// top
+	f.planes[4] = normalisePlane(m.m3 + m.m2, m.m7 + m.m6, m.m11 + m.m10, m.m15 + m.m14);	// near
+	f.planes[5] = normalisePlane(m.m3 - m.m2, m.m7 - m.m6, m.m11 - m.m10, m.m15 - m.m14);	// far
+	return f;
+}
+
+/**
+ * @brief the frustum of a perspective camera, without needing a window
+ *
+ * @param camera the camera, fovy is in degrees
+ * @param aspect width over height of the view
+ * @param nearPlane distance to the near clip plane
+ * @param farPlane distance to the far clip plane
+ */
+Frustum FrustumFromCamera(Camera camera, float aspect, float nearPlane, float farPlane)
+{
+	Matrix view = MatrixLookAt(camera.position, camera.target, camera.up);
+	Matrix proj = MatrixPerspective(camera.fovy * DEG2RAD, aspect, nearPlane, farPlane);
+	return FrustumFromMatrix(MatrixMultiply(view, proj));
+}
+
+// centre and half extent along one axis, unbounded axes get a huge extent
+static void boxAxis(float lo, float hi, float* centre, float* extent)
+{
+	if (lo < -CULL_HUGE || hi > CULL_HUGE) {
+		*centre = 0;
+		*extent = CULL_HUGE;
+	} else {
+		*centre = (lo + hi) * 0.5f;
+		*extent = (hi - lo) * 0.5f;
+	}
+}
+
+/**
+ * @brief test a single box against a frustum
+ *
+ * @param f the frustum
+ * @param aabb minx, maxx, miny, maxy, minz, maxz as dGeomGetAABB gives
+ * @return false if the box is certainly outside
+ */
+bool FrustumTestBox(const Frustum* f, const float* aabb)
+{
+	float c[3], e[3];
+	for (int a = 0; a < 3; a++) boxAxis(aabb[a*2], aabb[a*2 + 1], &c[a], &e[a]);
+
+	for (int p = 0; p < 6; p++) {
+		Vector4 pl = f->planes[p];
+		float dist = pl.x*c[0] + pl.y*c[1] + pl.z*c[2] + pl.w;
+		float r = fabsf(pl.x)*e[0] + fabsf(pl.y)*e[1] + fabsf(pl.z)*e[2];
+		if (dist + r < 0) return false;
+	}
+	return true;
+}
+
+/**
+ * @brief empty a cull set, keeping its storage
+ */
+void CullSetClear(CullSet* cs)
+{
+	cs->count = 0;
+}
+
+/**
+ * @brief add a box to a cull set
+ *
+ * @param cs the cull set
+ * @param item what the box belongs to, handed back in cs->items
+ * @param aabb minx, maxx, miny, maxy, minz, maxz as dGeomGetAABB gives
+ */
+void CullSetAdd(CullSet* cs, void* item, const float* aabb)
+{
+	if (cs->count == cs->capacity) {
+		cs->capacity += CULL_GROW;
+		cs->items = cullRealloc(cs->items, cs->capacity * sizeof(void*));
+		for (int a = 0; a < 3; a++) {
+			cs->centre[a] = cullRealloc(cs->centre[a], cs->capacity * sizeof(float));
+			cs->extent[a] = cullRealloc(cs->extent[a], cs->capacity * sizeof(float));
+		}
+		cs->visible = cullRealloc(cs->visible, cs->capacity);
+	}
+
+	int i = cs->count++;
+	cs->items[i] = item;
+	for (int a = 0; a < 3; a++) {
+		boxAxis(aabb[a*2], aabb[a*2 + 1], &cs->centre[a][i], &cs->extent[a][i]);
+	}
+}
+
+/**
+ * @brief flag which boxes in the set are inside the frustum
+ *
+ * One pass over all the boxes per plane, each pass is a straight run
+ * over the arrays.
+ *
+ * @return how many boxes are visible
+ */
+int CullSetTest(CullSet* cs, const Frustum* f)
+{
+	int n = cs->count;
+	const float* cx = cs->centre[0];
+	const float* cy = cs->centre[1];
+	const float* cz = cs->centre[2];
+	const float* ex = cs->extent[0];
+	const float* ey = cs->extent[1];
+	const float* ez = cs->extent[2];
+	unsigned char* visible = cs->visible;
+
+	for (int i = 0; i < n; i++) visible[i] = 1;
+
+	for (int p = 0; p < 6; p++) {
+		Vector4 pl = f->planes[p];
+		float ax = fabsf(pl.x), ay = fabsf(pl.y), az = fabsf(pl.z);
+		for (int i = 0; i < n; i++) {
+			float dist = pl.x*cx[i] + pl.y*cy[i] + pl.z*cz[i] + pl.w;
+			float r = ax*ex[i] + ay*ey[i] + az*ez[i];
+			visible[i] &= (dist + r >= 0);
+		}
+	}
+
+	int count = 0;
+	for (int i = 0; i < n; i++) count += visible[i];
+	return count;
+}
+
+/**
+ * @brief release a cull set's storage
+ */
+void FreeCullSet(CullSet* cs)
+{
+	RL_FREE(cs->items);
+	for (int a = 0; a < 3; a++) {
+		RL_FREE(cs->centre[a]);
+		RL_FREE(cs->extent[a]);
+	}
+	RL_FREE(cs->visible);
+	cs->items = NULL;
+	cs->visible = NULL;
+	for (int a = 0; a < 3; a++) cs->centre[a] = cs->extent[a] = NULL;
+	cs->count = cs->capacity = 0;
+}
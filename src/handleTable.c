@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+/**
+ * @file handleTable.c
+ * @brief Generational handles over a packed array
+ *
+ * The entity store and the joint registry each grew their own copy of
+ * this, now both keep a table and only manage their payload arrays.
+ *
+ * @author Chris Camacho (codifies - http://bedroomcoders.co.uk/)
+ * @date 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "raylib.h"
+#include "handleTable.h"
+
+static void* tableRealloc(void* ptr, size_t size)
+{
+	void* p = RL_REALLOC(ptr, size);
+	if (!p) {
+		printf("Couldn't allocate memory for a handle table\n");
+		exit(-1);
+	}
+	return p;
+}
+
+/**
+ * @brief prepare an empty table
+ *
+ * @param ht the table to initialise
+ */
+void HandleTableInit(HandleTable* ht)
+{
+	memset(ht, 0, sizeof(HandleTable));
+}
+
+/**
+ * @brief release the table's memory
+ *
+ * @param ht the table to release
+ */
+void HandleTableFree(HandleTable* ht)
+{
+	RL_FREE(ht->generation);
+	RL_FREE(ht->denseIndex);
+	RL_FREE(ht->freeSlots);
+	RL_FREE(ht->handles);
+	memset(ht, 0, sizeof(HandleTable));
+}
+
+/**
+ * @brief how many handles can be added before the slots must grow
+ *
+ * @param ht the table
+ */
+int HandleTableFreeSlots(const HandleTable* ht)
+{
+	return ht->freeCount + ht->slotCapacity - ht->slotCount;
+}
+
+/**
+ * @brief make room for more slots, new slots start at generation 1
+ *
+ * @param ht the table
+ * @param slots the new slot capacity, smaller values are ignored
+ */
+void HandleTableGrowSlots(HandleTable* ht, int slots)
+{
+	if (slots <= ht->slotCapacity) return;
+	if ((unsigned)slots > HANDLE_INDEX_MASK + 1) {
+		printf("Handle table is full (%i slots)\n", ht->slotCount);
+		exit(-1);
+	}
+
+	ht->generation = tableRealloc(ht->generation, slots * sizeof(uint32_t));
+	ht->denseIndex = tableRealloc(ht->denseIndex, slots * sizeof(int));
+	ht->freeSlots = tableRealloc(ht->freeSlots, slots * sizeof(int));
+	for (int i = ht->slotCapacity; i < slots; i++) {
+		ht->generation[i] = 1;
+		ht->denseIndex[i] = -1;
+	}
+	ht->slotCapacity = slots;
+}
+
+/**
+ * @brief make room in the dense array
+ *
+ * The owner should grow its payload arrays to the same capacity
+ *
+ * @param ht the table
+ * @param capacity the new dense capacity, smaller values are ignored
+ */
+void HandleTableGrowDense(HandleTable* ht, int capacity)
+{
+	if (capacity <= ht->capacity) return;
+	ht->capacity = capacity;
+	ht->handles = tableRealloc(ht->handles, capacity * sizeof(uint32_t));
+}
+
+/**
+ * @brief hand out a new handle, appending it to the dense array
+ *
+ * @note there must be a free slot and room in the dense array, the new
+ * item's payload belongs at index count-1
+ *
+ * @param ht the table
+ * @return the new handle
+ */
+uint32_t HandleTableAdd(HandleTable* ht)
+{
+	int slot;
+	if (ht->freeCount > 0) {
+		slot = ht->freeSlots[--ht->freeCount];
+	} else {
+		slot = ht->slotCount++;
+	}
+
+	uint32_t h = (ht->generation[slot] << HANDLE_INDEX_BITS) | (uint32_t)slot;
+	ht->denseIndex[slot] = ht->count;
+	ht->handles[ht->count++] = h;
+	return h;
+}
+
+/**
+ * @brief release a handle, stale handles are ignored
+ *
+ * The last handle is moved into the hole left behind, when the returned
+ * index isn't equal to the new count the owner must move its payload
+ * from index count to the returned index.
+ *
+ * @param ht the table
+ * @param h the handle to release
+ * @return the dense index the handle had or -1 if it wasn't live
+ */
+int HandleTableRemove(HandleTable* ht, uint32_t h)
+{
+	int d = HandleTableFind(ht, h);
+	if (d < 0) return -1;
+
+	uint32_t slot = h & HANDLE_INDEX_MASK;
+	int last = --ht->count;
+	if (d != last) {
+		ht->handles[d] = ht->handles[last];
+		ht->denseIndex[ht->handles[d] & HANDLE_INDEX_MASK] = d;
+	}
+
+	ht->denseIndex[slot] = -1;
+	ht->generation[slot] = (ht->generation[slot] + 1) & HANDLE_GEN_MASK;
+	if (ht->generation[slot] == 0) ht->generation[slot] = 1;
+	ht->freeSlots[ht->freeCount++] = slot;
+	return d;
+}
+
+/**
+ * @brief look up the dense index of a handle
+ *
+ * @param ht the table
+ * @param h the handle
+ * @return the index or -1 if the handle is stale or invalid
+ */
+int HandleTableFind(const HandleTable* ht, uint32_t h)
+{
+	uint32_t slot = h & HANDLE_INDEX_MASK;
+	if (h == 0 || slot >= (uint32_t)ht->slotCount) return -1;
+	if (ht->denseIndex[slot] < 0) return -1;
+	if (ht->generation[slot] != (h >> HANDLE_INDEX_BITS)) return -1;
+	return ht->denseIndex[slot];
+}
@@ -42,20 +42,49 @@
  *
  * Typical cleanup sequence:
  * 1. CleanupPhysics() - Destroy ODE world, free bodies
- * 2. CleanupGraphics() - Unload textures, shaders, close window
+ * 2. CleanupGraphics() - Unload loaded textures, shaders, close window
  */
 
 #include <stdio.h>
 #include <stdlib.h>
 #include <time.h>
+#include <string.h>
 
 #include "raylibODE.h"
+#include "prefab.h"
 
 
 
 // a lot of this stuff doesn't change too often 
 // so no point polluting main.c with it...
 
+// Capsule textures are generated, bands run around the capsule
+static Image capsuleBands(void)
+{
+    return GenImageChecked(256, 256, 256, 32, (Color){ 230, 230, 230, 255 }, (Color){ 60, 90, 160, 255 });
+}
+
+static Image capsuleChecks(void)
+{
+    return GenImageChecked(256, 256, 32, 32, (Color){ 240, 200, 120, 255 }, (Color){ 160, 100, 50, 255 });
+}
+
+// the framework's textures by name, none of them are loaded yet
+static void registerTextures(GraphicsContext* ctx)
+{
+    AssetLoader* al = ctx->assets;
+    ctx->sphereTextures[0] = RegisterTexture(al, "ball", "data/ball.png");
+    ctx->sphereTextures[1] = RegisterTexture(al, "beach-ball", "data/beach-ball.png");
+    ctx->sphereTextures[2] = RegisterTexture(al, "earth", "data/earth.png");
+    ctx->boxTextures[0] = RegisterTexture(al, "crate", "data/crate.png");
+    ctx->boxTextures[1] = RegisterTexture(al, "grid", "data/grid.png");
+    ctx->cylinderTextures[0] = RegisterTexture(al, "drum", "data/drum.png");
+    ctx->cylinderTextures[1] = RegisterTexture(al, "cylinder2", "data/cylinder2.png");
+    ctx->capsuleTextures[0] = RegisterGeneratedTexture(al, "capsule-bands", capsuleBands);
+    ctx->capsuleTextures[1] = RegisterGeneratedTexture(al, "capsule-checks", capsuleChecks);
+    ctx->groundTexture = RegisterTexture(al, "grass", "data/grass.png");
+}
+
 /**
  * @brief Initialize graphics context and window
  *
@@ -69,7 +98,8 @@
  *
  * @note Enables VSync and 4x MSAA by default
  * @note Hides and locks cursor for FPS-style camera control
- * @note Loads default textures from data/ directory
+ * @note The default textures in data/ are registered, each is loaded
+ * the first time it is used, see assetLoader.h
  *
  * @see GraphicsContext
  * @see FreeGraphics
@@ -87,31 +117,21 @@ GraphicsContext* CreateGraphics(int width, int height, const char* title)
     DisableCursor();  // Hide and lock cursor
     
     GraphicsContext* ctx = MemAlloc(sizeof(GraphicsContext));
+    InitRaylibBackend(&ctx->backend);
+
     // Load models
     ctx->box = LoadModelFromMesh(GenMeshCube(1, 1, 1));
     ctx->ball = LoadModelFromMesh(GenMeshSphere(.5, 32, 32));
     ctx->cylinder = LoadModel("data/cylinder.obj");
+    InitSphereLod(&ctx->ballLod, &ctx->ball.meshes[0]);
+    InitCylinderLod(&ctx->cylinderLod, &ctx->cylinder.meshes[0]);
 
-    // Load sphere textures
-    ctx->sphereTextures[0] = LoadTexture("data/ball.png");
-    ctx->sphereTextures[1] = LoadTexture("data/beach-ball.png");
-    ctx->sphereTextures[2] = LoadTexture("data/earth.png");
-
-    // Load box textures
-    ctx->boxTextures[0] = LoadTexture("data/crate.png");
-    ctx->boxTextures[1] = LoadTexture("data/grid.png");
-
-    // Load cylinder textures
-    ctx->cylinderTextures[0] = LoadTexture("data/drum.png");
-    ctx->cylinderTextures[1] = LoadTexture("data/cylinder2.png");
-
-    // Load ground texture
-    ctx->groundTexture = LoadTexture("data/grass.png");
-
-    // Apply default textures to models (overridden by per-instance textures)
-    ctx->box.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = ctx->boxTextures[0];
-    ctx->ball.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = ctx->sphereTextures[0];
-    ctx->cylinder.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = ctx->cylinderTextures[0];
+    // textures are only loaded once something uses them, the ones small
+    // enough are packed into the atlas as they arrive
+    ctx->assets = CreateAssetLoader(true);
+    InitTextureAtlas(&ctx->atlas, ATLAS_PAGE_SIZE, true);
+    SetAssetAtlas(ctx->assets, &ctx->atlas);
+    registerTextures(ctx);
 
     // Load shader and set up uniforms
     ctx->shader = LoadShader("data/simpleLight.vs", "data/simpleLight.fs");
@@ -122,20 +142,109 @@ GraphicsContext* CreateGraphics(int width, int height, const char* title)
     int amb = GetShaderLocation(ctx->shader, "ambient");
     SetShaderValue(ctx->shader, amb, (float[4]){0.2, 0.2, 0.2, 1.0}, SHADER_UNIFORM_VEC4);
 
+    // framework geoms scale their uvs per instance, anything else drawn
+    // with this shader gets them as they are
+    int uvScale = GetShaderLocation(ctx->shader, "texCoordScale");
+    SetShaderValue(ctx->shader, uvScale, (float[2]){1.0, 1.0}, SHADER_UNIFORM_VEC2);
+
     // Apply shader to models
     ctx->box.materials[0].shader = ctx->shader;
     ctx->ball.materials[0].shader = ctx->shader;
     ctx->cylinder.materials[0].shader = ctx->shader;
 
+    // primitives are drawn instanced with a variant of the same shader
+    ctx->instanceShader = LoadShader("data/simpleLightInstanced.vs", "data/simpleLight.fs");
+    int instAmb = GetShaderLocation(ctx->instanceShader, "ambient");
+    SetShaderValue(ctx->instanceShader, instAmb, (float[4]){0.2, 0.2, 0.2, 1.0}, SHADER_UNIFORM_VEC4);
+    InitInstancing(&ctx->instancing, ctx->instanceShader, &ctx->atlas);
+
     // Create lights
     ctx->lights[0] = CreateLight(LIGHT_POINT, (Vector3){-25, 25, 25}, Vector3Zero(),
                                 (Color){128, 128, 128, 255}, ctx->shader);
     ctx->lights[1] = CreateLight(LIGHT_POINT, (Vector3){-25, 25, -25}, Vector3Zero(),
                                 (Color){64, 64, 64, 255}, ctx->shader);
+    InitLightUniforms(&ctx->lightUniforms, ctx->shader);
                                 
 	return ctx;
 }
 
+// GenMeshCube uploads the mesh, this is the same cube without doing so
+static Mesh genCubeUnuploaded(void)
+{
+    // each face's normal and the direction its u runs, v is normal x u
+    static const float faces[6][6] = {
+        {  1, 0, 0,   0, 0,-1 }, { -1, 0, 0,   0, 0, 1 },
+        {  0, 1, 0,   1, 0, 0 }, {  0,-1, 0,   1, 0, 0 },
+        {  0, 0, 1,   1, 0, 0 }, {  0, 0,-1,  -1, 0, 0 },
+    };
+    static const float corners[4][2] = { { -1, -1 }, { 1, -1 }, { 1, 1 }, { -1, 1 } };
+
+    Mesh mesh = { 0 };
+    mesh.vertexCount = 24;
+    mesh.triangleCount = 12;
+    mesh.vertices = RL_CALLOC(mesh.vertexCount * 3, sizeof(float));
+    mesh.normals = RL_CALLOC(mesh.vertexCount * 3, sizeof(float));
+    mesh.texcoords = RL_CALLOC(mesh.vertexCount * 2, sizeof(float));
+    mesh.indices = RL_CALLOC(mesh.triangleCount * 3, sizeof(unsigned short));
+
+    for (int f = 0; f < 6; f++) {
+        Vector3 n = { faces[f][0], faces[f][1], faces[f][2] };
+        Vector3 u = { faces[f][3], faces[f][4], faces[f][5] };
+        Vector3 v = Vector3CrossProduct(n, u);
+        for (int c = 0; c < 4; c++) {
+            int i = f * 4 + c;
+            Vector3 p = Vector3Add(Vector3Scale(n, 0.5f),
+                    Vector3Add(Vector3Scale(u, corners[c][0] * 0.5f), Vector3Scale(v, corners[c][1] * 0.5f)));
+            mesh.vertices[i*3 + 0] = p.x;  mesh.vertices[i*3 + 1] = p.y;  mesh.vertices[i*3 + 2] = p.z;
+            mesh.normals[i*3 + 0] = n.x;   mesh.normals[i*3 + 1] = n.y;   mesh.normals[i*3 + 2] = n.z;
+            mesh.texcoords[i*2 + 0] = (corners[c][0] + 1) * 0.5f;
+            mesh.texcoords[i*2 + 1] = (1 - corners[c][1]) * 0.5f;
+        }
+        unsigned short b = (unsigned short)(f * 4);
+        unsigned short tri[6] = { b, b + 1, b + 2, b, b + 2, b + 3 };
+        memcpy(&mesh.indices[f * 6], tri, sizeof(tri));
+    }
+    return mesh;
+}
+
+/**
+ * @brief a graphics context for use without a window
+ *
+ * Draws made with it go to a recording backend, see renderBackend.h,
+ * so DrawBodies, DrawStatics and the rest can be timed and their draw
+ * lists checked headless. The primitive meshes are built on the CPU and
+ * never uploaded, the ball and its coarser levels are capsules with no
+ * cylinder. Textures only have ids and atlas regions so batches split
+ * as they would, no shaders are loaded and there are no lights.
+ *
+ * @param width width of the pretend view, for culling and level of detail
+ * @param height its height
+ * @return the context, free it with FreeGraphics
+ *
+ * @see CreateGraphics
+ */
+GraphicsContext* CreateRecordingGraphics(int width, int height)
+{
+    GraphicsContext* ctx = RL_CALLOC(1, sizeof(GraphicsContext));
+    InitRecordingBackend(&ctx->backend, width, height);
+
+    ctx->box = LoadModelFromMesh(genCubeUnuploaded());
+    ctx->ball = LoadModelFromMesh(GenMeshCapsule(.5f, 0, 32, 16));
+    ctx->cylinder = LoadModelFromMesh(GenMeshCylinderFaceted(32));
+    InitSphereLod(&ctx->ballLod, &ctx->ball.meshes[0]);
+    InitCylinderLod(&ctx->cylinderLod, &ctx->cylinder.meshes[0]);
+
+    // a loader that doesn't upload, textures only get distinct ids and
+    // atlas regions
+    ctx->assets = CreateAssetLoader(false);
+    InitTextureAtlas(&ctx->atlas, ATLAS_PAGE_SIZE, false);
+    SetAssetAtlas(ctx->assets, &ctx->atlas);
+    registerTextures(ctx);
+
+    ctx->camera = (Camera){ { 0, 10, 20 }, { 0, 0, 0 }, { 0, 1, 0 }, 45, CAMERA_PERSPECTIVE };
+    return ctx;
+}
+
 
 
 /**
@@ -169,9 +278,23 @@ PhysicsContext* CreatePhysics()//dSpaceID* space)//, GraphicsContext* gfxCtx)
     PhysicsContext* ctx = RL_MALLOC(sizeof(PhysicsContext));
     if (!ctx) return NULL;
     
-	ctx->objList = clistCreateList();
-	ctx->statics = clistCreateList();
+	// everything the framework allocates for this context comes from
+	// the arena so FreePhysics can drop it all at once
+	ArenaInit(&ctx->arena, "physics", 256 * 1024);
+	memset(&ctx->memStats, 0, sizeof(PhysicsMemoryStats));
+	EntityStoreInit(&ctx->entities, &ctx->arena);
+	JointRegistryInit(&ctx->joints);
+	PoolInit(&ctx->geomPool, "geomInfo", sizeof(geomInfo), 256, &ctx->arena);
+	PoolInit(&ctx->nodePool, "list node", sizeof(cnode_t), 512, &ctx->arena);
+	ctx->objList = clistCreateListPooled(&ctx->nodePool);
+	ctx->statics = clistCreateListPooled(&ctx->nodePool);
+	for (int i = 0; i < RETIRED_SHAPES; i++) {
+		ctx->retired[i] = clistCreateListPooled(&ctx->nodePool);
+	}
+	ctx->prefabs = clistCreateListPooled(&ctx->nodePool);
 
+    // handlers have to be in place before ODE allocates anything
+    if (OdeAllocatorWanted()) InstallOdeAllocator();
     dInitODE2(0);
     dAllocateODEDataForThread(dAllocateMaskAll);
 
@@ -180,6 +303,8 @@ PhysicsContext* CreatePhysics()//dSpaceID* space)//, GraphicsContext* gfxCtx)
     ctx->space = dHashSpaceCreate(NULL);
     //ctx->space = space;  // Store space pointer for cleanup
     ctx->contactgroup = dJointGroupCreate(0);
+    // queries reuse one ray rather than making and destroying one each time
+    ctx->ray = dCreateRay(0, 1);
     dWorldSetGravity(ctx->world, 0, -9.8, 0);
 
     dWorldSetAutoDisableFlag(ctx->world, 1);
@@ -192,53 +317,68 @@ PhysicsContext* CreatePhysics()//dSpaceID* space)//, GraphicsContext* gfxCtx)
     return ctx;
 }
 
+// the geoms themselves go with the space
+static void freeBodyGeomInfo(PhysicsContext* ctx, dBodyID bdy)
+{
+	for (dGeomID geom = dBodyGetFirstGeom(bdy); geom; geom = dBodyGetNextGeom(geom)) {
+		FreeGeomInfo(ctx, dGeomGetData(geom));
+	}
+}
+
 void FreePhysics(PhysicsContext* ctx)
 {
     if (!ctx) return;
 
-	cnode_t* node = ctx->objList->head;
-
-	while (node != NULL) {
-		entity* ent = (entity*)node->data;
-		if (ent) {
-			FreeBodyAndGeoms(ent->body);
-			free(ent);
+	// Entities, pooled geomInfo and list nodes all live in the arena and
+	// are released with it at the end. Only the framework's own geoms,
+	// those on entity and retired bodies and the statics, are visited for
+	// shared trimeshes and geomInfo the user allocated. Anything else the
+	// user put in the space is theirs, as it always was.
+	for (int i = 0; i < ctx->entities.table.count; i++) {
+		freeBodyGeomInfo(ctx, ctx->entities.bodies[i]);
+	}
+	for (int i = 0; i < RETIRED_SHAPES; i++) {
+		for (cnode_t* node = ctx->retired[i]->head; node; node = node->next) {
+			freeBodyGeomInfo(ctx, node->data);
 		}
-		node = node->next;
+	}
+	for (cnode_t* node = ctx->statics->head; node; node = node->next) {
+		geomInfo* gi = dGeomGetData(node->data);
+		if (!gi) continue;
+		if (!gi->trimesh && gi->triData) dGeomTriMeshDataDestroy(gi->triData);
+		FreeGeomInfo(ctx, gi);
 	}
 
-	clistFreeList(&ctx->objList);
-	
-	
-	node = ctx->statics->head;
-
-	while (node != NULL) {
-		dGeomID geom = node->data;
-		if (geom) {
-			geomInfo* gi = dGeomGetData(geom);
-			if (gi) {
-				if (gi->indices) RL_FREE(gi->indices);
-				if (gi->triData) dGeomTriMeshDataDestroy(gi->triData);
-				free(gi);
-			}
-			dGeomSetBody(geom, 0);
-			dGeomDestroy(geom);
-		}
-		node = node->next;
+	clistAbandonList(&ctx->objList);
+	clistAbandonList(&ctx->statics);
+	for (int i = 0; i < RETIRED_SHAPES; i++) {
+		clistAbandonList(&ctx->retired[i]);
 	}
-	
-	clistFreeList(&ctx->statics);
+	FreePrefabs(ctx);
+	clistAbandonList(&ctx->prefabs);
+	EntityStoreFree(&ctx->entities);
+	JointRegistryFree(&ctx->joints); // the world destroys the joints themselves
+	PoolFree(&ctx->geomPool);
+	PoolFree(&ctx->nodePool);
 
-	
 	// dJointGroupEmpty clears the joints; dJointGroupDestroy frees the group memory
     if (ctx->contactgroup) {
         dJointGroupEmpty(ctx->contactgroup);
         dJointGroupDestroy(ctx->contactgroup);
     }
 
+	// not in the space so it isn't cleaned up with it
+	dGeomDestroy(ctx->ray);
+
+	// ODE tears down its own objects in bulk, the space destroys the
+	// geoms in it and the world destroys its bodies and joints
+	dSpaceSetCleanup(ctx->space, 1);
 	dSpaceDestroy(ctx->space);
 	dWorldDestroy(ctx->world);
 	dCloseODE();
+	ReleaseOdeAllocator();
+
+	ArenaFree(&ctx->arena);
 
     RL_FREE(ctx);
 }
@@ -250,18 +390,24 @@ void FreeGraphics(GraphicsContext* ctx)
     UnloadModel(ctx->box);
     UnloadModel(ctx->ball);
     UnloadModel(ctx->cylinder);
+    FreeMeshLod(&ctx->ballLod);
+    FreeMeshLod(&ctx->cylinderLod);
+    FreeCapsuleMeshes(&ctx->capsules);
     
-    // Unload all textures
-    UnloadTexture(ctx->sphereTextures[0]);
-    UnloadTexture(ctx->sphereTextures[1]);
-    UnloadTexture(ctx->sphereTextures[2]);
-    UnloadTexture(ctx->boxTextures[0]);
-    UnloadTexture(ctx->boxTextures[1]);
-    UnloadTexture(ctx->cylinderTextures[0]);
-    UnloadTexture(ctx->cylinderTextures[1]);
-    UnloadTexture(ctx->groundTexture);
-    
-    UnloadShader(ctx->shader);
+    FreeInstancing(&ctx->instancing);
+    FreeCullSet(&ctx->culling);
+    FreeRenderPrep(&ctx->prep);
+    FreeStaticBatches(&ctx->staticBatches);
+    FreeRenderBackend(&ctx->backend);
+    FreeLightSet(&ctx->sceneLights);
+    FreeAssetLoader(ctx->assets);   // only the textures that were used were loaded
+    FreeTextureAtlas(&ctx->atlas);
+
+    // recording graphics have no shaders to unload
+    if (IsWindowReady()) {
+        UnloadShader(ctx->instanceShader);
+        UnloadShader(ctx->shader);
+    }
     
     RL_FREE(ctx);
 }
@@ -0,0 +1,388 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file instancing.c
+ * @brief Instanced drawing of the framework's primitive meshes
+ *
+ * Each frame geoms are queued with AddInstance, which appends to the
+ * batch for their mesh and texture, textures packed into an atlas share
+ * their page's batch. DrawInstances copies every batch into one dynamic
+ * vertex buffer and issues one instanced draw per batch, the per
+ * instance attributes are pointed at that batch's part of the buffer.
+ * The batches are drawn in sort key order, texture then mesh then
+ * nearest instance, and a texture or mesh already bound isn't bound
+ * again.
+ *
+ * @author Chris Camacho (codifies - http://bedroomcoders.co.uk/)
+ * @date 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stddef.h>
+#include <math.h>
+
+#include "raylib.h"
+#include "raymath.h"
+#include "rlgl.h"
+#include "instancing.h"
+
+#define BATCH_GROW 8
+#define INSTANCE_GROW 64
+
+static void* instancingRealloc(void* ptr, size_t size)
+{
+	void* p = RL_REALLOC(ptr, size);
+	if (!p) {
+		printf("Couldn't allocate memory for instanced drawing\n");
+		exit(-1);
+	}
+	return p;
+}
+
+/**
+ * @brief look up the instancing attributes and uniforms of a shader
+ *
+ * @param r the renderer to set up
+ * @param shader a shader with instanceTransform, instanceTint and
+ * instanceUv attributes and an atlasRegions uniform, see
+ * data/simpleLightInstanced.vs
+ * @param atlas NULL or the atlas instance regions refer to
+ */
+void InitInstancing(InstanceRenderer* r, Shader shader, const TextureAtlas* atlas)
+{
+	memset(r, 0, sizeof(InstanceRenderer));
+	r->shader = shader;
+	r->shader.locs[SHADER_LOC_VECTOR_VIEW] = GetShaderLocation(shader, "viewPos");
+	r->transformLoc = GetShaderLocationAttrib(shader, "instanceTransform");
+	r->tintLoc = GetShaderLocationAttrib(shader, "instanceTint");
+	r->uvLoc = GetShaderLocationAttrib(shader, "instanceUv");
+	r->atlasLoc = GetShaderLocation(shader, "atlasRegions");
+	r->atlas = atlas;
+	if (r->transformLoc < 0 || r->tintLoc < 0 || r->uvLoc < 0) {
+		printf("Instancing shader is missing its per instance attributes\n");
+	}
+
+	InitLightUniforms(&r->lights, shader);
+}
+
+/**
+ * @brief release the batches and the instance buffer
+ *
+ * @note the shader belongs to the caller and isn't unloaded
+ */
+void FreeInstancing(InstanceRenderer* r)
+{
+	for (int i = 0; i < r->batchCount; i++) {
+		RL_FREE(r->batches[i].instances);
+	}
+	RL_FREE(r->batches);
+	FreeRenderQueue(&r->queue);
+	if (r->vbo) rlUnloadVertexBuffer(r->vbo);
+	r->batches = NULL;
+	r->batchCount = r->batchCapacity = 0;
+	r->vbo = 0;
+	r->vboCapacity = 0;
+}
+
+/**
+ * @brief empty every batch, ready to queue a new set of instances
+ */
+void BeginInstancing(InstanceRenderer* r)
+{
+	for (int i = 0; i < r->batchCount; i++) {
+		r->batches[i].count = 0;
+	}
+}
+
+static InstanceBatch* batchFor(InstanceRenderer* r, Mesh* mesh, unsigned int textureId)
+{
+	for (int i = 0; i < r->batchCount; i++) {
+		InstanceBatch* b = &r->batches[i];
+		if (b->mesh == mesh && b->textureId == textureId) return b;
+	}
+
+	if (r->batchCount == r->batchCapacity) {
+		r->batchCapacity += BATCH_GROW;
+		r->batches = instancingRealloc(r->batches, r->batchCapacity * sizeof(InstanceBatch));
+	}
+	InstanceBatch* b = &r->batches[r->batchCount++];
+	memset(b, 0, sizeof(InstanceBatch));
+	b->mesh = mesh;
+	b->textureId = textureId;
+	return b;
+}
+
+/**
+ * @brief queue one instance of a mesh
+ *
+ * The transform isn't given here, the render prep pass builds them all
+ * at once and writes them through InstanceTransform before drawing.
+ *
+ * @param r the renderer
+ * @param mesh the mesh, batches are keyed on its address so it must
+ * stay put until DrawInstances
+ * @param texture the diffuse texture, or atlas page and region, see
+ * AtlasFind
+ * @param tint colour multiplied with the texture
+ * @param uvScale texture coordinate scale
+ * @return where the instance is queued
+ */
+InstanceSlot AddInstance(InstanceRenderer* r, Mesh* mesh, AtlasRegion texture,
+					Color tint, Vector2 uvScale)
+{
+	InstanceBatch* b = batchFor(r, mesh, texture.textureId);
+	if (b->count == b->capacity) {
+		b->capacity = b->capacity ? b->capacity * 2 : INSTANCE_GROW;
+		b->instances = instancingRealloc(b->instances, b->capacity * sizeof(Instance));
+	}
+
+	InstanceSlot slot = { (int)(b - r->batches), b->count };
+	Instance* in = &b->instances[b->count++];
+	in->tint[0] = tint.r / 255.0f;
+	in->tint[1] = tint.g / 255.0f;
+	in->tint[2] = tint.b / 255.0f;
+	in->tint[3] = tint.a / 255.0f;
+	in->uvScale[0] = uvScale.x;
+	in->uvScale[1] = uvScale.y;
+	in->region = (float)texture.index;
+	return slot;
+}
+
+/**
+ * @brief the 16 float column major transform of a queued instance
+ *
+ * @note the pointer is only good until the next AddInstance, which can
+ * move the batch's storage
+ */
+float* InstanceTransform(InstanceRenderer* r, InstanceSlot slot)
+{
+	return r->batches[slot.batch].instances[slot.index].transform;
+}
+
+// copy every batch into the instance buffer, growing it if needed
+static int uploadBatches(InstanceRenderer* r)
+{
+	int total = 0;
+	for (int i = 0; i < r->batchCount; i++) total += r->batches[i].count;
+	if (!total) return 0;
+
+	if (total > r->vboCapacity) {
+		if (r->vbo) rlUnloadVertexBuffer(r->vbo);
+		r->vboCapacity = r->vboCapacity ? r->vboCapacity : INSTANCE_GROW;
+		while (r->vboCapacity < total) r->vboCapacity *= 2;
+		r->vbo = rlLoadVertexBuffer(NULL, r->vboCapacity * sizeof(Instance), true);
+	}
+
+	int base = 0;
+	for (int i = 0; i < r->batchCount; i++) {
+		InstanceBatch* b = &r->batches[i];
+		b->base = base;
+		if (!b->count) continue;
+		rlUpdateVertexBuffer(r->vbo, b->instances, b->count * sizeof(Instance), base * sizeof(Instance));
+		base += b->count;
+	}
+	return total;
+}
+
+/**
+ * @brief put the batches in the order they are drawn
+ *
+ * Keys put the same texture and mesh together, then the nearest first,
+ * the batch indices end up in the renderer's queue. DrawInstances does
+ * this itself, it is here for backends that don't draw with rlgl.
+ *
+ * @param r the renderer
+ * @param viewPos camera position
+ */
+void SortInstanceBatches(InstanceRenderer* r, Vector3 viewPos)
+{
+	RenderQueueClear(&r->queue);
+	for (int i = 0; i < r->batchCount; i++) {
+		InstanceBatch* b = &r->batches[i];
+		if (!b->count) continue;
+
+		float nearest = INFINITY;
+		for (int k = 0; k < b->count; k++) {
+			const float* m = b->instances[k].transform;
+			float dx = m[12] - viewPos.x, dy = m[13] - viewPos.y, dz = m[14] - viewPos.z;
+			float d = dx*dx + dy*dy + dz*dz;
+			if (d < nearest) nearest = d;
+		}
+		RenderQueuePush(&r->queue, RenderKey(RENDER_PASS_OPAQUE, r->shader.id, b->textureId, b->mesh->vaoId, nearest), i);
+	}
+	RenderQueueSort(&r->queue);
+}
+
+// the sphere around a batch's instance positions, for picking its lights
+static float batchBounds(const InstanceBatch* b, Vector3* centre)
+{
+	float lo[3] = { INFINITY, INFINITY, INFINITY }, hi[3] = { -INFINITY, -INFINITY, -INFINITY };
+	for (int k = 0; k < b->count; k++) {
+		const float* m = b->instances[k].transform;
+		for (int a = 0; a < 3; a++) {
+			if (m[12 + a] < lo[a]) lo[a] = m[12 + a];
+			if (m[12 + a] > hi[a]) hi[a] = m[12 + a];
+		}
+	}
+	*centre = (Vector3){ (lo[0] + hi[0]) * 0.5f, (lo[1] + hi[1]) * 0.5f, (lo[2] + hi[2]) * 0.5f };
+	float dx = hi[0] - lo[0], dy = hi[1] - lo[1], dz = hi[2] - lo[2];
+	return sqrtf(dx*dx + dy*dy + dz*dz) * 0.5f;
+}
+
+// point the per instance attributes at a batch's part of the buffer
+static void setInstanceAttributes(InstanceRenderer* r, int base)
+{
+	int stride = sizeof(Instance);
+	int offset = base * stride;
+
+	for (int c = 0; c < 4; c++) {
+		unsigned int loc = r->transformLoc + c;
+		rlEnableVertexAttribute(loc);
+		rlSetVertexAttribute(loc, 4, RL_FLOAT, false, stride,
+			offset + offsetof(Instance, transform) + c * 4 * sizeof(float));
+		rlSetVertexAttributeDivisor(loc, 1);
+	}
+	rlEnableVertexAttribute(r->tintLoc);
+	rlSetVertexAttribute(r->tintLoc, 4, RL_FLOAT, false, stride, offset + offsetof(Instance, tint));
+	rlSetVertexAttributeDivisor(r->tintLoc, 1);
+	rlEnableVertexAttribute(r->uvLoc);
+	rlSetVertexAttribute(r->uvLoc, 4, RL_FLOAT, false, stride, offset + offsetof(Instance, uvScale));
+	rlSetVertexAttributeDivisor(r->uvLoc, 1);
+}
+
+// the mesh's vertex array is shared with normal drawing, leave it as found
+static void clearInstanceAttributes(InstanceRenderer* r)
+{
+	for (int c = 0; c < 4; c++) {
+		rlSetVertexAttributeDivisor(r->transformLoc + c, 0);
+		rlDisableVertexAttribute(r->transformLoc + c);
+	}
+	rlSetVertexAttributeDivisor(r->tintLoc, 0);
+	rlDisableVertexAttribute(r->tintLoc);
+	rlSetVertexAttributeDivisor(r->uvLoc, 0);
+	rlDisableVertexAttribute(r->uvLoc);
+}
+
+/**
+ * @brief draw everything queued since BeginInstancing, one call per batch
+ *
+ * Batches are drawn sorted by texture and mesh so each is bound once,
+ * stateChanges counts the binds made.
+ *
+ * Must be called inside BeginMode3D, the current view and projection
+ * are used.
+ *
+ * Light uniforms are only sent when they change. With a light set each
+ * batch is lit by the MAX_LIGHTS of it that matter most to the region
+ * its instances cover, batches of things close together get the lights
+ * near them.
+ *
+ * @param r the renderer
+ * @param viewPos camera position, for specular lighting
+ * @param lights MAX_LIGHTS lights to light with, usually the graphics
+ * context's
+ * @param sceneLights NULL or empty to use lights for everything
+ */
+void DrawInstances(InstanceRenderer* r, Vector3 viewPos, const Light* lights, const LightSet* sceneLights)
+{
+	r->drawCalls = 0;
+	r->triangles = 0;
+	r->stateChanges = 0;
+	r->instanceCount = uploadBatches(r);
+	if (!r->instanceCount || r->transformLoc < 0 || r->tintLoc < 0 || r->uvLoc < 0) return;
+
+	bool perBatch = sceneLights && sceneLights->count;
+	if (!perBatch) UploadLights(&r->lights, r->shader, lights);
+	SetShaderValue(r->shader, r->shader.locs[SHADER_LOC_VECTOR_VIEW], &viewPos.x, SHADER_UNIFORM_VEC3);
+	if (r->atlas && r->atlasLoc >= 0 && r->atlas->version != r->atlasVersion) {
+		SetShaderValueV(r->shader, r->atlasLoc, r->atlas->regions, SHADER_UNIFORM_VEC4, ATLAS_MAX_REGIONS);
+		r->atlasVersion = r->atlas->version;
+	}
+
+	rlEnableShader(r->shader.id);
+
+	// the model matrix comes per instance, so mvp is just view projection
+	Matrix view = MatrixMultiply(rlGetMatrixTransform(), rlGetMatrixModelview());
+	rlSetUniformMatrix(r->shader.locs[SHADER_LOC_MATRIX_MVP], MatrixMultiply(view, rlGetMatrixProjection()));
+
+	float white[4] = { 1, 1, 1, 1 };
+	rlSetUniform(r->shader.locs[SHADER_LOC_COLOR_DIFFUSE], white, RL_SHADER_UNIFORM_VEC4, 1);
+	int slot = 0;
+	rlSetUniform(r->shader.locs[SHADER_LOC_MAP_DIFFUSE], &slot, RL_SHADER_UNIFORM_INT, 1);
+	rlActiveTextureSlot(0);
+
+	SortInstanceBatches(r, viewPos);
+
+	bool bound = false;
+	unsigned int texture = 0, vao = 0;
+	for (int i = 0; i < r->queue.count; i++) {
+		InstanceBatch* b = &r->batches[r->queue.items[i]];
+
+		if (!bound || b->textureId != texture) {
+			rlEnableTexture(b->textureId);
+			texture = b->textureId;
+			r->stateChanges++;
+		}
+		if (!bound || b->mesh->vaoId != vao) {
+			if (bound) {
+				clearInstanceAttributes(r);
+				rlDisableVertexArray();
+			}
+			rlEnableVertexArray(b->mesh->vaoId);
+			vao = b->mesh->vaoId;
+			r->stateChanges++;
+		}
+		bound = true;
+
+		if (perBatch) {
+			Vector3 centre;
+			float radius = batchBounds(b, &centre);
+			Light chosen[MAX_LIGHTS];
+			SelectLights(sceneLights, centre, radius, chosen);
+			UploadLights(&r->lights, r->shader, chosen);
+		}
+
+		// a batch of the same mesh still needs its own part of the buffer
+		rlEnableVertexBuffer(r->vbo);
+		setInstanceAttributes(r, b->base);
+
+		if (b->mesh->indices) {
+			rlDrawVertexArrayElementsInstanced(0, b->mesh->triangleCount * 3, 0, b->count);
+		} else {
+			rlDrawVertexArrayInstanced(0, b->mesh->vertexCount, b->count);
+		}
+		r->drawCalls++;
+		r->triangles += b->count * b->mesh->triangleCount;
+	}
+	if (bound) {
+		clearInstanceAttributes(r);
+		rlDisableVertexArray();
+	}
+
+	rlDisableVertexBuffer();
+	rlDisableTexture();
+	rlDisableShader();
+}
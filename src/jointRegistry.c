@@ -0,0 +1,135 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file jointRegistry.c
+ * @brief Tracks the joints in a physics context
+ *
+ * Joints used to be created and forgotten, FreePhysics never saw them
+ * and freeing a multi piston just dropped its arrays. Every joint the
+ * framework makes is now registered here.
+ *
+ * @author Chris Camacho (codifies - http://bedroomcoders.co.uk/)
+ * @date 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "raylib.h"
+#include "jointRegistry.h"
+
+#define JOINT_GROW 64
+
+static void* registryRealloc(void* ptr, size_t size)
+{
+	void* p = RL_REALLOC(ptr, size);
+	if (!p) {
+		printf("Couldn't allocate memory for the joint registry\n");
+		exit(-1);
+	}
+	return p;
+}
+
+/**
+ * @brief prepare an empty registry
+ *
+ * @param jr the registry to initialise
+ */
+void JointRegistryInit(JointRegistry* jr)
+{
+	memset(jr, 0, sizeof(JointRegistry));
+	HandleTableInit(&jr->table);
+}
+
+/**
+ * @brief release the registry's memory
+ *
+ * @note the joints themselves are left alone, destroying the world
+ * destroys any that remain
+ *
+ * @param jr the registry to release
+ */
+void JointRegistryFree(JointRegistry* jr)
+{
+	RL_FREE(jr->joints);
+	RL_FREE(jr->kinds);
+	HandleTableFree(&jr->table);
+	memset(jr, 0, sizeof(JointRegistry));
+}
+
+/**
+ * @brief add a joint to the registry
+ *
+ * @param jr the registry
+ * @param joint the joint
+ * @param kind what the joint is part of
+ * @return a handle to the joint
+ */
+JointHandle JointRegistryAdd(JointRegistry* jr, dJointID joint, JointKind kind)
+{
+	HandleTable* ht = &jr->table;
+	if (HandleTableFreeSlots(ht) == 0) HandleTableGrowSlots(ht, ht->slotCapacity + JOINT_GROW);
+	if (ht->count == ht->capacity) {
+		HandleTableGrowDense(ht, ht->capacity + JOINT_GROW);
+		jr->joints = registryRealloc(jr->joints, ht->capacity * sizeof(dJointID));
+		jr->kinds = registryRealloc(jr->kinds, ht->capacity);
+	}
+
+	jr->joints[ht->count] = joint;
+	jr->kinds[ht->count] = (unsigned char)kind;
+	JointHandle h = { HandleTableAdd(ht) };
+	return h;
+}
+
+/**
+ * @brief take a joint out of the registry, stale handles are ignored
+ *
+ * The last joint is moved into the hole left behind
+ *
+ * @param jr the registry
+ * @param h handle of the joint
+ */
+void JointRegistryRemove(JointRegistry* jr, JointHandle h)
+{
+	int d = HandleTableRemove(&jr->table, h.id);
+	if (d < 0 || d == jr->table.count) return;
+
+	int last = jr->table.count;
+	jr->joints[d] = jr->joints[last];
+	jr->kinds[d] = jr->kinds[last];
+}
+
+/**
+ * @brief look up a joint from its handle
+ *
+ * @param jr the registry
+ * @param h the handle
+ * @return the joint or 0 if the handle is stale or invalid
+ */
+dJointID JointRegistryGet(JointRegistry* jr, JointHandle h)
+{
+	int d = HandleTableFind(&jr->table, h.id);
+	return d < 0 ? 0 : jr->joints[d];
+}
@@ -0,0 +1,202 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file meshLod.c
+ * @brief Coarser versions of the built in primitive meshes
+ *
+ * The finest sphere is the GenMeshSphere the graphics context always
+ * used, the coarser ones are the same with fewer rings and slices. The
+ * finest cylinder is data/cylinder.obj, the coarser ones are generated
+ * with the same faceted look and texture layout, so a drum doesn't
+ * change its label when it changes level.
+ *
+ * @author Chris Camacho (codifies - http://bedroomcoders.co.uk/)
+ * @date 2026
+ */
+
+#include <math.h>
+#include <string.h>
+
+#include "meshLod.h"
+#include "capsuleMesh.h"
+
+// smallest height on screen, in pixels, each level but the last is used at
+static const float lodPixels[LOD_LEVELS - 1] = { 160.0f, 64.0f, 24.0f };
+
+// rings and slices of the coarser spheres, sides of the coarser cylinders
+static const int sphereDetail[LOD_LEVELS - 1] = { 16, 10, 6 };
+static const int cylinderSides[LOD_LEVELS - 1] = { 16, 10, 6 };
+
+/**
+ * @brief a sphere chain, the coarser levels match GenMeshSphere(.5, ...)
+ *
+ * GenMeshSphere always uploads, without a window the levels are
+ * capsules with no cylinder instead.
+ *
+ * @param lod the chain to fill
+ * @param finest the mesh used close up, not owned by the chain
+ */
+void InitSphereLod(MeshLod* lod, Mesh* finest)
+{
+	memset(lod, 0, sizeof(*lod));
+	lod->levels[0] = finest;
+	for (int i = 1; i < LOD_LEVELS; i++) {
+		int d = sphereDetail[i - 1];
+		lod->owned[lod->ownedCount] = IsWindowReady() ? GenMeshSphere(.5, d, d) : GenMeshCapsule(.5f, 0, d, d / 2);
+		lod->levels[i] = &lod->owned[lod->ownedCount++];
+	}
+}
+
+/**
+ * @brief a cylinder chain, the coarser levels match data/cylinder.obj
+ *
+ * @param lod the chain to fill
+ * @param finest the mesh used close up, not owned by the chain
+ */
+void InitCylinderLod(MeshLod* lod, Mesh* finest)
+{
+	memset(lod, 0, sizeof(*lod));
+	lod->levels[0] = finest;
+	for (int i = 1; i < LOD_LEVELS; i++) {
+		lod->owned[lod->ownedCount] = GenMeshCylinderFaceted(cylinderSides[i - 1]);
+		lod->levels[i] = &lod->owned[lod->ownedCount++];
+	}
+}
+
+/**
+ * @brief unload the levels a chain generated
+ */
+void FreeMeshLod(MeshLod* lod)
+{
+	for (int i = 0; i < lod->ownedCount; i++) UnloadMesh(lod->owned[i]);
+	memset(lod, 0, sizeof(*lod));
+}
+
+static void setVertex(Mesh* m, int v, float x, float y, float z, float nx, float ny, float nz, float u, float tv)
+{
+	m->vertices[v*3 + 0] = x;  m->vertices[v*3 + 1] = y;  m->vertices[v*3 + 2] = z;
+	m->normals[v*3 + 0] = nx;  m->normals[v*3 + 1] = ny;  m->normals[v*3 + 2] = nz;
+	m->texcoords[v*2 + 0] = u; m->texcoords[v*2 + 1] = tv;
+}
+
+/**
+ * @brief a unit cylinder along z laid out like data/cylinder.obj
+ *
+ * Flat shaded sides starting at -y and going anticlockwise, the label
+ * band and the two cap discs use the same parts of the texture as the
+ * model does.
+ *
+ * @param sides number of flat sides
+ * @return the mesh, uploaded if there is a window, unload with UnloadMesh
+ */
+Mesh GenMeshCylinderFaceted(int sides)
+{
+	Mesh mesh = { 0 };
+	mesh.triangleCount = sides * 2 + (sides - 2) * 2;
+	mesh.vertexCount = mesh.triangleCount * 3;
+	mesh.vertices = RL_CALLOC(mesh.vertexCount * 3, sizeof(float));
+	mesh.normals = RL_CALLOC(mesh.vertexCount * 3, sizeof(float));
+	mesh.texcoords = RL_CALLOC(mesh.vertexCount * 2, sizeof(float));
+
+	// the band runs from v 0.37364 at the top to 1.005887 at the bottom
+	const float vTop = 0.37364f, vBottom = 1.005887f;
+	int v = 0;
+	for (int k = 0; k < sides; k++) {
+		float a0 = -PI * 0.5f + 2 * PI * k / sides;
+		float a1 = -PI * 0.5f + 2 * PI * (k + 1) / sides;
+		float am = (a0 + a1) * 0.5f;
+		float x0 = cosf(a0) * 0.5f, y0 = sinf(a0) * 0.5f;
+		float x1 = cosf(a1) * 0.5f, y1 = sinf(a1) * 0.5f;
+		float nx = cosf(am), ny = sinf(am);
+		float u0 = 0.46801f - (float)k / sides;
+		if (u0 < 0) u0 += 1;
+		float u1 = u0 - 1.0f / sides;
+
+		setVertex(&mesh, v++, x0, y0, -0.5f, nx, ny, 0, u0, vBottom);
+		setVertex(&mesh, v++, x1, y1, -0.5f, nx, ny, 0, u1, vBottom);
+		setVertex(&mesh, v++, x0, y0,  0.5f, nx, ny, 0, u0, vTop);
+		setVertex(&mesh, v++, x1, y1, -0.5f, nx, ny, 0, u1, vBottom);
+		setVertex(&mesh, v++, x1, y1,  0.5f, nx, ny, 0, u1, vTop);
+		setVertex(&mesh, v++, x0, y0,  0.5f, nx, ny, 0, u0, vTop);
+	}
+
+	// caps are fans, their uvs are the model's discs as planar maps
+	for (int k = 1; k < sides - 1; k++) {
+		float a[3] = { -PI * 0.5f, -PI * 0.5f + 2 * PI * k / sides, -PI * 0.5f + 2 * PI * (k + 1) / sides };
+		for (int i = 0; i < 3; i++) {
+			float x = cosf(a[i]) * 0.5f, y = sinf(a[i]) * 0.5f;
+			setVertex(&mesh, v++, x, y, 0.5f, 0, 0, 1,
+					0.327343f * x + 0.174968f * y + 0.433784f,
+					-0.174968f * x + 0.327342f * y + 0.187976f);
+		}
+		for (int i = 2; i >= 0; i--) {
+			float x = cosf(a[i]) * 0.5f, y = sinf(a[i]) * 0.5f;
+			setVertex(&mesh, v++, x, y, -0.5f, 0, 0, -1,
+					0.171483f * x - 0.320823f * y + 0.814271f,
+					-0.320823f * x - 0.171483f * y + 0.188589f);
+		}
+	}
+
+	if (IsWindowReady()) UploadMesh(&mesh, false);
+	return mesh;
+}
+
+/**
+ * @brief roughly how many pixels high something looks
+ *
+ * @param camera the camera it is seen with
+ * @param screenHeight height of the view in pixels
+ * @param pos centre of the thing
+ * @param size its largest dimension
+ */
+float LodScreenSize(Camera camera, int screenHeight, Vector3 pos, float size)
+{
+	if (camera.projection == CAMERA_ORTHOGRAPHIC) return size / camera.fovy * screenHeight;
+
+	float dx = pos.x - camera.position.x;
+	float dy = pos.y - camera.position.y;
+	float dz = pos.z - camera.position.z;
+	float dist = sqrtf(dx*dx + dy*dy + dz*dz);
+	float view = 2.0f * dist * tanf(camera.fovy * 0.5f * DEG2RAD);
+	if (view <= 0) return INFINITY;
+	return size / view * screenHeight;
+}
+
+/**
+ * @brief the level something should be drawn at
+ *
+ * @param current the level it was drawn at last, 0 if it is new
+ * @param pixels its size on screen from LodScreenSize
+ * @return the level to draw it at now
+ */
+int SelectLod(int current, float pixels)
+{
+	int level = current < 0 ? 0 : (current >= LOD_LEVELS ? LOD_LEVELS - 1 : current);
+
+	// finer while well above the threshold of the finer level
+	while (level > 0 && pixels > lodPixels[level - 1] * (1 + LOD_HYSTERESIS)) level--;
+	// coarser while well below this level's own threshold
+	while (level < LOD_LEVELS - 1 && pixels < lodPixels[level] * (1 - LOD_HYSTERESIS)) level++;
+	return level;
+}
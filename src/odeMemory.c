@@ -0,0 +1,290 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file odeMemory.c
+ * @brief Tracked allocator for ODE's own allocations
+ *
+ * Each allocation carries a small header recording its size class, so
+ * frees and reallocs don't depend on the size ODE passes back. Small
+ * allocations come from per class pools, anything bigger than the
+ * largest class goes to malloc. Freed large blocks up to 64k are
+ * parked rather than freed, the contact joint group releases its 16k
+ * arenas every step and without this would malloc them again on the next.
+ *
+ * @note not thread safe, ODE must be stepped from one thread, which is
+ * why it has to be asked for with TrackOdeAllocations
+ *
+ * @author Chris Camacho (codifies - http://bedroomcoders.co.uk/)
+ * @date 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ode/ode.h>
+
+#include "pool.h"
+#include "odeMemory.h"
+
+#define ODE_MEM_CLASSES 8		// 32 bytes to 4k, doubling
+#define ODE_MEM_SMALLEST 32
+#define ODE_MEM_LARGE ODE_MEM_CLASSES	// class used for direct mallocs
+#define ODE_MEM_PARK_MAX 65536	// bigger blocks are one offs, free them
+
+// keeps the user part 16 byte aligned
+typedef struct OdeMemHeader {
+	size_t size;	// size asked for
+	size_t sizeClass;
+} OdeMemHeader;
+
+static bool wanted = false;
+static OdeMemStats stats;
+static OdeMemHeader* parked;	// freed large blocks, linked through their user part
+static Pool classes[ODE_MEM_CLASSES];
+static const char* classNames[ODE_MEM_CLASSES] = {
+	"ode 32", "ode 64", "ode 128", "ode 256", "ode 512", "ode 1k", "ode 2k", "ode 4k"
+};
+
+static size_t classFor(size_t total)
+{
+	size_t c = 0;
+	size_t s = ODE_MEM_SMALLEST;
+	while (s < total && c < ODE_MEM_LARGE) {
+		s *= 2;
+		c++;
+	}
+	return c;
+}
+
+// large blocks are at least 4k so there's always room for the link
+static OdeMemHeader** parkedNext(OdeMemHeader* h)
+{
+	return (OdeMemHeader**)(h + 1);
+}
+
+// a parked block of exactly this size, or NULL. ODE's large blocks come
+// in a handful of fixed sizes so exact matches are all that's needed
+static OdeMemHeader* unpark(size_t size)
+{
+	OdeMemHeader** link = &parked;
+	while (*link) {
+		OdeMemHeader* h = *link;
+		if (h->size == size) {
+			*link = *parkedNext(h);
+			return h;
+		}
+		link = parkedNext(h);
+	}
+	return NULL;
+}
+
+static void park(OdeMemHeader* h)
+{
+	*parkedNext(h) = parked;
+	parked = h;
+}
+
+static void* odeAlloc(dsizeint size)
+{
+	size_t total = size + sizeof(OdeMemHeader);
+	size_t c = classFor(total);
+	OdeMemHeader* h;
+
+	if (c == ODE_MEM_LARGE) {
+		h = unpark(size);
+		if (!h) h = malloc(total);
+		if (!h) {
+			printf("Couldn't allocate %zu bytes for ODE\n", (size_t)size);
+			exit(-1);
+		}
+	} else {
+		h = PoolAlloc(&classes[c]);
+	}
+	h->size = size;
+	h->sizeClass = c;
+
+	stats.liveBytes += size;
+	if (stats.liveBytes > stats.peakBytes) stats.peakBytes = stats.liveBytes;
+	stats.allocs++;
+	stats.stepAllocs++;
+	stats.stepBytes += size;
+	return h + 1;
+}
+
+static void odeFree(void* ptr, dsizeint size)
+{
+	(void)size; // the header is trusted over what ODE passes
+	if (!ptr) return;
+	OdeMemHeader* h = (OdeMemHeader*)ptr - 1;
+
+	stats.liveBytes -= h->size;
+	stats.frees++;
+	if (h->sizeClass == ODE_MEM_LARGE) {
+		if (h->size <= ODE_MEM_PARK_MAX) park(h);
+		else free(h);
+	} else {
+		PoolRelease(&classes[h->sizeClass], h);
+	}
+}
+
+static void* odeRealloc(void* ptr, dsizeint oldsize, dsizeint newsize)
+{
+	if (!ptr) return odeAlloc(newsize);
+	OdeMemHeader* h = (OdeMemHeader*)ptr - 1;
+
+	// still fits the same class, just adjust the books
+	if (h->sizeClass != ODE_MEM_LARGE &&
+		classFor(newsize + sizeof(OdeMemHeader)) == h->sizeClass) {
+		stats.liveBytes += newsize;
+		stats.liveBytes -= h->size;
+		if (stats.liveBytes > stats.peakBytes) stats.peakBytes = stats.liveBytes;
+		h->size = newsize;
+		return ptr;
+	}
+
+	void* p = odeAlloc(newsize);
+	memcpy(p, ptr, h->size < newsize ? h->size : newsize);
+	odeFree(ptr, oldsize);
+	return p;
+}
+
+/**
+ * @brief choose whether ODE's allocations go through the tracked handlers
+ *
+ * ODE uses its own allocator unless this is called with true before
+ * the first CreatePhysics. The handlers are what keep StepPhysics free
+ * of heap allocations once warmed up, but they are shared by every
+ * world and not thread safe, so don't ask for them if worlds are stepped
+ * on different threads. Once installed they stay until ReleaseOdeAllocator
+ * finds nothing of ODE's left.
+ *
+ * @param enable true to track allocations
+ */
+void TrackOdeAllocations(bool enable)
+{
+	wanted = enable;
+}
+
+/**
+ * @brief has TrackOdeAllocations asked for the tracked allocator
+ */
+bool OdeAllocatorWanted(void)
+{
+	return wanted;
+}
+
+/**
+ * @brief install the tracked handlers, must be called before dInitODE2
+ *
+ * Calling this again once installed does nothing
+ */
+void InstallOdeAllocator(void)
+{
+	if (stats.installed) return;
+
+	size_t s = ODE_MEM_SMALLEST;
+	for (int i = 0; i < ODE_MEM_CLASSES; i++) {
+		// keep a page of each class around 16k
+		int perPage = (int)(16384 / s);
+		PoolInit(&classes[i], classNames[i], s, perPage < 4 ? 4 : perPage, NULL);
+		s *= 2;
+	}
+
+	dSetAllocHandler(odeAlloc);
+	dSetReallocHandler(odeRealloc);
+	dSetFreeHandler(odeFree);
+	stats.installed = true;
+}
+
+/**
+ * @brief give the parked blocks back and, once ODE holds nothing, the
+ * size class pools and handlers too
+ *
+ * FreePhysics calls this after dCloseODE. While another context still
+ * has ODE objects alive only the parked blocks can go, the handlers stay
+ * until the last of them is freed. Statistics are cleared along with the
+ * handlers, a later CreatePhysics installs them again if still wanted.
+ */
+void ReleaseOdeAllocator(void)
+{
+	while (parked) {
+		OdeMemHeader* h = parked;
+		parked = *parkedNext(h);
+		free(h);
+	}
+	if (!stats.installed || stats.liveBytes) return;
+
+	dSetAllocHandler(NULL);
+	dSetReallocHandler(NULL);
+	dSetFreeHandler(NULL);
+	for (int i = 0; i < ODE_MEM_CLASSES; i++) {
+		PoolFree(&classes[i]);
+	}
+	memset(&stats, 0, sizeof(OdeMemStats));
+}
+
+/**
+ * @brief start counting allocations for a StepPhysics call
+ */
+void OdeMemStepBegin(void)
+{
+	stats.stepAllocs = 0;
+	stats.stepBytes = 0;
+}
+
+/**
+ * @brief finish counting allocations for a StepPhysics call
+ *
+ * @param steps how many world steps were taken
+ */
+void OdeMemStepEnd(int steps)
+{
+	stats.steps = steps;
+}
+
+/**
+ * @brief get a copy of the current statistics
+ */
+OdeMemStats GetOdeMemStats(void)
+{
+	return stats;
+}
+
+/**
+ * @brief print the statistics along with the size class pools
+ */
+void PrintOdeMemStats(void)
+{
+	if (!stats.installed) {
+		printf("ODE allocations are not being tracked\n");
+		return;
+	}
+	printf("ODE live %zu bytes  peak %zu bytes  allocs %lu  frees %lu\n",
+		stats.liveBytes, stats.peakBytes, stats.allocs, stats.frees);
+	printf("last step: %lu allocs, %zu bytes over %i world steps\n",
+		stats.stepAllocs, stats.stepBytes, stats.steps);
+	for (int i = 0; i < ODE_MEM_CLASSES; i++) {
+		if (classes[i].highWater) PoolPrintUsage(&classes[i]);
+	}
+}
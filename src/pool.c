@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file pool.c
+ * @brief Fixed size slab pool with a free list
+ *
+ * Used by the physics context for geomInfo and list nodes, both of which
+ * are created and destroyed constantly in scenes that respawn objects.
+ *
+ * @author Chris Camacho (codifies - http://bedroomcoders.co.uk/)
+ * @date 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "pool.h"
+
+#define POOL_ALIGN 16
+
+/**
+ * @brief prepare an empty pool, no memory is allocated until first use
+ *
+ * @param pool the pool to initialise
+ * @param name a name to use when reporting usage
+ * @param itemSize size of each item (sizeof your struct)
+ * @param itemsPerPage how many items to allocate at once when the pool runs dry
+ * @param arena take pages from this arena, or NULL to use the heap
+ */
+void PoolInit(Pool* pool, const char* name, size_t itemSize, int itemsPerPage, Arena* arena)
+{
+	if (itemSize < sizeof(void*)) itemSize = sizeof(void*);
+	pool->name = name;
+	pool->itemSize = (itemSize + POOL_ALIGN - 1) & ~(size_t)(POOL_ALIGN - 1);
+	pool->itemsPerPage = itemsPerPage;
+	pool->pages = NULL;
+	pool->pageCount = 0;
+	pool->freeList = NULL;
+	pool->live = 0;
+	pool->highWater = 0;
+	pool->arena = arena;
+}
+
+// allocate a new page and thread all its items onto the free list
+static void poolGrow(Pool* pool)
+{
+	char* page;
+	if (pool->arena) {
+		// the arena owns the page, no need to remember it
+		page = ArenaAlloc(pool->arena, pool->itemSize * pool->itemsPerPage);
+		pool->pageCount++;
+	} else {
+		void** pages = realloc(pool->pages, (pool->pageCount + 1) * sizeof(void*));
+		page = malloc(pool->itemSize * pool->itemsPerPage);
+		if (!pages || !page) {
+			printf("Couldn't allocate memory for the %s pool\n", pool->name);
+			exit(-1);
+		}
+		pool->pages = pages;
+		pool->pages[pool->pageCount++] = page;
+	}
+
+	// push in reverse so items come out in address order
+	for (int i = pool->itemsPerPage - 1; i >= 0; i--) {
+		void* item = page + i * pool->itemSize;
+		*(void**)item = pool->freeList;
+		pool->freeList = item;
+	}
+}
+
+/**
+ * @brief take an item from the pool
+ *
+ * @param pool the pool
+ * @return an uninitialised item, the caller should clear it
+ */
+void* PoolAlloc(Pool* pool)
+{
+	if (!pool->freeList) poolGrow(pool);
+	void* item = pool->freeList;
+	pool->freeList = *(void**)item;
+	pool->live++;
+	if (pool->live > pool->highWater) pool->highWater = pool->live;
+	return item;
+}
+
+/**
+ * @brief make sure a number of items can be taken without growing
+ *
+ * Handy before creating a lot of objects at once, the pages are all
+ * allocated up front rather than as the pool runs dry
+ *
+ * @param pool the pool
+ * @param count how many more items will be wanted
+ */
+void PoolReserve(Pool* pool, int count)
+{
+	while (pool->pageCount * pool->itemsPerPage - pool->live < count) {
+		poolGrow(pool);
+	}
+}
+
+/**
+ * @brief give an item back to the pool
+ *
+ * @param pool the pool the item came from
+ * @param item the item to release
+ */
+void PoolRelease(Pool* pool, void* item)
+{
+	*(void**)item = pool->freeList;
+	pool->freeList = item;
+	pool->live--;
+}
+
+/**
+ * @brief release every page of the pool at once
+ *
+ * Any items still handed out become invalid, the pool can be used
+ * again afterwards. An arena backed pool only forgets its pages, they
+ * go when the arena is freed.
+ *
+ * @param pool the pool to empty
+ */
+void PoolFree(Pool* pool)
+{
+	for (int i = 0; pool->pages && i < pool->pageCount; i++) {
+		free(pool->pages[i]);
+	}
+	free(pool->pages);
+	pool->pages = NULL;
+	pool->pageCount = 0;
+	pool->freeList = NULL;
+	pool->live = 0;
+}
+
+/**
+ * @brief print how much of a pool is in use
+ *
+ * @param pool the pool to report on
+ */
+void PoolPrintUsage(Pool* pool)
+{
+	printf("%-10s live %6i  high water %6i  capacity %6i  (%zu bytes each)\n",
+		pool->name, pool->live, pool->highWater,
+		pool->pageCount * pool->itemsPerPage, pool->itemSize);
+}
@@ -0,0 +1,978 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file prefab.c
+ * @brief Capturing, saving, loading and stamping out prefabs
+ *
+ * Everything in a prefab is stored relative to its root, so stamping out
+ * a copy only has to rotate and offset the positions, anchors and axes,
+ * shape sizes, masses and joint limits are copied as they are.
+ *
+ * The file format is plain text, one item per line, blank lines and
+ * lines starting with # are ignored
+ * @code
+ * prefab <name>
+ * body  pos(3) rot(w x y z) mass centre(3) I11 I22 I33 I12 I13 I23 autoDisable finiteRotation
+ *       gravity linearDamping angularDamping maxAngularSpeed
+ * geom  body shape size(3) pos(3) rot(w x y z) texture surface collidable uvU uvV category collide
+ * joint type body1 body2 anchor(3) axis1(3) axis2(3) lo hi lo2 hi2 fmax fmax2 suspensionERP suspensionCFM
+ *       vel vel2 bounce erp cfm stopERP stopCFM kind
+ * @endcode
+ * body1, body2 and a geom's body are body indices in file order or world,
+ * the remaining words are the names in the tables below. Each item is on
+ * one line, the second lines above are only wrapped here. Older files
+ * without the values on the second lines still load, bodies get gravity
+ * and no damping and joints keep the world's ERP and CFM.
+ *
+ * @author Chris Camacho (codifies - http://bedroomcoders.co.uk/)
+ * @date 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "prefab.h"
+
+#define PREFAB_MAX_TOKENS 32
+
+static const char* textureNames[PREFAB_TEX_COUNT] = {
+	"none", "box0", "box1", "sphere0", "sphere1", "sphere2", "cylinder0", "cylinder1", "capsule0", "capsule1", "ground"
+};
+
+static const char* surfaceNames[SURFACE_COUNT] = {
+	"wood", "metal", "ice", "rubber", "earth"
+};
+
+#define SHAPE_NAMES 4
+static const char* shapeNames[SHAPE_NAMES] = { "box", "sphere", "cylinder", "capsule" };
+static const int shapeClasses[SHAPE_NAMES] = { dBoxClass, dSphereClass, dCylinderClass, dCapsuleClass };
+
+#define JOINT_NAMES 6
+static const char* jointNames[JOINT_NAMES] = { "ball", "hinge", "slider", "universal", "hinge2", "fixed" };
+static const int jointTypes[JOINT_NAMES] = {
+	dJointTypeBall, dJointTypeHinge, dJointTypeSlider, dJointTypeUniversal, dJointTypeHinge2, dJointTypeFixed
+};
+
+// JointKind names, "none" (PREFAB_NO_KIND) is handled separately
+static const char* kindNames[JOINT_KIND_COUNT] = {
+	"user", "rotor", "piston", "pin", "vehicle", "ragdoll"
+};
+
+static int findName(const char* const* names, int count, const char* name)
+{
+	for (int i = 0; i < count; i++) {
+		if (strcmp(names[i], name) == 0) return i;
+	}
+	return -1;
+}
+
+static const char* nameOf(const char* const* names, const int* values, int count, int value)
+{
+	for (int i = 0; i < count; i++) {
+		if (values[i] == value) return names[i];
+	}
+	return "?";
+}
+
+static void* growArray(void* array, int* capacity, int needed, size_t itemSize)
+{
+	if (needed <= *capacity) return array;
+	int cap = *capacity ? *capacity * 2 : 8;
+	while (cap < needed) cap *= 2;
+	void* p = RL_REALLOC(array, cap * itemSize);
+	if (!p) {
+		printf("Couldn't allocate memory for a prefab\n");
+		exit(-1);
+	}
+	*capacity = cap;
+	return p;
+}
+
+// out = R * v, ODE matrices are 3 rows of 4
+static void rotateVector(const dMatrix3 R, const dReal* v, dVector3 out)
+{
+	for (int i = 0; i < 3; i++) {
+		out[i] = R[i*4] * v[0] + R[i*4+1] * v[1] + R[i*4+2] * v[2];
+	}
+}
+
+static void transformPoint(const dMatrix3 R, Vector3 pos, const dReal* v, dVector3 out)
+{
+	rotateVector(R, v, out);
+	out[0] += pos.x;
+	out[1] += pos.y;
+	out[2] += pos.z;
+}
+
+static TextureHandle slotHandle(GraphicsContext* gfxCtx, int slot)
+{
+	switch (slot) {
+	case PREFAB_TEX_BOX0:		return gfxCtx->boxTextures[0];
+	case PREFAB_TEX_BOX1:		return gfxCtx->boxTextures[1];
+	case PREFAB_TEX_SPHERE0:	return gfxCtx->sphereTextures[0];
+	case PREFAB_TEX_SPHERE1:	return gfxCtx->sphereTextures[1];
+	case PREFAB_TEX_SPHERE2:	return gfxCtx->sphereTextures[2];
+	case PREFAB_TEX_CYLINDER0:	return gfxCtx->cylinderTextures[0];
+	case PREFAB_TEX_CYLINDER1:	return gfxCtx->cylinderTextures[1];
+	case PREFAB_TEX_CAPSULE0:	return gfxCtx->capsuleTextures[0];
+	case PREFAB_TEX_CAPSULE1:	return gfxCtx->capsuleTextures[1];
+	case PREFAB_TEX_GROUND:		return gfxCtx->groundTexture;
+	default:					return (TextureHandle){ 0 };
+	}
+}
+
+// the slot's texture, loading it if this is the first use
+static Texture* slotTexture(GraphicsContext* gfxCtx, int slot)
+{
+	return UseTexture(gfxCtx->assets, slotHandle(gfxCtx, slot));
+}
+
+/**
+ * @brief make an empty prefab
+ *
+ * @param name used to look it up once it's added to a context, at most 63 characters
+ */
+Prefab* CreatePrefab(const char* name)
+{
+	Prefab* pf = RL_CALLOC(1, sizeof(Prefab));
+	if (!pf) {
+		printf("Couldn't allocate memory for prefab %s\n", name);
+		exit(-1);
+	}
+	strncpy(pf->name, name, sizeof(pf->name) - 1);
+	return pf;
+}
+
+/**
+ * @brief free a prefab, don't free one that's been added to a context
+ */
+void FreePrefab(Prefab* pf)
+{
+	if (!pf) return;
+	RL_FREE(pf->bodies);
+	RL_FREE(pf->geoms);
+	RL_FREE(pf->joints);
+	RL_FREE(pf);
+}
+
+/** @brief append a body
+ * @return its index, used by geoms and joints to refer to it
+ */
+int PrefabAddBody(Prefab* pf, const PrefabBody* body)
+{
+	pf->bodies = growArray(pf->bodies, &pf->bodyCapacity, pf->bodyCount + 1, sizeof(PrefabBody));
+	pf->bodies[pf->bodyCount] = *body;
+	return pf->bodyCount++;
+}
+
+/** @brief append a geom, its body must already have been added
+ * @return the geom's index
+ */
+int PrefabAddGeom(Prefab* pf, const PrefabGeom* geom)
+{
+	pf->geoms = growArray(pf->geoms, &pf->geomCapacity, pf->geomCount + 1, sizeof(PrefabGeom));
+	pf->geoms[pf->geomCount] = *geom;
+	return pf->geomCount++;
+}
+
+/** @brief append a joint, its bodies must already have been added
+ * @return the joint's index
+ */
+int PrefabAddJoint(Prefab* pf, const PrefabJoint* joint)
+{
+	pf->joints = growArray(pf->joints, &pf->jointCapacity, pf->jointCount + 1, sizeof(PrefabJoint));
+	pf->joints[pf->jointCount] = *joint;
+	return pf->jointCount++;
+}
+
+static dReal getJointParam(dJointID joint, int type, int param)
+{
+	switch (type) {
+	case dJointTypeBall:		return dJointGetBallParam(joint, param);
+	case dJointTypeFixed:		return dJointGetFixedParam(joint, param);
+	case dJointTypeHinge:		return dJointGetHingeParam(joint, param);
+	case dJointTypeSlider:		return dJointGetSliderParam(joint, param);
+	case dJointTypeUniversal:	return dJointGetUniversalParam(joint, param);
+	case dJointTypeHinge2:		return dJointGetHinge2Param(joint, param);
+	default:					return 0;
+	}
+}
+
+static void setJointParam(dJointID joint, int type, int param, dReal value)
+{
+	switch (type) {
+	case dJointTypeBall:		dJointSetBallParam(joint, param, value); break;
+	case dJointTypeFixed:		dJointSetFixedParam(joint, param, value); break;
+	case dJointTypeHinge:		dJointSetHingeParam(joint, param, value); break;
+	case dJointTypeSlider:		dJointSetSliderParam(joint, param, value); break;
+	case dJointTypeUniversal:	dJointSetUniversalParam(joint, param, value); break;
+	case dJointTypeHinge2:		dJointSetHinge2Param(joint, param, value); break;
+	default: break;
+	}
+}
+
+// index of a body in the captured set, PREFAB_WORLD for 0 and -2 if it isn't there
+static int capturedBody(const dBodyID* bodies, int count, dBodyID bdy)
+{
+	if (!bdy) return PREFAB_WORLD;
+	for (int i = 0; i < count; i++) {
+		if (bodies[i] == bdy) return i;
+	}
+	return -2;
+}
+
+static void captureGeom(Prefab* pf, GraphicsContext* gfxCtx, dGeomID geom, int body, Vector3 root)
+{
+	PrefabGeom pg = { 0 };
+	pg.body = body;
+	pg.shape = dGeomGetClass(geom);
+
+	switch (pg.shape) {
+	case dBoxClass: {
+		dVector3 len;
+		dGeomBoxGetLengths(geom, len);
+		pg.size = (Vector3){ len[0], len[1], len[2] };
+		break;
+	}
+	case dSphereClass:
+		pg.size.x = dGeomSphereGetRadius(geom);
+		break;
+	case dCylinderClass:
+	case dCapsuleClass: {
+		dReal radius, length;
+		if (pg.shape == dCylinderClass) {
+			dGeomCylinderGetParams(geom, &radius, &length);
+		} else {
+			dGeomCapsuleGetParams(geom, &radius, &length);
+		}
+		pg.size = (Vector3){ radius, length, 0 };
+		break;
+	}
+	default:
+		printf("CapturePrefab: %s can't hold a geom of class %i, skipped\n", pf->name, pg.shape);
+		return;
+	}
+
+	if (body == PREFAB_WORLD) {
+		const dReal* p = dGeomGetPosition(geom);
+		pg.pos[0] = p[0] - root.x;
+		pg.pos[1] = p[1] - root.y;
+		pg.pos[2] = p[2] - root.z;
+		dGeomGetQuaternion(geom, pg.rot);
+	} else {
+		// a geom without an offset reports zero and identity
+		const dReal* p = dGeomGetOffsetPosition(geom);
+		pg.pos[0] = p[0];
+		pg.pos[1] = p[1];
+		pg.pos[2] = p[2];
+		dGeomGetOffsetQuaternion(geom, pg.rot);
+	}
+	pg.category = dGeomGetCategoryBits(geom);
+	pg.collide = dGeomGetCollideBits(geom);
+
+	geomInfo* gi = dGeomGetData(geom);
+	pg.collidable = gi ? gi->collidable : true;
+	pg.uvScaleU = gi ? gi->uvScaleU : 1.0f;
+	pg.uvScaleV = gi ? gi->uvScaleV : 1.0f;
+	pg.surface = SURFACE_EARTH;
+	if (gi && gi->surface >= gSurfaces && gi->surface < gSurfaces + SURFACE_COUNT) {
+		pg.surface = (unsigned char)(gi->surface - gSurfaces);
+	}
+	pg.texture = PREFAB_TEX_NONE;
+	if (gi && gi->texture) {
+		// compared by handle so the slots' textures aren't all loaded
+		TextureHandle h = TextureHandleOf(gfxCtx->assets, gi->texture);
+		for (int s = PREFAB_TEX_NONE + 1; h.id && s < PREFAB_TEX_COUNT; s++) {
+			if (slotHandle(gfxCtx, s).id == h.id) pg.texture = (unsigned char)s;
+		}
+		if (pg.texture == PREFAB_TEX_NONE) {
+			printf("CapturePrefab: %s has a geom with a texture of its own, it will be invisible\n", pf->name);
+		}
+	}
+
+	PrefabAddGeom(pf, &pg);
+}
+
+static void captureJoint(PhysicsContext* ctx, Prefab* pf, dJointID joint, const dBodyID* bodies, int bodyCount, Vector3 root)
+{
+	PrefabJoint pj = { 0 };
+	pj.type = dJointGetType(joint);
+	pj.body1 = capturedBody(bodies, bodyCount, dJointGetBody(joint, 0));
+	pj.body2 = capturedBody(bodies, bodyCount, dJointGetBody(joint, 1));
+	if (pj.body1 < PREFAB_WORLD || pj.body2 < PREFAB_WORLD) {
+		printf("CapturePrefab: %s has a joint to a body that wasn't captured, skipped\n", pf->name);
+		return;
+	}
+
+	dVector3 anchor = { 0, 0, 0, 0 };
+	bool anchored = true;
+	switch (pj.type) {
+	case dJointTypeBall:
+		dJointGetBallAnchor(joint, anchor);
+		break;
+	case dJointTypeHinge:
+		dJointGetHingeAnchor(joint, anchor);
+		dJointGetHingeAxis(joint, pj.axis1);
+		break;
+	case dJointTypeSlider:
+		dJointGetSliderAxis(joint, pj.axis1);
+		anchored = false;
+		break;
+	case dJointTypeUniversal:
+		dJointGetUniversalAnchor(joint, anchor);
+		dJointGetUniversalAxis1(joint, pj.axis1);
+		dJointGetUniversalAxis2(joint, pj.axis2);
+		break;
+	case dJointTypeHinge2:
+		dJointGetHinge2Anchor(joint, anchor);
+		dJointGetHinge2Axis1(joint, pj.axis1);
+		dJointGetHinge2Axis2(joint, pj.axis2);
+		break;
+	case dJointTypeFixed:
+		anchored = false;
+		break;
+	default:
+		printf("CapturePrefab: %s can't hold a joint of type %i, skipped\n", pf->name, pj.type);
+		return;
+	}
+	if (anchored) {
+		pj.anchor[0] = anchor[0] - root.x;
+		pj.anchor[1] = anchor[1] - root.y;
+		pj.anchor[2] = anchor[2] - root.z;
+	}
+
+	pj.lo = getJointParam(joint, pj.type, dParamLoStop);
+	pj.hi = getJointParam(joint, pj.type, dParamHiStop);
+	pj.fmax = getJointParam(joint, pj.type, dParamFMax);
+	pj.vel = getJointParam(joint, pj.type, dParamVel);
+	pj.bounce = getJointParam(joint, pj.type, dParamBounce);
+	pj.erp = getJointParam(joint, pj.type, dParamERP);
+	pj.cfm = getJointParam(joint, pj.type, dParamCFM);
+	pj.stopERP = getJointParam(joint, pj.type, dParamStopERP);
+	pj.stopCFM = getJointParam(joint, pj.type, dParamStopCFM);
+	if (pj.type == dJointTypeUniversal || pj.type == dJointTypeHinge2) {
+		pj.lo2 = getJointParam(joint, pj.type, dParamLoStop2);
+		pj.hi2 = getJointParam(joint, pj.type, dParamHiStop2);
+		pj.fmax2 = getJointParam(joint, pj.type, dParamFMax2);
+		pj.vel2 = getJointParam(joint, pj.type, dParamVel2);
+	}
+	if (pj.type == dJointTypeHinge2) {
+		pj.suspensionERP = dJointGetHinge2Param(joint, dParamSuspensionERP);
+		pj.suspensionCFM = dJointGetHinge2Param(joint, dParamSuspensionCFM);
+	}
+
+	pj.kind = PREFAB_NO_KIND;
+	JointHandle h = GetJointHandle(joint);
+	int d = HandleTableFind(&ctx->joints.table, h.id);
+	if (d >= 0 && ctx->joints.joints[d] == joint) {
+		pj.kind = ctx->joints.kinds[d];
+	}
+
+	PrefabAddJoint(pf, &pj);
+}
+
+/**
+ * @brief record existing objects as a prefab
+ *
+ * Build one copy with the usual functions, capture it, then stamp out as
+ * many more as you like. The objects are left as they are.
+ *
+ * @param ctx physics context
+ * @param gfxCtx graphics context, geom textures must be some of its textures
+ * @param name the prefab's name
+ * @param root point everything is stored relative to, this is where pos puts it when stamping
+ * @param bodies the bodies, their geoms are captured with them, in the order they were made
+ * @param bodyCount number of bodies
+ * @param joints joints between the bodies or a body and the world
+ * @param jointCount number of joints
+ * @param statics static geoms, these are added to the statics list when stamped out
+ * @param staticCount number of static geoms
+ * @return the new prefab, free it or add it to a context
+ *
+ * @note box, sphere, cylinder and capsule geoms, and ball, hinge, slider,
+ * universal, hinge2 and fixed joints can be captured, others are skipped
+ */
+Prefab* CapturePrefab(PhysicsContext* ctx, GraphicsContext* gfxCtx, const char* name, Vector3 root,
+                      const dBodyID* bodies, int bodyCount, const dJointID* joints, int jointCount,
+                      const dGeomID* statics, int staticCount)
+{
+	Prefab* pf = CreatePrefab(name);
+
+	for (int i = 0; i < bodyCount; i++) {
+		dBodyID bdy = bodies[i];
+		PrefabBody pb;
+		const dReal* p = dBodyGetPosition(bdy);
+		const dReal* q = dBodyGetQuaternion(bdy);
+		pb.pos[0] = p[0] - root.x;
+		pb.pos[1] = p[1] - root.y;
+		pb.pos[2] = p[2] - root.z;
+		pb.pos[3] = 0;
+		memcpy(pb.rot, q, sizeof(dQuaternion));
+		dBodyGetMass(bdy, &pb.mass);
+		pb.autoDisable = dBodyGetAutoDisableFlag(bdy);
+		pb.finiteRotation = dBodyGetFiniteRotationMode(bdy);
+		pb.gravity = dBodyGetGravityMode(bdy);
+		pb.linearDamping = dBodyGetLinearDamping(bdy);
+		pb.angularDamping = dBodyGetAngularDamping(bdy);
+		dReal maxSpeed = dBodyGetMaxAngularSpeed(bdy);
+		pb.maxAngularSpeed = maxSpeed < dInfinity ? maxSpeed : 0;
+		PrefabAddBody(pf, &pb);
+	}
+
+	// ODE keeps a body's geoms newest first, they're stored oldest first so
+	// stamping makes them in the original order
+	for (int i = 0; i < bodyCount; i++) {
+		int n = 0;
+		for (dGeomID g = dBodyGetFirstGeom(bodies[i]); g; g = dBodyGetNextGeom(g)) n++;
+		for (int k = n - 1; k >= 0; k--) {
+			dGeomID g = dBodyGetFirstGeom(bodies[i]);
+			for (int s = 0; s < k; s++) g = dBodyGetNextGeom(g);
+			captureGeom(pf, gfxCtx, g, i, root);
+		}
+	}
+	for (int i = 0; i < staticCount; i++) {
+		captureGeom(pf, gfxCtx, statics[i], PREFAB_WORLD, root);
+	}
+
+	for (int i = 0; i < jointCount; i++) {
+		captureJoint(ctx, pf, joints[i], bodies, bodyCount, root);
+	}
+
+	return pf;
+}
+
+/**
+ * @brief write a prefab to a text file, see prefab.c for the format
+ *
+ * @return false if the file couldn't be written
+ */
+bool SavePrefab(const Prefab* pf, const char* path)
+{
+	FILE* f = fopen(path, "w");
+	if (!f) {
+		printf("SavePrefab: couldn't open %s\n", path);
+		return false;
+	}
+
+	fprintf(f, "prefab %s\n\n", pf->name);
+
+	fprintf(f, "# body pos(3) rot(w x y z) mass centre(3) I11 I22 I33 I12 I13 I23 autoDisable finiteRotation "
+	           "gravity linearDamping angularDamping maxAngularSpeed\n");
+	for (int i = 0; i < pf->bodyCount; i++) {
+		const PrefabBody* b = &pf->bodies[i];
+		const dMass* m = &b->mass;
+		fprintf(f, "body %.9g %.9g %.9g  %.9g %.9g %.9g %.9g  %.9g  %.9g %.9g %.9g  "
+		           "%.9g %.9g %.9g %.9g %.9g %.9g  %i %i  %i %.9g %.9g %.9g\n",
+		        b->pos[0], b->pos[1], b->pos[2],
+		        b->rot[0], b->rot[1], b->rot[2], b->rot[3],
+		        m->mass, m->c[0], m->c[1], m->c[2],
+		        m->I[0], m->I[5], m->I[10], m->I[1], m->I[2], m->I[6],
+		        b->autoDisable, b->finiteRotation,
+		        b->gravity, b->linearDamping, b->angularDamping, b->maxAngularSpeed);
+	}
+
+	fprintf(f, "\n# geom body shape size(3) pos(3) rot(w x y z) texture surface collidable uvU uvV category collide\n");
+	for (int i = 0; i < pf->geomCount; i++) {
+		const PrefabGeom* g = &pf->geoms[i];
+		if (g->body == PREFAB_WORLD) {
+			fprintf(f, "geom world ");
+		} else {
+			fprintf(f, "geom %i ", g->body);
+		}
+		fprintf(f, "%s  %.9g %.9g %.9g  %.9g %.9g %.9g  %.9g %.9g %.9g %.9g  %s %s %i  %.9g %.9g  0x%lx 0x%lx\n",
+		        nameOf(shapeNames, shapeClasses, SHAPE_NAMES, g->shape),
+		        g->size.x, g->size.y, g->size.z,
+		        g->pos[0], g->pos[1], g->pos[2],
+		        g->rot[0], g->rot[1], g->rot[2], g->rot[3],
+		        textureNames[g->texture], surfaceNames[g->surface], g->collidable,
+		        g->uvScaleU, g->uvScaleV, g->category, g->collide);
+	}
+
+	fprintf(f, "\n# joint type body1 body2 anchor(3) axis1(3) axis2(3) lo hi lo2 hi2 fmax fmax2 suspensionERP suspensionCFM "
+	           "vel vel2 bounce erp cfm stopERP stopCFM kind\n");
+	for (int i = 0; i < pf->jointCount; i++) {
+		const PrefabJoint* j = &pf->joints[i];
+		fprintf(f, "joint %s ", nameOf(jointNames, jointTypes, JOINT_NAMES, j->type));
+		const int ends[2] = { j->body1, j->body2 };
+		for (int e = 0; e < 2; e++) {
+			if (ends[e] == PREFAB_WORLD) {
+				fprintf(f, "world ");
+			} else {
+				fprintf(f, "%i ", ends[e]);
+			}
+		}
+		fprintf(f, " %.9g %.9g %.9g  %.9g %.9g %.9g  %.9g %.9g %.9g  %.9g %.9g %.9g %.9g  %.9g %.9g  %.9g %.9g  "
+		           "%.9g %.9g %.9g  %.9g %.9g %.9g %.9g  %s\n",
+		        j->anchor[0], j->anchor[1], j->anchor[2],
+		        j->axis1[0], j->axis1[1], j->axis1[2],
+		        j->axis2[0], j->axis2[1], j->axis2[2],
+		        j->lo, j->hi, j->lo2, j->hi2, j->fmax, j->fmax2,
+		        j->suspensionERP, j->suspensionCFM,
+		        j->vel, j->vel2, j->bounce, j->erp, j->cfm, j->stopERP, j->stopCFM,
+		        j->kind == PREFAB_NO_KIND ? "none" : kindNames[j->kind]);
+	}
+
+	bool ok = !ferror(f);
+	fclose(f);
+	return ok;
+}
+
+// splits a line into whitespace separated tokens in place, stops at a #
+static int tokenize(char* line, char** tokens, int max)
+{
+	int n = 0;
+	char* s = line;
+	while (n < max) {
+		while (*s && isspace((unsigned char)*s)) s++;
+		if (!*s || *s == '#') break;
+		tokens[n++] = s;
+		while (*s && !isspace((unsigned char)*s)) s++;
+		if (*s) *s++ = 0;
+	}
+	return n;
+}
+
+static void readFloats(char** tokens, float* out, int n)
+{
+	for (int i = 0; i < n; i++) out[i] = strtof(tokens[i], NULL);
+}
+
+// a body index or world, -2 when it's neither
+static int readBodyIndex(const Prefab* pf, const char* token)
+{
+	if (strcmp(token, "world") == 0) return PREFAB_WORLD;
+	char* end;
+	long i = strtol(token, &end, 10);
+	if (*end || i < 0 || i >= pf->bodyCount) return -2;
+	return (int)i;
+}
+
+static const char* parseBody(Prefab* pf, char** t, int n)
+{
+	if (n != 20 && n != 24) return "a body needs 23 values (19 in older files)";
+	float v[23] = { 0 };
+	v[19] = 1; // gravity when it isn't given
+	readFloats(t + 1, v, n - 1);
+	PrefabBody pb;
+	pb.pos[0] = v[0];
+	pb.pos[1] = v[1];
+	pb.pos[2] = v[2];
+	pb.pos[3] = 0;
+	for (int i = 0; i < 4; i++) pb.rot[i] = v[3 + i];
+	dMassSetParameters(&pb.mass, v[7], v[8], v[9], v[10], v[11], v[12], v[13], v[14], v[15], v[16]);
+	pb.autoDisable = v[17] != 0;
+	pb.finiteRotation = v[18] != 0;
+	pb.gravity = v[19] != 0;
+	pb.linearDamping = v[20];
+	pb.angularDamping = v[21];
+	pb.maxAngularSpeed = v[22];
+	PrefabAddBody(pf, &pb);
+	return NULL;
+}
+
+static const char* parseGeom(Prefab* pf, char** t, int n)
+{
+	if (n != 20) return "a geom needs 19 values";
+	PrefabGeom pg = { 0 };
+	pg.body = readBodyIndex(pf, t[1]);
+	if (pg.body < PREFAB_WORLD) return "unknown body";
+	int shape = findName(shapeNames, SHAPE_NAMES, t[2]);
+	if (shape < 0) return "unknown shape";
+	pg.shape = shapeClasses[shape];
+
+	float v[10];
+	readFloats(t + 3, v, 10);
+	pg.size = (Vector3){ v[0], v[1], v[2] };
+	for (int i = 0; i < 3; i++) pg.pos[i] = v[3 + i];
+	for (int i = 0; i < 4; i++) pg.rot[i] = v[6 + i];
+
+	int texture = findName(textureNames, PREFAB_TEX_COUNT, t[13]);
+	if (texture < 0) return "unknown texture";
+	int surface = findName(surfaceNames, SURFACE_COUNT, t[14]);
+	if (surface < 0) return "unknown surface";
+	pg.texture = (unsigned char)texture;
+	pg.surface = (unsigned char)surface;
+	pg.collidable = strtol(t[15], NULL, 10) != 0;
+	pg.uvScaleU = strtof(t[16], NULL);
+	pg.uvScaleV = strtof(t[17], NULL);
+	pg.category = strtoul(t[18], NULL, 0);
+	pg.collide = strtoul(t[19], NULL, 0);
+	PrefabAddGeom(pf, &pg);
+	return NULL;
+}
+
+static const char* parseJoint(Prefab* pf, char** t, int n)
+{
+	if (n != 22 && n != 29) return "a joint needs 28 values (21 in older files)";
+	PrefabJoint pj = { 0 };
+	int type = findName(jointNames, JOINT_NAMES, t[1]);
+	if (type < 0) return "unknown joint type";
+	pj.type = jointTypes[type];
+	pj.body1 = readBodyIndex(pf, t[2]);
+	pj.body2 = readBodyIndex(pf, t[3]);
+	if (pj.body1 < PREFAB_WORLD || pj.body2 < PREFAB_WORLD) return "unknown body";
+
+	float v[24] = { 0 };
+	readFloats(t + 4, v, n - 5);
+	for (int i = 0; i < 3; i++) {
+		pj.anchor[i] = v[i];
+		pj.axis1[i] = v[3 + i];
+		pj.axis2[i] = v[6 + i];
+	}
+	pj.lo = v[9];
+	pj.hi = v[10];
+	pj.lo2 = v[11];
+	pj.hi2 = v[12];
+	pj.fmax = v[13];
+	pj.fmax2 = v[14];
+	pj.suspensionERP = v[15];
+	pj.suspensionCFM = v[16];
+	pj.vel = v[17];
+	pj.vel2 = v[18];
+	pj.bounce = v[19];
+	pj.erp = v[20];
+	pj.cfm = v[21];
+	pj.stopERP = v[22];
+	pj.stopCFM = v[23];
+
+	const char* kind = t[n - 1];
+	if (strcmp(kind, "none") == 0) {
+		pj.kind = PREFAB_NO_KIND;
+	} else {
+		pj.kind = findName(kindNames, JOINT_KIND_COUNT, kind);
+		if (pj.kind < 0) return "unknown joint kind";
+	}
+	PrefabAddJoint(pf, &pj);
+	return NULL;
+}
+
+/**
+ * @brief read a prefab written by SavePrefab, or by hand
+ *
+ * @param path the file
+ * @return the prefab or NULL if the file is missing or malformed, the
+ * problem is printed
+ */
+Prefab* LoadPrefab(const char* path)
+{
+	FILE* f = fopen(path, "r");
+	if (!f) {
+		printf("LoadPrefab: couldn't open %s\n", path);
+		return NULL;
+	}
+
+	Prefab* pf = NULL;
+	const char* error = NULL;
+	char line[1024];
+	int lineNo = 0;
+	while (!error && fgets(line, sizeof(line), f)) {
+		lineNo++;
+		char* t[PREFAB_MAX_TOKENS];
+		int n = tokenize(line, t, PREFAB_MAX_TOKENS);
+		if (n == 0) continue;
+
+		if (strcmp(t[0], "prefab") == 0) {
+			if (pf) error = "a file holds a single prefab";
+			else if (n != 2) error = "prefab needs a name";
+			else pf = CreatePrefab(t[1]);
+		} else if (!pf) {
+			error = "the first line must name the prefab";
+		} else if (strcmp(t[0], "body") == 0) {
+			error = parseBody(pf, t, n);
+		} else if (strcmp(t[0], "geom") == 0) {
+			error = parseGeom(pf, t, n);
+		} else if (strcmp(t[0], "joint") == 0) {
+			error = parseJoint(pf, t, n);
+		} else {
+			error = "unknown item";
+		}
+	}
+	fclose(f);
+
+	if (!error && !pf) error = "no prefab";
+	if (error) {
+		printf("LoadPrefab: %s:%i %s\n", path, lineNo, error);
+		FreePrefab(pf);
+		return NULL;
+	}
+	return pf;
+}
+
+/**
+ * @brief hand a prefab to the context so it can be found by name
+ *
+ * The context frees it in FreePhysics. If there's already a prefab with
+ * the same name that one is kept and the new one freed, so it's safe to
+ * call this with a prefab loaded from a file before code that would
+ * otherwise build its own.
+ *
+ * @return the prefab now held under that name
+ */
+Prefab* AddPrefab(PhysicsContext* ctx, Prefab* pf)
+{
+	Prefab* existing = GetPrefab(ctx, pf->name);
+	if (existing) {
+		if (existing != pf) FreePrefab(pf);
+		return existing;
+	}
+	clistAddNode(ctx->prefabs, pf);
+	return pf;
+}
+
+/**
+ * @brief look up a prefab added to the context
+ *
+ * @return the prefab or NULL
+ */
+Prefab* GetPrefab(PhysicsContext* ctx, const char* name)
+{
+	for (cnode_t* node = ctx->prefabs->head; node; node = node->next) {
+		Prefab* pf = node->data;
+		if (strcmp(pf->name, name) == 0) return pf;
+	}
+	return NULL;
+}
+
+/**
+ * @brief free every prefab the context holds, FreePhysics calls this
+ */
+void FreePrefabs(PhysicsContext* ctx)
+{
+	for (cnode_t* node = ctx->prefabs->head; node; node = node->next) {
+		FreePrefab(node->data);
+	}
+	clistEmptyList(ctx->prefabs);
+}
+
+static dGeomID createShape(dSpaceID space, const PrefabGeom* pg)
+{
+	switch (pg->shape) {
+	case dBoxClass:			return dCreateBox(space, pg->size.x, pg->size.y, pg->size.z);
+	case dSphereClass:		return dCreateSphere(space, pg->size.x);
+	case dCylinderClass:	return dCreateCylinder(space, pg->size.x, pg->size.y);
+	default:				return dCreateCapsule(space, pg->size.x, pg->size.y);
+	}
+}
+
+static dJointID createJoint(dWorldID world, int type)
+{
+	switch (type) {
+	case dJointTypeBall:		return dJointCreateBall(world, 0);
+	case dJointTypeHinge:		return dJointCreateHinge(world, 0);
+	case dJointTypeSlider:		return dJointCreateSlider(world, 0);
+	case dJointTypeUniversal:	return dJointCreateUniversal(world, 0);
+	case dJointTypeHinge2:		return dJointCreateHinge2(world, 0);
+	default:					return dJointCreateFixed(world, 0);
+	}
+}
+
+/**
+ * @brief build a copy of a prefab into arrays you provide
+ *
+ * The bodies are registered as entities and the joints with their kind,
+ * static geoms go on the statics list.
+ *
+ * @param ctx physics context
+ * @param gfxCtx graphics context supplying the textures
+ * @param pf the prefab
+ * @param pos where the prefab's root goes
+ * @param rot rotation about the root
+ * @param bodies receives pf->bodyCount bodies
+ * @param geoms receives pf->geomCount geoms, may be NULL
+ * @param joints receives pf->jointCount joints, may be NULL
+ */
+void StampPrefab(PhysicsContext* ctx, GraphicsContext* gfxCtx, const Prefab* pf, Vector3 pos, Quaternion rot,
+                 dBodyID* bodies, dGeomID* geoms, dJointID* joints)
+{
+	dQuaternion q = { rot.w, rot.x, rot.y, rot.z };
+	dMatrix3 R;
+	dQtoR(q, R);
+
+	for (int i = 0; i < pf->bodyCount; i++) {
+		const PrefabBody* pb = &pf->bodies[i];
+		dBodyID bdy = dBodyCreate(ctx->world);
+		dBodySetMass(bdy, &pb->mass);
+		dVector3 p;
+		transformPoint(R, pos, pb->pos, p);
+		dBodySetPosition(bdy, p[0], p[1], p[2]);
+		dQuaternion bq;
+		dQMultiply0(bq, q, pb->rot);
+		dBodySetQuaternion(bdy, bq);
+		dBodySetAutoDisableFlag(bdy, pb->autoDisable);
+		dBodySetFiniteRotationMode(bdy, pb->finiteRotation);
+		dBodySetGravityMode(bdy, pb->gravity);
+		dBodySetLinearDamping(bdy, pb->linearDamping);
+		dBodySetAngularDamping(bdy, pb->angularDamping);
+		dBodySetMaxAngularSpeed(bdy, pb->maxAngularSpeed > 0 ? pb->maxAngularSpeed : dInfinity);
+		bodies[i] = bdy;
+	}
+
+	for (int i = 0; i < pf->geomCount; i++) {
+		const PrefabGeom* pg = &pf->geoms[i];
+		dGeomID geom = createShape(ctx->space, pg);
+		if (pg->body == PREFAB_WORLD) {
+			dVector3 p;
+			transformPoint(R, pos, pg->pos, p);
+			dGeomSetPosition(geom, p[0], p[1], p[2]);
+			dQuaternion gq;
+			dQMultiply0(gq, q, pg->rot);
+			dGeomSetQuaternion(geom, gq);
+			clistAddNode(ctx->statics, geom);
+		} else {
+			dGeomSetBody(geom, bodies[pg->body]);
+			// only give the geom an offset if it has one, ODE allocates for it
+			bool moved = pg->pos[0] != 0 || pg->pos[1] != 0 || pg->pos[2] != 0;
+			bool turned = pg->rot[0] != 1 || pg->rot[1] != 0 || pg->rot[2] != 0 || pg->rot[3] != 0;
+			if (moved) dGeomSetOffsetPosition(geom, pg->pos[0], pg->pos[1], pg->pos[2]);
+			if (turned) dGeomSetOffsetQuaternion(geom, pg->rot);
+		}
+		dGeomSetCategoryBits(geom, pg->category);
+		dGeomSetCollideBits(geom, pg->collide);
+		geomInfo* gi = CreateGeomInfo(ctx, pg->collidable, slotTexture(gfxCtx, pg->texture), pg->uvScaleU, pg->uvScaleV);
+		gi->surface = &gSurfaces[pg->surface];
+		dGeomSetData(geom, gi);
+		if (geoms) geoms[i] = geom;
+	}
+
+	for (int i = 0; i < pf->bodyCount; i++) {
+		AttachEntity(ctx, bodies[i]);
+	}
+
+	for (int i = 0; i < pf->jointCount; i++) {
+		const PrefabJoint* pj = &pf->joints[i];
+		dJointID joint = createJoint(ctx->world, pj->type);
+		dBodyID b1 = pj->body1 == PREFAB_WORLD ? 0 : bodies[pj->body1];
+		dBodyID b2 = pj->body2 == PREFAB_WORLD ? 0 : bodies[pj->body2];
+		dJointAttach(joint, b1, b2);
+
+		dVector3 anchor, axis1, axis2;
+		transformPoint(R, pos, pj->anchor, anchor);
+		rotateVector(R, pj->axis1, axis1);
+		rotateVector(R, pj->axis2, axis2);
+
+		switch (pj->type) {
+		case dJointTypeBall:
+			dJointSetBallAnchor(joint, anchor[0], anchor[1], anchor[2]);
+			break;
+		case dJointTypeHinge:
+			dJointSetHingeAnchor(joint, anchor[0], anchor[1], anchor[2]);
+			dJointSetHingeAxis(joint, axis1[0], axis1[1], axis1[2]);
+			break;
+		case dJointTypeSlider:
+			dJointSetSliderAxis(joint, axis1[0], axis1[1], axis1[2]);
+			break;
+		case dJointTypeUniversal:
+			dJointSetUniversalAnchor(joint, anchor[0], anchor[1], anchor[2]);
+			dJointSetUniversalAxis1(joint, axis1[0], axis1[1], axis1[2]);
+			dJointSetUniversalAxis2(joint, axis2[0], axis2[1], axis2[2]);
+			break;
+		case dJointTypeHinge2:
+			dJointSetHinge2Anchor(joint, anchor[0], anchor[1], anchor[2]);
+			dJointSetHinge2Axes(joint, axis1, axis2);
+			dJointSetHinge2Param(joint, dParamSuspensionERP, pj->suspensionERP);
+			dJointSetHinge2Param(joint, dParamSuspensionCFM, pj->suspensionCFM);
+			break;
+		default:
+			dJointSetFixed(joint);
+			break;
+		}
+
+		setJointParam(joint, pj->type, dParamLoStop, pj->lo);
+		setJointParam(joint, pj->type, dParamHiStop, pj->hi);
+		setJointParam(joint, pj->type, dParamFMax, pj->fmax);
+		setJointParam(joint, pj->type, dParamVel, pj->vel);
+		setJointParam(joint, pj->type, dParamBounce, pj->bounce);
+		if (pj->erp != 0) setJointParam(joint, pj->type, dParamERP, pj->erp);
+		if (pj->cfm != 0) setJointParam(joint, pj->type, dParamCFM, pj->cfm);
+		if (pj->stopERP != 0) setJointParam(joint, pj->type, dParamStopERP, pj->stopERP);
+		if (pj->stopCFM != 0) setJointParam(joint, pj->type, dParamStopCFM, pj->stopCFM);
+		if (pj->type == dJointTypeUniversal || pj->type == dJointTypeHinge2) {
+			setJointParam(joint, pj->type, dParamLoStop2, pj->lo2);
+			setJointParam(joint, pj->type, dParamHiStop2, pj->hi2);
+			setJointParam(joint, pj->type, dParamFMax2, pj->fmax2);
+			setJointParam(joint, pj->type, dParamVel2, pj->vel2);
+		}
+
+		if (pj->kind != PREFAB_NO_KIND) RegisterJoint(ctx, joint, (JointKind)pj->kind);
+		if (joints) joints[i] = joint;
+	}
+}
+
+/**
+ * @brief build a copy of a prefab
+ *
+ * @param ctx physics context
+ * @param gfxCtx graphics context supplying the textures
+ * @param pf the prefab, it must outlive the instance
+ * @param pos where the prefab's root goes
+ * @param rot rotation about the root
+ * @return the instance, free it with FreePrefabInstance
+ */
+PrefabInstance* InstantiatePrefab(PhysicsContext* ctx, GraphicsContext* gfxCtx, const Prefab* pf, Vector3 pos, Quaternion rot)
+{
+	// one allocation, the arrays follow the struct
+	size_t size = sizeof(PrefabInstance) + pf->bodyCount * sizeof(dBodyID)
+	            + pf->geomCount * sizeof(dGeomID) + pf->jointCount * sizeof(dJointID);
+	PrefabInstance* inst = RL_MALLOC(size);
+	if (!inst) {
+		printf("Couldn't allocate memory for an instance of prefab %s\n", pf->name);
+		exit(-1);
+	}
+	inst->prefab = pf;
+	inst->bodies = (dBodyID*)(inst + 1);
+	inst->geoms = (dGeomID*)(inst->bodies + pf->bodyCount);
+	inst->joints = (dJointID*)(inst->geoms + pf->geomCount);
+
+	StampPrefab(ctx, gfxCtx, pf, pos, rot, inst->bodies, inst->geoms, inst->joints);
+	return inst;
+}
+
+/**
+ * @brief destroy everything an instance made
+ *
+ * @param ctx physics context
+ * @param inst the instance
+ */
+void FreePrefabInstance(PhysicsContext* ctx, PrefabInstance* inst)
+{
+	if (!inst) return;
+	const Prefab* pf = inst->prefab;
+
+	for (int i = 0; i < pf->jointCount; i++) {
+		FreeJoint(ctx, inst->joints[i]);
+	}
+	for (int i = 0; i < pf->geomCount; i++) {
+		dGeomID geom = inst->geoms[i];
+		if (dGeomGetBody(geom)) continue; // freed with its body
+		clistDeleteNodeFromData(ctx->statics, geom);
+		FreeGeomInfo(ctx, dGeomGetData(geom));
+		dGeomDestroy(geom);
+	}
+	for (int i = 0; i < pf->bodyCount; i++) {
+		FreeEntity(ctx, GetBodyEntity(ctx, inst->bodies[i]));
+	}
+	RL_FREE(inst);
+}
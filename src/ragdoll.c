@@ -57,8 +57,11 @@
  * Use UpdateRagdollMotors() to apply forces to joints.
  */
 
+#include <stdio.h>
+
 #include "raylibODE.h"
 #include "ragdoll.h"
+#include "prefab.h"
 
 // Get a spawn position within the defined ragdoll spawn volume
 
@@ -88,37 +91,14 @@ Vector3 GetRagdollSpawnPosition(void)
 }
 
 
-// Rag doll creation 
-// Creates a humanoid rag doll with configurable joint motors
+// Rag doll construction by hand, this is only done once to make the
+// template that CreateRagdoll stamps copies from
 // actually way more complex than the vehicle stuff !
-
-/**
- * @brief Create a ragdoll physics body
- *
- * Creates a complete humanoid ragdoll with articulated joints.
- * The ragdoll is fully physics-simulated and can be used for
- * character physics, death animations, or as a basis for
- * reinforcement learning control.
- *
- * @param pctx Pointer to physics context
- * @param ctx Pointer to graphics context
- * @param position Initial position for the ragdoll
- * @return Pointer to newly created RagDoll structure
- *
- * @note Bodies: 10 (head, torso, 2 upper arms, 2 lower arms, 2 upper legs, 2 lower legs)
- * @note Joints: 9 (neck, shoulders, elbows, hips, knees)
- * @note All bodies are registered with framework for rendering
- *
- * @see RagDoll
- * @see UpdateRagdollMotors
- * @see DrawRagdoll
- * @see FreeRagdoll
- */
-RagDoll* CreateRagdoll(struct PhysicsContext* pctx, struct GraphicsContext* ctx, Vector3 position)
+static RagDoll* buildRagdoll(struct PhysicsContext* pctx, struct GraphicsContext* ctx, Vector3 position)
 {
     RagDoll *ragdoll = RL_MALLOC(sizeof(RagDoll));
     ragdoll->bodyCount = RAGDOLL_BODY_COUNT;
-    ragdoll->jointCount = 9;  // neck, shoulders, elbows, hips, knees
+    ragdoll->jointCount = RAGDOLL_JOINT_COUNT;
     ragdoll->motorCount = 0;  // No motors initially, can be added for neural network control
 
     // Allocate arrays for bodies, geoms, joints, and motors
@@ -141,9 +121,9 @@ RagDoll* CreateRagdoll(struct PhysicsContext* pctx, struct GraphicsContext* ctx,
     float legRadius = 0.12f;
 
     // Ragdoll specific textures (consistent across all ragdolls)
-    Texture* headTex = &ctx->sphereTextures[1];        // beach-ball.png
-    Texture* torsoTex = &ctx->boxTextures[0];         // crate.png
-    Texture* limbTex = &ctx->cylinderTextures[1];     // cylinder2.png
+    Texture* headTex = UseTexture(ctx->assets, ctx->sphereTextures[1]);    // beach-ball.png
+    Texture* torsoTex = UseTexture(ctx->assets, ctx->boxTextures[0]);      // crate.png
+    Texture* limbTex = UseTexture(ctx->assets, ctx->capsuleTextures[1]);   // generated checks
 
     // Create head
     dMassSetSphere(&m, 1, headRadius);
@@ -154,7 +134,7 @@ RagDoll* CreateRagdoll(struct PhysicsContext* pctx, struct GraphicsContext* ctx,
                      position.x, position.y + 1.6f, position.z);
     ragdoll->geoms[RAGDOLL_HEAD] = dCreateSphere(pctx->space, headRadius);
     dGeomSetBody(ragdoll->geoms[RAGDOLL_HEAD], ragdoll->bodies[RAGDOLL_HEAD]);
-    dGeomSetData(ragdoll->geoms[RAGDOLL_HEAD], CreateGeomInfo(true, headTex, 1.0f, 1.0f));
+    dGeomSetData(ragdoll->geoms[RAGDOLL_HEAD], CreateGeomInfo(pctx, true, headTex, 1.0f, 1.0f));
 
     // Create torso
     dMassSetBox(&m, 1, torsoWidth, torsoHeight, torsoDepth);
@@ -165,7 +145,7 @@ RagDoll* CreateRagdoll(struct PhysicsContext* pctx, struct GraphicsContext* ctx,
                      position.x, position.y + 0.9f, position.z);
     ragdoll->geoms[RAGDOLL_TORSO] = dCreateBox(pctx->space, torsoWidth, torsoHeight, torsoDepth);
     dGeomSetBody(ragdoll->geoms[RAGDOLL_TORSO], ragdoll->bodies[RAGDOLL_TORSO]);
-    dGeomSetData(ragdoll->geoms[RAGDOLL_TORSO], CreateGeomInfo(true, torsoTex, 1.0f, 1.0f));
+    dGeomSetData(ragdoll->geoms[RAGDOLL_TORSO], CreateGeomInfo(pctx, true, torsoTex, 1.0f, 1.0f));
 
     // Create arms - initialize mass for each individually
     // ODE cylinders are along Z-axis by default
@@ -185,7 +165,7 @@ RagDoll* CreateRagdoll(struct PhysicsContext* pctx, struct GraphicsContext* ctx,
     dGeomSetOffsetWorldRotation(ragdoll->geoms[RAGDOLL_LEFT_UPPER_ARM], R_arm);
     dBodySetPosition(ragdoll->bodies[RAGDOLL_LEFT_UPPER_ARM],
                      position.x - 0.35f, position.y + 1.1f, position.z);
-    dGeomSetData(ragdoll->geoms[RAGDOLL_LEFT_UPPER_ARM], CreateGeomInfo(true, limbTex, 1.0f, 1.0f));
+    dGeomSetData(ragdoll->geoms[RAGDOLL_LEFT_UPPER_ARM], CreateGeomInfo(pctx, true, limbTex, 1.0f, 1.0f));
 
     // Left lower arm
     dMassSetCylinder(&m, 1, 3, armRadius, armLength);
@@ -198,7 +178,7 @@ RagDoll* CreateRagdoll(struct PhysicsContext* pctx, struct GraphicsContext* ctx,
     dGeomSetOffsetWorldRotation(ragdoll->geoms[RAGDOLL_LEFT_LOWER_ARM], R_arm);
     dBodySetPosition(ragdoll->bodies[RAGDOLL_LEFT_LOWER_ARM],
                      position.x - 0.35f - armLength, position.y + 1.1f, position.z);
-    dGeomSetData(ragdoll->geoms[RAGDOLL_LEFT_LOWER_ARM], CreateGeomInfo(true, limbTex, 1.0f, 1.0f));
+    dGeomSetData(ragdoll->geoms[RAGDOLL_LEFT_LOWER_ARM], CreateGeomInfo(pctx, true, limbTex, 1.0f, 1.0f));
 
     // Right upper arm
     dMassSetCylinder(&m, 1, 3, armRadius, armLength);
@@ -211,7 +191,7 @@ RagDoll* CreateRagdoll(struct PhysicsContext* pctx, struct GraphicsContext* ctx,
     dGeomSetOffsetWorldRotation(ragdoll->geoms[RAGDOLL_RIGHT_UPPER_ARM], R_arm);
     dBodySetPosition(ragdoll->bodies[RAGDOLL_RIGHT_UPPER_ARM],
                      position.x + 0.35f, position.y + 1.1f, position.z);
-    dGeomSetData(ragdoll->geoms[RAGDOLL_RIGHT_UPPER_ARM], CreateGeomInfo(true, limbTex, 1.0f, 1.0f));
+    dGeomSetData(ragdoll->geoms[RAGDOLL_RIGHT_UPPER_ARM], CreateGeomInfo(pctx, true, limbTex, 1.0f, 1.0f));
 
     // Right lower arm
     dMassSetCylinder(&m, 1, 3, armRadius, armLength);
@@ -224,7 +204,7 @@ RagDoll* CreateRagdoll(struct PhysicsContext* pctx, struct GraphicsContext* ctx,
     dGeomSetOffsetWorldRotation(ragdoll->geoms[RAGDOLL_RIGHT_LOWER_ARM], R_arm);
     dBodySetPosition(ragdoll->bodies[RAGDOLL_RIGHT_LOWER_ARM],
                      position.x + 0.35f + armLength, position.y + 1.1f, position.z);
-    dGeomSetData(ragdoll->geoms[RAGDOLL_RIGHT_LOWER_ARM], CreateGeomInfo(true, limbTex, 1.0f, 1.0f));
+    dGeomSetData(ragdoll->geoms[RAGDOLL_RIGHT_LOWER_ARM], CreateGeomInfo(pctx, true, limbTex, 1.0f, 1.0f));
 
     // Create legs - initialize mass for each individually
     // ODE cylinders are along Z-axis by default
@@ -243,7 +223,7 @@ RagDoll* CreateRagdoll(struct PhysicsContext* pctx, struct GraphicsContext* ctx,
     dGeomSetOffsetWorldRotation(ragdoll->geoms[RAGDOLL_LEFT_UPPER_LEG], R_leg);
     dBodySetPosition(ragdoll->bodies[RAGDOLL_LEFT_UPPER_LEG],
                      position.x - 0.15f, position.y + 0.45f, position.z);
-    dGeomSetData(ragdoll->geoms[RAGDOLL_LEFT_UPPER_LEG], CreateGeomInfo(true, limbTex, 1.0f, 1.0f));
+    dGeomSetData(ragdoll->geoms[RAGDOLL_LEFT_UPPER_LEG], CreateGeomInfo(pctx, true, limbTex, 1.0f, 1.0f));
 
     // Left lower leg
     dMassSetCylinder(&m, 1, 3, legRadius, legLength);
@@ -256,7 +236,7 @@ RagDoll* CreateRagdoll(struct PhysicsContext* pctx, struct GraphicsContext* ctx,
     dGeomSetOffsetWorldRotation(ragdoll->geoms[RAGDOLL_LEFT_LOWER_LEG], R_leg);
     dBodySetPosition(ragdoll->bodies[RAGDOLL_LEFT_LOWER_LEG],
                      position.x - 0.15f, position.y, position.z);
-    dGeomSetData(ragdoll->geoms[RAGDOLL_LEFT_LOWER_LEG], CreateGeomInfo(true, limbTex, 1.0f, 1.0f));
+    dGeomSetData(ragdoll->geoms[RAGDOLL_LEFT_LOWER_LEG], CreateGeomInfo(pctx, true, limbTex, 1.0f, 1.0f));
 
     // Right upper leg
     dMassSetCylinder(&m, 1, 3, legRadius, legLength);
@@ -269,7 +249,7 @@ RagDoll* CreateRagdoll(struct PhysicsContext* pctx, struct GraphicsContext* ctx,
     dGeomSetOffsetWorldRotation(ragdoll->geoms[RAGDOLL_RIGHT_UPPER_LEG], R_leg);
     dBodySetPosition(ragdoll->bodies[RAGDOLL_RIGHT_UPPER_LEG],
                      position.x + 0.15f, position.y + 0.45f, position.z);
-    dGeomSetData(ragdoll->geoms[RAGDOLL_RIGHT_UPPER_LEG], CreateGeomInfo(true, limbTex, 1.0f, 1.0f));
+    dGeomSetData(ragdoll->geoms[RAGDOLL_RIGHT_UPPER_LEG], CreateGeomInfo(pctx, true, limbTex, 1.0f, 1.0f));
 
     // Right lower leg
     dMassSetCylinder(&m, 1, 3, legRadius, legLength);
@@ -282,7 +262,7 @@ RagDoll* CreateRagdoll(struct PhysicsContext* pctx, struct GraphicsContext* ctx,
     dGeomSetOffsetWorldRotation(ragdoll->geoms[RAGDOLL_RIGHT_LOWER_LEG], R_leg);
     dBodySetPosition(ragdoll->bodies[RAGDOLL_RIGHT_LOWER_LEG],
                      position.x + 0.15f, position.y, position.z);
-    dGeomSetData(ragdoll->geoms[RAGDOLL_RIGHT_LOWER_LEG], CreateGeomInfo(true, limbTex, 1.0f, 1.0f));
+    dGeomSetData(ragdoll->geoms[RAGDOLL_RIGHT_LOWER_LEG], CreateGeomInfo(pctx, true, limbTex, 1.0f, 1.0f));
 
     // Create joints connecting body parts
 
@@ -385,15 +365,121 @@ RagDoll* CreateRagdoll(struct PhysicsContext* pctx, struct GraphicsContext* ctx,
     // register the bodies with the framework 
     for (int i=0; i<ragdoll->bodyCount; i++)
     {
-		entity* ent = RL_MALLOC(sizeof(entity));
-		ent->body = ragdoll->bodies[i];
-		dBodySetData(ragdoll->bodies[i], ent);
-		ent->node = clistAddNode(pctx->objList, ent );
+		AttachEntity(pctx, ragdoll->bodies[i]);
+	}
+	for (int i = 0; i < ragdoll->jointCount; i++) {
+		RegisterJoint(pctx, ragdoll->joints[i], JOINT_RAGDOLL);
 	}
 
     return ragdoll;
 }
 
+// the joints buildRagdoll makes, in order, UpdateRagdollMotors and
+// anything using the RagdollBodyPart indices rely on this layout
+static const struct { int type, body1, body2; } ragdollJoints[RAGDOLL_JOINT_COUNT] = {
+    { dJointTypeHinge,     RAGDOLL_HEAD,            RAGDOLL_TORSO },
+    { dJointTypeUniversal, RAGDOLL_TORSO,           RAGDOLL_LEFT_UPPER_ARM },
+    { dJointTypeHinge,     RAGDOLL_LEFT_UPPER_ARM,  RAGDOLL_LEFT_LOWER_ARM },
+    { dJointTypeUniversal, RAGDOLL_TORSO,           RAGDOLL_RIGHT_UPPER_ARM },
+    { dJointTypeHinge,     RAGDOLL_RIGHT_UPPER_ARM, RAGDOLL_RIGHT_LOWER_ARM },
+    { dJointTypeUniversal, RAGDOLL_TORSO,           RAGDOLL_LEFT_UPPER_LEG },
+    { dJointTypeHinge,     RAGDOLL_LEFT_UPPER_LEG,  RAGDOLL_LEFT_LOWER_LEG },
+    { dJointTypeUniversal, RAGDOLL_TORSO,           RAGDOLL_RIGHT_UPPER_LEG },
+    { dJointTypeHinge,     RAGDOLL_RIGHT_UPPER_LEG, RAGDOLL_RIGHT_LOWER_LEG },
+};
+
+// does a prefab have the bodies and joints a ragdoll is indexed by
+static bool isRagdollLayout(const Prefab* pf)
+{
+    if (pf->bodyCount != RAGDOLL_BODY_COUNT || pf->jointCount != RAGDOLL_JOINT_COUNT) return false;
+    for (int i = 0; i < RAGDOLL_JOINT_COUNT; i++) {
+        const PrefabJoint* j = &pf->joints[i];
+        if (j->type != ragdollJoints[i].type) return false;
+        if (j->body1 != ragdollJoints[i].body1 || j->body2 != ragdollJoints[i].body2) return false;
+    }
+    return true;
+}
+
+/**
+ * @brief the template ragdolls are made from
+ *
+ * The first call builds a ragdoll by hand, captures it as the prefab
+ * "ragdoll" and frees it again. If a prefab of that name has already
+ * been added to the context (say from LoadPrefab) that's used instead,
+ * unless its bodies and joints don't match the built in ragdoll, then
+ * it's dropped and the built in one takes its place.
+ *
+ * @param pctx Pointer to physics context
+ * @param ctx Pointer to graphics context
+ * @return the prefab, owned by the physics context
+ */
+Prefab* GetRagdollPrefab(struct PhysicsContext* pctx, struct GraphicsContext* ctx)
+{
+    Prefab* pf = GetPrefab(pctx, "ragdoll");
+    if (pf && isRagdollLayout(pf)) return pf;
+    if (pf) {
+        printf("prefab \"ragdoll\" doesn't have the ragdoll's bodies and joints, using the built in one\n");
+        clistDeleteNodeFromData(pctx->prefabs, pf);
+        FreePrefab(pf);
+    }
+
+    RagDoll* rd = buildRagdoll(pctx, ctx, Vector3Zero());
+    pf = CapturePrefab(pctx, ctx, "ragdoll", Vector3Zero(),
+                       rd->bodies, rd->bodyCount, rd->joints, rd->jointCount, NULL, 0);
+    FreeRagdoll(pctx, rd);
+    return AddPrefab(pctx, pf);
+}
+
+// Rag doll creation 
+// Creates a humanoid rag doll with configurable joint motors
+
+/**
+ * @brief Create a ragdoll physics body
+ *
+ * Creates a complete humanoid ragdoll with articulated joints.
+ * The ragdoll is fully physics-simulated and can be used for
+ * character physics, death animations, or as a basis for
+ * reinforcement learning control.
+ *
+ * Every ragdoll is stamped out from the prefab GetRagdollPrefab
+ * returns, so after the first one no masses or limits are worked out.
+ *
+ * @param pctx Pointer to physics context
+ * @param ctx Pointer to graphics context
+ * @param position Initial position for the ragdoll
+ * @return Pointer to newly created RagDoll structure
+ *
+ * @note Bodies: 10 (head, torso, 2 upper arms, 2 lower arms, 2 upper legs, 2 lower legs)
+ * @note Joints: 9 (neck, shoulders, elbows, hips, knees)
+ * @note All bodies are registered with framework for rendering
+ *
+ * @see RagDoll
+ * @see UpdateRagdollMotors
+ * @see DrawRagdoll
+ * @see FreeRagdoll
+ */
+RagDoll* CreateRagdoll(struct PhysicsContext* pctx, struct GraphicsContext* ctx, Vector3 position)
+{
+    Prefab* pf = GetRagdollPrefab(pctx, ctx);
+
+    RagDoll *ragdoll = RL_MALLOC(sizeof(RagDoll));
+    ragdoll->bodyCount = pf->bodyCount;
+    ragdoll->jointCount = pf->jointCount;
+    ragdoll->motorCount = 0;
+
+    // one geom per body, but a prefab from a file might differ
+    int geomSlots = pf->geomCount > pf->bodyCount ? pf->geomCount : pf->bodyCount;
+    ragdoll->bodies = RL_MALLOC(pf->bodyCount * sizeof(dBodyID));
+    ragdoll->geoms = RL_CALLOC(geomSlots, sizeof(dGeomID));
+    ragdoll->joints = RL_MALLOC(pf->jointCount * sizeof(dJointID));
+    ragdoll->motors = RL_MALLOC(pf->jointCount * sizeof(dJointID));
+
+    StampPrefab(pctx, ctx, pf, position, QuaternionIdentity(),
+                ragdoll->bodies, ragdoll->geoms, ragdoll->joints);
+
+    return ragdoll;
+}
+
 // Update rag doll motors 
 // motorForces array should have one value per joint for control
 
@@ -448,7 +534,7 @@ void UpdateRagdollMotors(RagDoll *ragdoll, float *motorForces)
  * @param ragdoll Pointer to the ragdoll structure
  * @param ctx Pointer to the graphics context
  *
- * @note Uses the same drawGeom system as other physics bodies
+ * @note Uses the same instanced geom drawing as other physics bodies
  * @see CreateRagdoll
  */
 void DrawRagdoll(RagDoll *ragdoll, struct GraphicsContext* ctx)
@@ -457,9 +543,10 @@ void DrawRagdoll(RagDoll *ragdoll, struct GraphicsContext* ctx)
 
     for (int i = 0; i < ragdoll->bodyCount; i++) {
         if (ragdoll->geoms[i]) {
-            DrawGeom(ragdoll->geoms[i], ctx);
+            QueueGeom(ragdoll->geoms[i], ctx);
         }
     }
+    FlushGeoms(ctx);
 }
 
 
@@ -487,7 +574,7 @@ void FreeRagdoll(PhysicsContext* ctx, RagDoll *ragdoll)
     if (ragdoll->joints) {
         for (int i = 0; i < ragdoll->jointCount; i++) {
             if (ragdoll->joints[i]) {
-                dJointDestroy(ragdoll->joints[i]);
+                FreeJoint(ctx, ragdoll->joints[i]);
             }
         }
     }
@@ -496,7 +583,7 @@ void FreeRagdoll(PhysicsContext* ctx, RagDoll *ragdoll)
     if (ragdoll->motors) {
         for (int i = 0; i < ragdoll->motorCount; i++) {
             if (ragdoll->motors[i]) {
-                dJointDestroy(ragdoll->motors[i]);
+                FreeJoint(ctx, ragdoll->motors[i]);
             }
         }
     }
@@ -504,10 +591,8 @@ void FreeRagdoll(PhysicsContext* ctx, RagDoll *ragdoll)
     // Destroy ODE bodies and geoms (remove from framework tracking too)
     for (int i=0; i<ragdoll->bodyCount; i++)
     {
-		entity* ent = dBodyGetData(ragdoll->bodies[i]);
-		FreeBodyAndGeoms(ragdoll->bodies[i]);
-		clistDeleteNode(ctx->objList, &ent->node);
-		RL_FREE(ent);
+		entity* ent = GetBodyEntity(ctx, ragdoll->bodies[i]);
+		FreeEntity(ctx, ent);
 	}
 
     // Free wrapper arrays
@@ -20,9 +20,11 @@
  * SOFTWARE.
  *
  */
+#include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
 #include <string.h>  // memset
+#include <stdint.h>  // uintptr_t
 #include "raylibODE.h"
 #include "collision.h"
 
@@ -106,7 +108,7 @@
  * // Create a static ground box
  * dGeomID planeGeom = dCreateBox(physCtx->space, PLANE_SIZE, PLANE_THICKNESS, PLANE_SIZE);
  * dGeomSetPosition(planeGeom, 0, -PLANE_THICKNESS / 2.0, 0);
- * dGeomSetData(planeGeom, CreateGeomInfo(true, graphics->groundTexture, 25.0f, 25.0f));
+ * dGeomSetData(planeGeom, CreateGeomInfo(physCtx, true, UseTexture(graphics->assets, graphics->groundTexture), 25.0f, 25.0f));
  * clistAddNode(physCtx->statics, planeGeom);
  * @endcode
  *
@@ -260,6 +262,8 @@ float rndf(float min, float max)
 int StepPhysics(PhysicsContext* physCtx)
 {
 	int pSteps = 0;
+	OdeMemStepBegin();
+	physCtx->memStats.contactJoints = 0;
 	physCtx->frameTime += GetFrameTime();
 	while (physCtx->frameTime > physSlice) {
 		// check for collisions
@@ -279,6 +283,7 @@ int StepPhysics(PhysicsContext* physCtx)
 			break;
 		}
 	}
+	OdeMemStepEnd(pSteps);
 	return pSteps;
 }
 
@@ -301,14 +306,104 @@ int StepPhysics(PhysicsContext* physCtx)
  * it creates an "empty" body without geoms
  */
 entity* CreateBaseEntity(PhysicsContext* ctx) {
-    dBodyID bdy = dBodyCreate(ctx->world);
-    entity* ent = RL_MALLOC(sizeof(entity));
-    ent->body = bdy;
-    dBodySetData(bdy, ent);
+    return AttachEntity(ctx, dBodyCreate(ctx->world));
+}
+
+/**
+ * @brief Register an existing body with the framework
+ *
+ * Wraps a body created elsewhere (vehicles, ragdolls and so on) in an
+ * entity so it is drawn and cleaned up like any other. The body's data
+ * pointer is set to the entity's handle, use GetBodyEntity to get back
+ * from a body to its entity.
+ *
+ * @param ctx Pointer to the physics context
+ * @param bdy the body to register
+ * @return Pointer to the new entity
+ *
+ * @note the returned pointer stays valid until the entity is freed
+ */
+entity* AttachEntity(PhysicsContext* ctx, dBodyID bdy) {
+    entity* ent = EntityStoreAdd(&ctx->entities, bdy);
+    dBodySetData(bdy, (void*)(uintptr_t)ent->handle);
     ent->node = clistAddNode(ctx->objList, ent);
     return ent;
 }
 
+/**
+ * @brief resolve an entity handle
+ *
+ * @param ctx the physics context
+ * @param h the handle
+ * @return the entity or NULL if it has since been freed
+ */
+entity* GetEntity(PhysicsContext* ctx, EntityHandle h)
+{
+    return EntityStoreGet(&ctx->entities, h);
+}
+
+/**
+ * @brief find the entity a body belongs to
+ *
+ * @param ctx the physics context
+ * @param bdy the body
+ * @return the entity or NULL if the body isn't tracked by the framework
+ */
+entity* GetBodyEntity(PhysicsContext* ctx, dBodyID bdy)
+{
+    return EntityStoreGet(&ctx->entities, (EntityHandle)(uintptr_t)dBodyGetData(bdy));
+}
+
+/**
+ * @brief number of live entities
+ *
+ * @param ctx the physics context
+ */
+int GetEntityCount(PhysicsContext* ctx)
+{
+    return ctx->entities.table.count;
+}
+
+/**
+ * @brief get an entity by its position in the dense entity array
+ *
+ * Freeing an entity moves the last entity into its place, so if you
+ * free entities while looping, loop backwards
+ *
+ * @code
+ *   for (int i = GetEntityCount(physCtx) - 1; i >= 0; i--) {
+ *       entity* ent = GetEntityAt(physCtx, i);
+ *       // your code here, FreeEntity(physCtx, ent) is safe
+ *   }
+ * @endcode
+ *
+ * @param ctx the physics context
+ * @param i index from 0 to GetEntityCount()-1
+ */
+entity* GetEntityAt(PhysicsContext* ctx, int i)
+{
+    return EntityStoreAt(&ctx->entities, i);
+}
+
+/**
+ * @brief call a function for every entity
+ *
+ * Entities are visited from the back of the dense array, so the
+ * callback is free to call FreeEntity on the entity it is given.
+ * Entities created by the callback are not visited.
+ *
+ * @param ctx the physics context
+ * @param fn the callback
+ * @param user passed through to the callback
+ */
+void ForEachEntity(PhysicsContext* ctx, EntityCallback fn, void* user)
+{
+    for (int i = ctx->entities.table.count - 1; i >= 0; i--) {
+        if (i >= ctx->entities.table.count) continue; // callback freed more than one
+        fn(ctx, EntityStoreAt(&ctx->entities, i), user);
+    }
+}
+
 // TODO the geom only creation functions should be used by the
 // create entity function CreateBall CreateBox etc
 
@@ -331,8 +426,8 @@ dGeomID CreateSphereGeom(PhysicsContext* ctx, GraphicsContext* gfxCtx, float rad
     dGeomID geom = dCreateSphere(ctx->space, radius);
     dGeomSetPosition(geom, pos.x, pos.y, pos.z);
 
-    Texture* tex = &gfxCtx->sphereTextures[(int)rndf(0, 3)];
-    geomInfo* gi = CreateGeomInfo(true, tex, 1.0f, 1.0f);
+    Texture* tex = UseTexture(gfxCtx->assets, gfxCtx->sphereTextures[(int)rndf(0, 3)]);
+    geomInfo* gi = CreateGeomInfo(ctx, true, tex, 1.0f, 1.0f);
     dGeomSetData(geom, gi);
 
     return geom;
@@ -359,8 +454,8 @@ dGeomID CreateCylinderGeom(PhysicsContext* ctx, GraphicsContext* gfxCtx, float r
     dGeomID geom = dCreateCylinder(ctx->space, radius, length);
     dGeomSetPosition(geom, pos.x, pos.y, pos.z);
 
-    Texture* tex = &gfxCtx->cylinderTextures[(int)rndf(0, 2)];
-    geomInfo* gi = CreateGeomInfo(true, tex, 1.0f, 1.0f);
+    Texture* tex = UseTexture(gfxCtx->assets, gfxCtx->cylinderTextures[(int)rndf(0, 2)]);
+    geomInfo* gi = CreateGeomInfo(ctx, true, tex, 1.0f, 1.0f);
     dGeomSetData(geom, gi);
 
     return geom;
@@ -385,8 +480,8 @@ dGeomID CreateBoxGeom(PhysicsContext* ctx, GraphicsContext* gfxCtx, Vector3 size
 	dGeomID geom = dCreateBox(ctx->space, size.x, size.y, size.z);
 	dGeomSetPosition(geom, pos.x, pos.y, pos.z);
 	
-	Texture* tex = &gfxCtx->boxTextures[(int)rndf(0, 2)];
-    geomInfo* gi = CreateGeomInfo(true, tex, 1.0f, 1.0f);
+	Texture* tex = UseTexture(gfxCtx->assets, gfxCtx->boxTextures[(int)rndf(0, 2)]);
+    geomInfo* gi = CreateGeomInfo(ctx, true, tex, 1.0f, 1.0f);
     dGeomSetData(geom, gi);
 
     return geom;
@@ -394,6 +489,59 @@ dGeomID CreateBoxGeom(PhysicsContext* ctx, GraphicsContext* gfxCtx, Vector3 size
 
 // --- BOX ---
 
+// which retired list a geom class goes on, -1 if it can't be reused
+static int retiredSlot(int geomClass)
+{
+    switch (geomClass) {
+        case dBoxClass:      return 0;
+        case dSphereClass:   return 1;
+        case dCylinderClass: return 2;
+        case dCapsuleClass:  return 3;
+        default:             return -1;
+    }
+}
+
+// put a body back to rest, awake with no motion or pending forces
+static void resetBodyMotion(dBodyID bdy)
+{
+    dBodySetLinearVel(bdy, 0, 0, 0);
+    dBodySetAngularVel(bdy, 0, 0, 0);
+    dBodySetForce(bdy, 0, 0, 0);
+    dBodySetTorque(bdy, 0, 0, 0);
+    dBodyEnable(bdy);
+}
+
+// take a retired body of the given shape if there is one, the caller
+// sets its size, mass and pose. The old geomInfo is released as the
+// caller gives it a new one. returns 0 if nothing could be reused
+static dGeomID reuseRetired(PhysicsContext* ctx, int geomClass, entity** ent)
+{
+    clist_t* list = ctx->retired[retiredSlot(geomClass)];
+    cnode_t* node = list->tail;
+    if (!node) return 0;
+
+    dBodyID bdy = node->data;
+    clistDeleteNode(list, &node);
+
+    dGeomID geom = dBodyGetFirstGeom(bdy);
+    FreeGeomInfo(ctx, dGeomGetData(geom));
+    dGeomSetData(geom, NULL);
+    dGeomClearOffset(geom);
+    dGeomEnable(geom);
+    dGeomSetCategoryBits(geom, ~0ul);   // multi piston sections filter their collisions
+    dGeomSetCollideBits(geom, ~0ul);
+
+    dBodySetDynamic(bdy);
+    dBodySetFiniteRotationMode(bdy, 0);
+    dBodySetGravityMode(bdy, 1);
+    dBodySetDampingDefaults(bdy);
+    dBodySetAutoDisableDefaults(bdy);
+    resetBodyMotion(bdy);
+
+    *ent = AttachEntity(ctx, bdy);
+    return geom;
+}
+
 /**
  * @brief Add a box-shaped physics body to the world
  *
@@ -416,11 +564,17 @@ dGeomID CreateBoxGeom(PhysicsContext* ctx, GraphicsContext* gfxCtx, Vector3 size
  */
 entity* CreateBox(PhysicsContext* ctx, GraphicsContext* gfxCtx, Vector3 size, Vector3 pos, Vector3 rot, float mass)
 {
-    entity* ent = CreateBaseEntity(ctx);
+    entity* ent;
     dMatrix3 R;
     dMass m;
 
-    dGeomID geom = dCreateBox(ctx->space, size.x, size.y, size.z);
+    dGeomID geom = reuseRetired(ctx, dBoxClass, &ent);
+    if (geom) {
+        dGeomBoxSetLengths(geom, size.x, size.y, size.z);
+    } else {
+        ent = CreateBaseEntity(ctx);
+        geom = dCreateBox(ctx->space, size.x, size.y, size.z);
+    }
     dMassSetBox(&m, mass, size.x, size.y, size.z);
 
     dBodySetPosition(ent->body, pos.x, pos.y, pos.z);
@@ -430,8 +584,8 @@ entity* CreateBox(PhysicsContext* ctx, GraphicsContext* gfxCtx, Vector3 size, Ve
     dGeomSetBody(geom, ent->body);
     dBodySetMass(ent->body, &m);
 
-    Texture* tex = &gfxCtx->boxTextures[(int)rndf(0, 2)];
-    dGeomSetData(geom, CreateGeomInfo(true, tex, 1.0f, 1.0f));
+    Texture* tex = UseTexture(gfxCtx->assets, gfxCtx->boxTextures[(int)rndf(0, 2)]);
+    dGeomSetData(geom, CreateGeomInfo(ctx, true, tex, 1.0f, 1.0f));
 
     return ent;
 }
@@ -459,11 +613,17 @@ entity* CreateBox(PhysicsContext* ctx, GraphicsContext* gfxCtx, Vector3 size, Ve
  */
 entity* CreateSphere(PhysicsContext* ctx, GraphicsContext* gfxCtx, float radius, Vector3 pos, Vector3 rot, float mass)
 {
-    entity* ent = CreateBaseEntity(ctx);
+    entity* ent;
     dMatrix3 R;
     dMass m;
 
-    dGeomID geom = dCreateSphere(ctx->space, radius);
+    dGeomID geom = reuseRetired(ctx, dSphereClass, &ent);
+    if (geom) {
+        dGeomSphereSetRadius(geom, radius);
+    } else {
+        ent = CreateBaseEntity(ctx);
+        geom = dCreateSphere(ctx->space, radius);
+    }
     dMassSetSphere(&m, mass, radius);
 
     dBodySetPosition(ent->body, pos.x, pos.y, pos.z);
@@ -473,8 +633,8 @@ entity* CreateSphere(PhysicsContext* ctx, GraphicsContext* gfxCtx, float radius,
     dGeomSetBody(geom, ent->body);
     dBodySetMass(ent->body, &m);
 
-    Texture* tex = &gfxCtx->sphereTextures[(int)rndf(0, 3)];
-    dGeomSetData(geom, CreateGeomInfo(true, tex, 1.0f, 1.0f));
+    Texture* tex = UseTexture(gfxCtx->assets, gfxCtx->sphereTextures[(int)rndf(0, 3)]);
+    dGeomSetData(geom, CreateGeomInfo(ctx, true, tex, 1.0f, 1.0f));
 
     return ent;
 }
@@ -503,12 +663,18 @@ entity* CreateSphere(PhysicsContext* ctx, GraphicsContext* gfxCtx, float radius,
  */
 entity* CreateCylinder(PhysicsContext* ctx, GraphicsContext* gfxCtx, float radius, float length, Vector3 pos, Vector3 rot, float mass) 
 {
-    entity* ent = CreateBaseEntity(ctx);
+    entity* ent;
     dMatrix3 R;
     dMass m;
 
     // ODE Cylinders are aligned along the Z-axis by default
-    dGeomID geom = dCreateCylinder(ctx->space, radius, length);
+    dGeomID geom = reuseRetired(ctx, dCylinderClass, &ent);
+    if (geom) {
+        dGeomCylinderSetParams(geom, radius, length);
+    } else {
+        ent = CreateBaseEntity(ctx);
+        geom = dCreateCylinder(ctx->space, radius, length);
+    }
     dMassSetCylinder(&m, mass, 3, radius, length); // 3 = Z-axis orientation
 
     dBodySetPosition(ent->body, pos.x, pos.y, pos.z);
@@ -518,8 +684,8 @@ entity* CreateCylinder(PhysicsContext* ctx, GraphicsContext* gfxCtx, float radiu
     dGeomSetBody(geom, ent->body);
     dBodySetMass(ent->body, &m);
 
-    Texture* tex = &gfxCtx->cylinderTextures[(int)rndf(0, 2)];
-    dGeomSetData(geom, CreateGeomInfo(true, tex, 1.0f, 1.0f));
+    Texture* tex = UseTexture(gfxCtx->assets, gfxCtx->cylinderTextures[(int)rndf(0, 2)]);
+    dGeomSetData(geom, CreateGeomInfo(ctx, true, tex, 1.0f, 1.0f));
 
     return ent;
 }
@@ -546,11 +712,17 @@ entity* CreateCylinder(PhysicsContext* ctx, GraphicsContext* gfxCtx, float radiu
  * @see entity
  */
 entity* CreateCapsule(PhysicsContext* ctx, GraphicsContext* gfxCtx, float radius, float length, Vector3 pos, Vector3 rot, float mass) {
-    entity* ent = CreateBaseEntity(ctx);
+    entity* ent;
     dMatrix3 R;
     dMass m;
 
-    dGeomID geom = dCreateCapsule(ctx->space, radius, length);
+    dGeomID geom = reuseRetired(ctx, dCapsuleClass, &ent);
+    if (geom) {
+        dGeomCapsuleSetParams(geom, radius, length);
+    } else {
+        ent = CreateBaseEntity(ctx);
+        geom = dCreateCapsule(ctx->space, radius, length);
+    }
     dMassSetCapsule(&m, mass, 3, radius, length);
 
     dBodySetPosition(ent->body, pos.x, pos.y, pos.z);
@@ -560,8 +732,8 @@ entity* CreateCapsule(PhysicsContext* ctx, GraphicsContext* gfxCtx, float radius
     dGeomSetBody(geom, ent->body);
     dBodySetMass(ent->body, &m);
 
-    Texture* tex = &gfxCtx->cylinderTextures[(int)rndf(0, 2)];
-    dGeomSetData(geom, CreateGeomInfo(true, tex, 1.0f, 1.0f));
+    Texture* tex = UseTexture(gfxCtx->assets, gfxCtx->capsuleTextures[(int)rndf(0, 2)]);
+    dGeomSetData(geom, CreateGeomInfo(ctx, true, tex, 1.0f, 1.0f));
 
     return ent;
 }
@@ -620,10 +792,10 @@ entity* CreateDumbbell(PhysicsContext* ctx, GraphicsContext* gfxCtx, float shaft
     dRFromEulerAngles(R, rot.x, rot.y, rot.z);
     dBodySetRotation(ent->body, R);
 
-    Texture* tex = &gfxCtx->cylinderTextures[(int)rndf(0, 2)];
-    dGeomSetData(gShaft, CreateGeomInfo(true, tex, 1.0f, 1.0f));
-    dGeomSetData(gEnd1, CreateGeomInfo(true, tex, 1.0f, 1.0f));
-    dGeomSetData(gEnd2, CreateGeomInfo(true, tex, 1.0f, 1.0f));
+    Texture* tex = UseTexture(gfxCtx->assets, gfxCtx->cylinderTextures[(int)rndf(0, 2)]);
+    dGeomSetData(gShaft, CreateGeomInfo(ctx, true, tex, 1.0f, 1.0f));
+    dGeomSetData(gEnd1, CreateGeomInfo(ctx, true, tex, 1.0f, 1.0f));
+    dGeomSetData(gEnd2, CreateGeomInfo(ctx, true, tex, 1.0f, 1.0f));
 
     return ent;
 }
@@ -689,6 +861,125 @@ entity* CreateRandomEntity(PhysicsContext* ctx, GraphicsContext* gfxCtx, Vector3
     }
 }
 
+// SpawnEntities keeps the mass of the last few shapes it made, scenes
+// are usually built from a handful of shapes repeated many times
+#define SPAWN_MASS_CACHE 8
+
+typedef struct SpawnMass {
+    unsigned char shape;
+    Vector3 size;
+    float mass;
+    dMass m;
+} SpawnMass;
+
+static void spawnMassFor(const EntityDesc* d, dMass* m)
+{
+    switch (d->shape) {
+        case SHAPE_BOX:      dMassSetBox(m, d->mass, d->size.x, d->size.y, d->size.z); break;
+        case SHAPE_SPHERE:   dMassSetSphere(m, d->mass, d->size.x); break;
+        case SHAPE_CYLINDER: dMassSetCylinder(m, d->mass, 3, d->size.x, d->size.y); break;
+        default:             dMassSetCapsule(m, d->mass, 3, d->size.x, d->size.y); break;
+    }
+}
+
+static Texture* spawnTexture(GraphicsContext* gfxCtx, unsigned char shape)
+{
+    switch (shape) {
+        case SHAPE_BOX:    return UseTexture(gfxCtx->assets, gfxCtx->boxTextures[(int)rndf(0, 2)]);
+        case SHAPE_SPHERE: return UseTexture(gfxCtx->assets, gfxCtx->sphereTextures[(int)rndf(0, 3)]);
+        case SHAPE_CAPSULE: return UseTexture(gfxCtx->assets, gfxCtx->capsuleTextures[(int)rndf(0, 2)]);
+        default:           return UseTexture(gfxCtx->assets, gfxCtx->cylinderTextures[(int)rndf(0, 2)]);
+    }
+}
+
+/**
+ * @brief create many entities in one go
+ *
+ * Equivalent to calling CreateBox, CreateSphere etc for each description
+ * but the pools and entity store are grown once up front, the mass of
+ * each distinct shape is only worked out once and consecutive entities
+ * with the same orientation share one rotation matrix.
+ *
+ * @param ctx Pointer to the physics context
+ * @param gfxCtx Pointer to the graphics context for texture assignment
+ * @param descs what to create
+ * @param n number of descriptions
+ * @param out if not NULL receives the n new entities
+ *
+ * @see EntityDesc
+ */
+void SpawnEntities(PhysicsContext* ctx, GraphicsContext* gfxCtx, const EntityDesc* descs, int n, entity** out)
+{
+    SpawnMass cache[SPAWN_MASS_CACHE];
+    int cached = 0, nextSlot = 0;
+    dMatrix3 R;
+    Vector3 lastRot = { 0 };
+    bool haveRot = false;
+
+    // dumbbells are three geoms
+    int geoms = 0;
+    for (int i = 0; i < n; i++) geoms += descs[i].shape == SHAPE_DUMBBELL ? 3 : 1;
+    EntityStoreReserve(&ctx->entities, n);
+    PoolReserve(&ctx->geomPool, geoms);
+    PoolReserve(&ctx->nodePool, n);
+
+    for (int i = 0; i < n; i++) {
+        const EntityDesc* d = &descs[i];
+        entity* ent;
+
+        if (d->shape == SHAPE_DUMBBELL) {
+            ent = CreateDumbbell(ctx, gfxCtx, d->size.x, d->size.y, d->size.z, d->pos, d->rot, d->mass);
+            if (out) out[i] = ent;
+            continue;
+        }
+
+        dGeomID geom;
+        switch (d->shape) {
+            case SHAPE_BOX:      geom = dCreateBox(ctx->space, d->size.x, d->size.y, d->size.z); break;
+            case SHAPE_SPHERE:   geom = dCreateSphere(ctx->space, d->size.x); break;
+            case SHAPE_CYLINDER: geom = dCreateCylinder(ctx->space, d->size.x, d->size.y); break;
+            default:             geom = dCreateCapsule(ctx->space, d->size.x, d->size.y); break;
+        }
+
+        // look for this shape's mass before working it out
+        dMass* m = NULL;
+        for (int c = 0; c < cached; c++) {
+            if (cache[c].shape == d->shape && cache[c].mass == d->mass &&
+                Vector3Equals(cache[c].size, d->size)) {
+                m = &cache[c].m;
+                break;
+            }
+        }
+        if (!m) {
+            SpawnMass* sm = &cache[nextSlot];
+            nextSlot = (nextSlot + 1) % SPAWN_MASS_CACHE;
+            if (cached < SPAWN_MASS_CACHE) cached++;
+            sm->shape = d->shape;
+            sm->size = d->size;
+            sm->mass = d->mass;
+            spawnMassFor(d, &sm->m);
+            m = &sm->m;
+        }
+
+        if (!haveRot || !Vector3Equals(lastRot, d->rot)) {
+            dRFromEulerAngles(R, d->rot.x, d->rot.y, d->rot.z);
+            lastRot = d->rot;
+            haveRot = true;
+        }
+
+        ent = CreateBaseEntity(ctx);
+        dBodySetPosition(ent->body, d->pos.x, d->pos.y, d->pos.z);
+        dBodySetRotation(ent->body, R);
+        dGeomSetBody(geom, ent->body);
+        dBodySetMass(ent->body, m);
+
+        Texture* tex = d->texture ? d->texture : spawnTexture(gfxCtx, d->shape);
+        dGeomSetData(geom, CreateGeomInfo(ctx, true, tex, 1.0f, 1.0f));
+
+        if (out) out[i] = ent;
+    }
+}
+
 /**
  * @brief Create a static trimesh collision geometry from a model
  *
@@ -713,46 +1004,45 @@ entity* CreateRandomEntity(PhysicsContext* ctx, GraphicsContext* gfxCtx, Vector3
  */
 cnode_t* CreateStaticTrimesh(PhysicsContext* physCtx, GraphicsContext* gfxCtx, Model model, Texture* tex, float uvScale)
 {
-    int nV = model.meshes[0].vertexCount;
-
-    // Setup ODE Data
-    int* indices = RL_MALLOC(nV * sizeof(int));
-    for (int i = 0; i < nV; i++) indices[i] = i;
-
-    dTriMeshDataID triData = dGeomTriMeshDataCreate();
-    dGeomTriMeshDataBuildSingle(triData, model.meshes[0].vertices, 3 * sizeof(float), nV,
-                                indices, nV, 3 * sizeof(int));
-
-    dGeomID geom = dCreateTriMesh(physCtx->space, triData, NULL, NULL, NULL);
+    // Setup ODE Data, cooked once per mesh however many geoms use it
+    SharedTrimesh* tm = AcquireTrimesh(model.meshes[0]);
+    dGeomID geom = dCreateTriMesh(physCtx->space, tm->triData, NULL, NULL, NULL);
 
     model.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = *tex;
     model.materials[0].shader = gfxCtx->shader;
 
     // Setup Metadata
-    geomInfo* gi = CreateGeomInfo(true, tex, uvScale, uvScale);
+    geomInfo* gi = CreateGeomInfo(physCtx, true, tex, uvScale, uvScale);
     gi->visual = model; // Stores the textured/shader-ready model
-    gi->indices = indices;
-    gi->triData = triData;
+    gi->visualTextured = true; // tex may still be loading, the copy above is refreshed when drawn
+    gi->indices = tm->indices;
+    gi->triData = tm->triData;
+    gi->trimesh = tm;
     dGeomSetData(geom, gi);
 
+    physCtx->memStats.trimeshes++;
+    physCtx->memStats.trimeshBytes += tm->indexCount * sizeof(int);
+
     return clistAddNode(physCtx->statics, geom);
 }
 
 /** @brief Helper to allocate geomInfo with collision flag, optional texture, and UV scale
  this is useful when greating your own custom bodies for special purposes
- If this is attached to a geom on a body that is in the global entity list then this
- allocation will be automagically cleaned up.
+ If this is attached to a geom on a body that is in the global entity list, or a geom
+ on the statics list then this allocation will be automagically cleaned up.
 
+ @param ctx the physics context, geomInfo is allocated from its pool
  @param collidable should this geom cause collisions
  @param texture which texture to use for the geom
  @param uvScaleU texture scaling
  @param uvScaleV texture scaling
 */
-geomInfo* CreateGeomInfo(bool collidable, Texture* texture, float uvScaleU, float uvScaleV)
+geomInfo* CreateGeomInfo(PhysicsContext* ctx, bool collidable, Texture* texture, float uvScaleU, float uvScaleV)
 {
-    geomInfo* gi = RL_MALLOC(sizeof(geomInfo));
+    geomInfo* gi = PoolAlloc(&ctx->geomPool);
     memset(gi, 0, sizeof(geomInfo)); // ensure visual for example is clear
 
+    gi->pooled = true;
     gi->collidable = collidable;
     gi->texture = texture;
     gi->uvScaleU = uvScaleU;
@@ -762,6 +1052,146 @@ geomInfo* CreateGeomInfo(bool collidable, Texture* texture, float uvScaleU, floa
     return gi;
 }
 
+/** @brief release a geomInfo
+ *
+ * geomInfo from CreateGeomInfo goes back to the context's pool, anything
+ * you allocated yourself (with MemAlloc for example) is freed, so zero
+ * your own allocations, pooled must be false for them. A shared
+ * trimesh from CreateStaticTrimesh loses a reference, so the cached
+ * collision data goes once its last geom does.
+ *
+ * @param ctx the physics context
+ * @param gi the geomInfo to release, NULL is ignored
+ */
+void FreeGeomInfo(PhysicsContext* ctx, geomInfo* gi)
+{
+    if (!gi) return;
+    if (gi->trimesh) {
+        ctx->memStats.trimeshes--;
+        ctx->memStats.trimeshBytes -= gi->trimesh->indexCount * sizeof(int);
+        ReleaseTrimesh(gi->trimesh);
+        gi->trimesh = NULL;
+    }
+    if (gi->pooled) {
+        PoolRelease(&ctx->geomPool, gi);
+    } else {
+        free(gi);
+    }
+}
+
+/** @brief print the usage of the context's allocation pools
+ *
+ * The high water marks are a good guide to how big a scene actually
+ * gets, and once a scene has warmed up the capacities should stop growing
+ *
+ * @param ctx the physics context
+ */
+void PrintPoolUsage(PhysicsContext* ctx)
+{
+    printf("%-10s live %6i  high water %6i  capacity %6i  (%zu bytes each)\n",
+        "entity", ctx->entities.table.count, ctx->entities.table.slotCount,
+        ctx->entities.pageCount * ENTITY_PAGE_SIZE, sizeof(entity));
+    PoolPrintUsage(&ctx->geomPool);
+    PoolPrintUsage(&ctx->nodePool);
+    ArenaPrintUsage(&ctx->arena);
+}
+
+// ray casts aren't tied to a context so they're counted here
+static int rayCastCount = 0;
+static size_t rayCastBytes = 0;
+
+/**
+ * @brief find out how much memory a physics context is using
+ *
+ * Nothing is walked, the figures come from the pools and counters that
+ * are kept as things are created and destroyed, so this is cheap enough
+ * to call every frame. totalBytes is this context alone, the ray cast
+ * and ODE figures are process wide and shared by every context.
+ *
+ * @param ctx the physics context
+ * @return a breakdown of the memory used
+ */
+PhysicsMemoryStats GetPhysicsMemoryStats(PhysicsContext* ctx)
+{
+    PhysicsMemoryStats s = ctx->memStats;
+    EntityStore* es = &ctx->entities;
+
+    s.entities = es->table.count;
+    s.entityBytes = es->table.count * sizeof(entity);
+    s.geomInfos = ctx->geomPool.live;
+    s.geomInfoBytes = ctx->geomPool.live * ctx->geomPool.itemSize;
+    s.visualBytes = ctx->geomPool.live * sizeof(Model);
+    s.listNodes = ctx->nodePool.live;
+    s.listNodeBytes = ctx->nodePool.live * ctx->nodePool.itemSize;
+    s.userJoints = ctx->joints.table.count;
+    s.rayCasts = rayCastCount;
+    s.rayCastBytes = rayCastBytes;
+
+    // entities, geomInfo and nodes are all inside the arena
+    s.frameworkBytes = ctx->arena.reserved
+        + es->table.slotCapacity * (sizeof(uint32_t) + 2 * sizeof(int))
+        + es->table.capacity * (sizeof(EntityHandle) + sizeof(dBodyID))
+        + ctx->joints.table.slotCapacity * (sizeof(uint32_t) + 2 * sizeof(int))
+        + ctx->joints.table.capacity * (sizeof(JointHandle) + sizeof(dJointID) + 1);
+    s.odeBytes = GetOdeMemStats().liveBytes;
+    // ray casts and ODE are shared by every context, so they are reported
+    // but left out of what this one costs
+    s.totalBytes = s.frameworkBytes + s.trimeshBytes;
+    return s;
+}
+
+/**
+ * @brief draw a memory usage overlay
+ *
+ * @param ctx the physics context
+ * @param x left of the overlay
+ * @param y top of the overlay
+ */
+void DrawPhysicsMemoryStats(PhysicsContext* ctx, int x, int y)
+{
+    PhysicsMemoryStats s = GetPhysicsMemoryStats(ctx);
+
+    DrawText(TextFormat("entities  %6i  %8zu bytes", s.entities, s.entityBytes), x, y, 20, WHITE);
+    DrawText(TextFormat("geomInfo  %6i  %8zu bytes (%zu visual)", s.geomInfos, s.geomInfoBytes, s.visualBytes), x, y + 20, 20, WHITE);
+    DrawText(TextFormat("nodes     %6i  %8zu bytes", s.listNodes, s.listNodeBytes), x, y + 40, 20, WHITE);
+    DrawText(TextFormat("trimesh   %6i  %8zu bytes", s.trimeshes, s.trimeshBytes), x, y + 60, 20, WHITE);
+    DrawText(TextFormat("joints    %6i  contacts %i", s.userJoints, s.contactJoints), x, y + 80, 20, WHITE);
+    DrawText(TextFormat("framework %8zu  total %8zu bytes", s.frameworkBytes, s.totalBytes), x, y + 100, 20, WHITE);
+    DrawText(TextFormat("global    raycasts %i  %zu bytes  ODE %zu bytes", s.rayCasts, s.rayCastBytes, s.odeBytes), x, y + 120, 20, WHITE);
+}
+
+
+/**
+ * @brief find out what was drawn and culled during the last frame
+ *
+ * @param ctx the graphics context
+ */
+RenderStats GetRenderStats(GraphicsContext* ctx)
+{
+    return ctx->renderStats;
+}
+
+/**
+ * @brief draw an overlay of what was drawn and culled
+ *
+ * @param ctx the graphics context
+ * @param x left of the overlay
+ * @param y top of the overlay
+ */
+void DrawRenderStats(GraphicsContext* ctx, int x, int y)
+{
+    RenderStats s = ctx->renderStats;
+
+    DrawText(TextFormat("bodies  %6i drawn  %6i culled  %3i calls  %3i binds", s.bodyGeoms, s.bodyGeomsCulled,
+                        s.bodyDrawCalls, s.bodyStateChanges), x, y, 20, WHITE);
+    DrawText(TextFormat("statics %6i drawn  %6i culled  %3i calls  %3i binds", s.staticGeoms, s.staticGeomsCulled,
+                        s.staticDrawCalls, s.staticStateChanges), x, y + 20, 20, WHITE);
+    DrawText(TextFormat("tris    %7i bodies  %7i statics", s.bodyTriangles, s.staticTriangles), x, y + 40, 20, WHITE);
+    DrawText(TextFormat("lod     %6i %6i %6i %6i", s.bodyLods[0] + s.staticLods[0], s.bodyLods[1] + s.staticLods[1],
+                        s.bodyLods[2] + s.staticLods[2], s.bodyLods[3] + s.staticLods[3]), x, y + 60, 20, WHITE);
+    DrawText(TextFormat("reused  %7i bodies  %7i statics", s.bodyReused, s.staticReused), x, y + 80, 20, WHITE);
+}
+
 
 // Callback for ODE to test ray against other geoms
 static void rayCallback(void* data, dGeomID o1, dGeomID o2) 
@@ -796,9 +1226,10 @@ entity* PickEntity(PhysicsContext* physCtx, GraphicsContext* gfxCtx, Vector3* hi
     Vector2 screenCenter = { GetScreenWidth() / 2.0f, GetScreenHeight() / 2.0f };
     Ray ray = GetMouseRay(screenCenter, gfxCtx->camera);
 
-    // Create a temporary ODE ray
+    // aim the context's ray
     float rayLength = 1000.0f;
-    dGeomID odeRay = dCreateRay(physCtx->space, rayLength);
+    dGeomID odeRay = physCtx->ray;
+    dGeomRaySetLength(odeRay, rayLength);
     dGeomRaySet(odeRay, ray.position.x, ray.position.y, ray.position.z,
                         ray.direction.x, ray.direction.y, ray.direction.z);
 
@@ -809,17 +1240,14 @@ entity* PickEntity(PhysicsContext* physCtx, GraphicsContext* gfxCtx, Vector3* hi
     // Collide the ray against everything in the space
     dSpaceCollide2(odeRay, (dGeomID)physCtx->space, &hit, &rayCallback);
 
-    // Cleanup the temporary ray
-    dGeomDestroy(odeRay);
-
     if (hit.geom != NULL) {
         if (hitPoint) *hitPoint = hit.pos;
 
         // Get the body attached to the geom
         dBodyID bdy = dGeomGetBody(hit.geom);
         if (bdy) {
-            // Retrieve our entity pointer from the body data
-            return (entity*)dBodyGetData(bdy);
+            // Retrieve our entity from the handle in the body data
+            return GetBodyEntity(physCtx, bdy);
         }
     }
 
@@ -839,6 +1267,8 @@ entity* PickEntity(PhysicsContext* physCtx, GraphicsContext* gfxCtx, Vector3* hi
 RayCast* CreateRayCast(int maxHits, Vector3 pos, Vector3 direction, dReal length)
 {
 	struct RayCast* rc = malloc(sizeof(RayCast) + (maxHits * sizeof(RayHit)));
+	rayCastCount++;
+	rayCastBytes += sizeof(RayCast) + (maxHits * sizeof(RayHit));
 	rc->maxHits = maxHits;
 	rc->position = pos;
 	rc->direction = direction;
@@ -847,24 +1277,40 @@ RayCast* CreateRayCast(int maxHits, Vector3 pos, Vector3 direction, dReal length
 	return rc;
 }
 
+/**
+ * @brief free a ray cast made with CreateRayCast
+ *
+ * @param rc the ray cast
+ */
+void FreeRayCast(RayCast* rc)
+{
+	rayCastCount--;
+	rayCastBytes -= sizeof(RayCast) + (rc->maxHits * sizeof(RayHit));
+	free(rc);
+}
+
+// most contacts a ray can report against a single geom, a ray only
+// gets more than one against a trimesh
+#define RAY_GEOM_CONTACTS 8
+
 // this callback gets hit multiple times per dSpaceCollide2 ...
 static void rayCastCallback(void* data, dGeomID o1, dGeomID o2)
 {
 	RayCast* rc = (RayCast*)data;
 	if (rc->count == rc->maxHits) return;
-	
-    dContact contact[rc->maxHits - rc->count];
-	int c  = dCollide(o1, o2, rc->maxHits - rc->count, &contact[0].geom, sizeof(dContact));
-    if (c > 0) {
-		for (int i = rc->count; i < rc->count + c; i++) {
-            rc->hits[i].depth = contact[i - rc->count].geom.depth;
-            rc->hits[i].geom = o2;
-            rc->hits[i].pos = (Vector3){contact[i - rc->count].geom.pos[0], contact[i - rc->count].geom.pos[1], contact[i - rc->count].geom.pos[2]};
-        }
-		rc->count += c;
 
-    }
+	dContactGeom contact[RAY_GEOM_CONTACTS];
+	int room = rc->maxHits - rc->count;
+	if (room > RAY_GEOM_CONTACTS) room = RAY_GEOM_CONTACTS;
 
+	int c = dCollide(o1, o2, room, &contact[0], sizeof(dContactGeom));
+	for (int i = 0; i < c; i++) {
+		RayHit* hit = &rc->hits[rc->count + i];
+		hit->depth = contact[i].depth;
+		hit->geom = o2;
+		hit->pos = (Vector3){ contact[i].pos[0], contact[i].pos[1], contact[i].pos[2] };
+	}
+	if (c > 0) rc->count += c;
 }
 
 /** cast a ray into the world building an array of results
@@ -875,12 +1321,12 @@ static void rayCastCallback(void* data, dGeomID o1, dGeomID o2)
  */
 void CastRay(PhysicsContext* physCtx, RayCast* rc)
 {
-	dGeomID odeRay = dCreateRay(physCtx->space, rc->length);
+	dGeomID odeRay = physCtx->ray;
+	dGeomRaySetLength(odeRay, rc->length);
     dGeomRaySet(odeRay, rc->position.x, rc->position.y, rc->position.z,
                         rc->direction.x, rc->direction.y, rc->direction.z);
     rc->count = 0;
     dSpaceCollide2(odeRay, (dGeomID)physCtx->space, rc, &rayCastCallback);
-    dGeomDestroy(odeRay);
 }
 
 /** @brief given a body it will remove it and its geoms from ODE's world
@@ -891,16 +1337,17 @@ void CastRay(PhysicsContext* physCtx, RayCast* rc)
  * As well as freeing all associated metadata it will also remove the body and
  * its geoms from the physics world
  * 
+ * @param ctx the physics context the geomInfo was allocated from
  * @param bdy the dBodyID you want to free the attached meta data for
  * 
  */
-void FreeBodyAndGeoms(dBodyID bdy)
+void FreeBodyAndGeoms(PhysicsContext* ctx, dBodyID bdy)
 {
 	dGeomID geom = dBodyGetFirstGeom(bdy);
 	while(geom) {
 		dGeomID next = dBodyGetNextGeom(geom); // get next now as about to destroy...
 		geomInfo* gi = dGeomGetData(geom);
-		if (gi) free(gi);
+		if (gi) FreeGeomInfo(ctx, gi);
 		dGeomSetBody(geom, 0);
 		dGeomDestroy(geom);
 		geom = next;
@@ -909,23 +1356,29 @@ void FreeBodyAndGeoms(dBodyID bdy)
 	dBodyDestroy(bdy);
 }
 
-// position rotation scale all done with the models transform...
-// TODO check there isn't a new raylib function that does this now _pro _ex or similar!
-static void DrawModelTinted(Model model, Color tint)
+// multiply two colours, as the shader would
+static Color tintColor(Color a, Color b)
+{
+    return (Color){
+        (unsigned char)((a.r * b.r + 127) / 255),
+        (unsigned char)((a.g * b.g + 127) / 255),
+        (unsigned char)((a.b * b.b + 127) / 255),
+        (unsigned char)((a.a * b.a + 127) / 255)
+    };
+}
+
+// models with a shader of their own can't be drawn instanced, the tint
+// has to go through the material for the draw, it is put back after
+static void DrawModelTinted(GraphicsContext* ctx, Model model, Color tint)
 {
     for (int i = 0; i < model.meshCount; i++)
     {
-        Color color = model.materials[model.meshMaterial[i]].maps[MATERIAL_MAP_DIFFUSE].color;
-
-        Color colorTint = WHITE;
-        colorTint.r = (unsigned char)((((float)color.r/255.0)*((float)tint.r/255.0))*255.0f);
-        colorTint.g = (unsigned char)((((float)color.g/255.0)*((float)tint.g/255.0))*255.0f);
-        colorTint.b = (unsigned char)((((float)color.b/255.0)*((float)tint.b/255.0))*255.0f);
-        colorTint.a = (unsigned char)((((float)color.a/255.0)*((float)tint.a/255.0))*255.0f);
+        MaterialMap* diffuse = &model.materials[model.meshMaterial[i]].maps[MATERIAL_MAP_DIFFUSE];
+        Color color = diffuse->color;
 
-        model.materials[model.meshMaterial[i]].maps[MATERIAL_MAP_DIFFUSE].color = colorTint;
-        DrawMesh(model.meshes[i], model.materials[model.meshMaterial[i]], model.transform);
-        model.materials[model.meshMaterial[i]].maps[MATERIAL_MAP_DIFFUSE].color = color;
+        diffuse->color = tintColor(color, tint);
+        ctx->backend.drawMesh(&ctx->backend, &model.meshes[i], model.materials[model.meshMaterial[i]], model.transform);
+        diffuse->color = color;
     }
 }
 
@@ -956,8 +1409,77 @@ void OdeToRayMat(const dReal* R, Matrix* m)
     m->m12 = 0;    m->m13 = 0;    m->m14 = 0;        m->m15 = 1;
 }
 
-// called by draw all geoms
-void DrawGeom(dGeomID geom, struct GraphicsContext* ctx)
+// can a geom that isn't moving use its cached transform, counted for the stats
+static bool reuseTransform(GraphicsContext* ctx, TransformCache* cache, const dReal* pos, const dReal* rot, Vector3 scale)
+{
+    if (!cache || !TransformCacheMatch(cache, pos, rot, scale)) return false;
+    ctx->reusedTransforms++;
+    return true;
+}
+
+// queue one instance, its transform is built by FlushGeoms unless the
+// cached one can be used, a stale cache is refreshed by the build
+static void queueMesh(GraphicsContext* ctx, Mesh* mesh, AtlasRegion texture, Color tint, Vector2 uvScale,
+                        const dReal* pos, const dReal* rot, Vector3 scale, TransformCache* cache, bool cached)
+{
+    InstanceSlot slot = AddInstance(&ctx->instancing, mesh, texture, tint, uvScale);
+    if (cached) {
+        memcpy(InstanceTransform(&ctx->instancing, slot), cache->transform, sizeof(cache->transform));
+        return;
+    }
+    RenderPrepAdd(&ctx->prep, pos, rot, scale, slot, cache);
+}
+
+// queue every mesh of a model with the same pose, only the first
+// refreshes a stale cache
+static void queueModel(GraphicsContext* ctx, Model* model, AtlasRegion texture, Color tint, Vector2 uvScale,
+                        const dReal* pos, const dReal* rot, Vector3 scale, TransformCache* cache)
+{
+    bool cached = reuseTransform(ctx, cache, pos, rot, scale);
+    for (int i = 0; i < model->meshCount; i++) {
+        queueMesh(ctx, &model->meshes[i], texture, tint, uvScale, pos, rot, scale,
+                    (i == 0 || cached) ? cache : NULL, cached);
+    }
+}
+
+// pick a geom's level of detail from its size on screen and count it
+static int geomLod(GraphicsContext* ctx, geomInfo* gi, const dReal* pos, float size)
+{
+    Vector3 p = { pos[0], pos[1], pos[2] };
+    gi->lod = (unsigned char)SelectLod(gi->lod, LodScreenSize(ctx->camera, ctx->backend.screenHeight(&ctx->backend), p, size));
+    ctx->lodCounts[gi->lod]++;
+    return gi->lod;
+}
+
+// a geom's own model, each mesh keeps its material's texture and colour
+static void queueVisual(GraphicsContext* ctx, Model* model, Color tint, Vector2 uvScale,
+                        const dReal* pos, const dReal* rot, TransformCache* cache)
+{
+    Vector3 one = { 1, 1, 1 };
+    bool cached = reuseTransform(ctx, cache, pos, rot, one);
+    for (int i = 0; i < model->meshCount; i++) {
+        MaterialMap* diffuse = &model->materials[model->meshMaterial[i]].maps[MATERIAL_MAP_DIFFUSE];
+        AtlasRegion texture = { diffuse->texture.id, 0 };
+        queueMesh(ctx, &model->meshes[i], texture, tintColor(diffuse->color, tint), uvScale,
+                    pos, rot, one, (i == 0 || cached) ? cache : NULL, cached);
+    }
+}
+
+/**
+ * @brief queue a geom to be drawn by the next FlushGeoms
+ *
+ * Geoms are batched by mesh and texture, or the atlas page it was
+ * packed into, and drawn instanced, the tint
+ * travels with each instance so no material is touched. Spheres,
+ * cylinders and capsules use coarser meshes the smaller they are on
+ * screen. Static geoms and disabled bodies keep their transform and
+ * reuse it until their pose changes. A visual model using a shader
+ * other than the framework's is drawn straight away.
+ *
+ * @param geom the geom, it must have geomInfo to be drawn
+ * @param ctx the graphics context
+ */
+void QueueGeom(dGeomID geom, struct GraphicsContext* ctx)
 {
     geomInfo* gi = (geomInfo*)dGeomGetData(geom);
     if (!gi) return; // Silently bail if no metadata
@@ -971,74 +1493,89 @@ void DrawGeom(dGeomID geom, struct GraphicsContext* ctx)
     const dReal* pos = dGeomGetPosition(geom);
     const dReal* rot = dGeomGetRotation(geom);
     int class = dGeomGetClass(geom);
-
-    Matrix matRot;
-    OdeToRayMat(rot, &matRot);
-    Matrix matTran = MatrixTranslate(pos[0], pos[1], pos[2]);
-    Matrix matWorld = MatrixMultiply(matRot, matTran);
-
+    Vector2 uvScale = { gi->uvScaleU, gi->uvScaleV };
     Color c = gi->hew;
 
-    // Handle Texture/Shader setup once per geom
-    if (gi->texture) {
-		// TODO cache shader location
-        int uvLoc = GetShaderLocation(ctx->shader, "texCoordScale");
-        Vector2 uvScale = { gi->uvScaleU, gi->uvScaleV };
-        SetShaderValue(ctx->shader, uvLoc, &uvScale.x, SHADER_UNIFORM_VEC2);
-
-        // assign the texture to whichever models might be used
-        if (class == dBoxClass) ctx->box.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = *gi->texture;
-        else if (class == dSphereClass) ctx->ball.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = *gi->texture;
-        else if (class == dCylinderClass) ctx->cylinder.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = *gi->texture;
-        else if (class == dCapsuleClass) {
-            ctx->cylinder.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = *gi->texture;
-            ctx->ball.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = *gi->texture;
-        }
-    }
+    // only geoms that aren't moving are worth caching
+    dBodyID body = dGeomGetBody(geom);
+    TransformCache* cache = (!body || !dBodyIsEnabled(body)) ? &gi->transform : NULL;
 
     if (gi->visual.meshCount) {
-		gi->visual.transform = matWorld;
-		DrawModelTinted(gi->visual, c);
-	} else {
-
-		if (class == dBoxClass) {
-			dVector3 size;
-			dGeomBoxGetLengths(geom, size);
-			ctx->box.transform = MatrixMultiply(MatrixScale(size[0], size[1], size[2]), matWorld);
-			DrawModelTinted(ctx->box, c);
-		}
-		else if (class == dSphereClass) {
-			float r = dGeomSphereGetRadius(geom);
-			ctx->ball.transform = MatrixMultiply(MatrixScale(r*2, r*2, r*2), matWorld);
-			DrawModelTinted(ctx->ball, c);
-		}
-		else if (class == dCylinderClass) {
-			dReal l, r;
-			dGeomCylinderGetParams(geom, &r, &l);
-			ctx->cylinder.transform = MatrixMultiply(MatrixScale(r*2, r*2, l), matWorld);
-			DrawModelTinted(ctx->cylinder, c);
-		}
-		else if (class == dCapsuleClass) {
-			dReal l, r;
-			dGeomCapsuleGetParams(geom, &r, &l);
-			float d = r * 2;
-
-			// Cylinder
-			ctx->cylinder.transform = MatrixMultiply(MatrixScale(d, d, l), matWorld);
-			DrawModelTinted(ctx->cylinder, c);
-
-			// Cap 1 (Local Z+)
-			Matrix matCap1 = MatrixMultiply(MatrixTranslate(0, 0, l/2), matWorld);
-			ctx->ball.transform = MatrixMultiply(MatrixScale(d, d, d), matCap1);
-			DrawModelTinted(ctx->ball, c);
-
-			// Cap 2 (Local Z-)
-			Matrix matCap2 = MatrixMultiply(MatrixTranslate(0, 0, -l/2), matWorld);
-			ctx->ball.transform = MatrixMultiply(MatrixScale(d, d, d), matCap2);
-			DrawModelTinted(ctx->ball, c);
-		}
+        if (gi->visualTextured) gi->visual.materials[0].maps[MATERIAL_MAP_DIFFUSE].texture = *gi->texture;
+        if (gi->visual.materials[0].shader.id == ctx->shader.id) {
+            queueVisual(ctx, &gi->visual, c, uvScale, pos, rot, cache);
+            return;
+        }
 
+        Matrix matRot;
+        OdeToRayMat(rot, &matRot);
+        Matrix matTran = MatrixTranslate(pos[0], pos[1], pos[2]);
+		gi->visual.transform = MatrixMultiply(matRot, matTran);
+		DrawModelTinted(ctx, gi->visual, c);
+		return;
 	}
+
+    // packed textures draw with their atlas page, one batch per mesh
+    AtlasRegion tex = AtlasFind(&ctx->atlas, gi->texture);
+
+    if (class == dBoxClass) {
+        dVector3 size;
+        dGeomBoxGetLengths(geom, size);
+        queueModel(ctx, &ctx->box, tex, c, uvScale, pos, rot, (Vector3){ size[0], size[1], size[2] }, cache);
+    }
+    else if (class == dSphereClass) {
+        float d = dGeomSphereGetRadius(geom) * 2;
+        Mesh* mesh = ctx->ballLod.levels[geomLod(ctx, gi, pos, d)];
+        Vector3 scale = { d, d, d };
+        queueMesh(ctx, mesh, tex, c, uvScale, pos, rot, scale, cache, reuseTransform(ctx, cache, pos, rot, scale));
+    }
+    else if (class == dCylinderClass) {
+        dReal l, r;
+        dGeomCylinderGetParams(geom, &r, &l);
+        Mesh* mesh = ctx->cylinderLod.levels[geomLod(ctx, gi, pos, fmaxf(r*2, l))];
+        Vector3 scale = { r*2, r*2, l };
+        queueMesh(ctx, mesh, tex, c, uvScale, pos, rot, scale, cache, reuseTransform(ctx, cache, pos, rot, scale));
+    }
+    else if (class == dCapsuleClass) {
+        dReal l, r;
+        dGeomCapsuleGetParams(geom, &r, &l);
+
+        // one instance of the unit capsule with the same proportions
+        Mesh* mesh = GetCapsuleMesh(&ctx->capsules, r, l, geomLod(ctx, gi, pos, l + r*2));
+        Vector3 scale = { r, r, r };
+        queueMesh(ctx, mesh, tex, c, uvScale, pos, rot, scale, cache, reuseTransform(ctx, cache, pos, rot, scale));
+    }
+}
+
+/**
+ * @brief draw everything queued with QueueGeom
+ *
+ * The transforms of everything queued are built in one bulk pass, then
+ * there is one instanced draw call per mesh and texture. The queue is
+ * left empty
+ * @param ctx the graphics context
+ */
+void FlushGeoms(struct GraphicsContext* ctx)
+{
+    RenderPrepBuild(&ctx->prep, &ctx->instancing);
+    ctx->backend.drawInstances(&ctx->backend, &ctx->instancing, ctx->camera.position, ctx->lights, &ctx->sceneLights);
+    RenderPrepClear(&ctx->prep);
+    BeginInstancing(&ctx->instancing);
+    memset(ctx->lodCounts, 0, sizeof(ctx->lodCounts));
+    ctx->reusedTransforms = 0;
+}
+
+/**
+ * @brief draw a single geom
+ *
+ * @note when drawing many geoms QueueGeom them and FlushGeoms once
+ * @param geom the geom to draw
+ * @param ctx the graphics context
+ */
+void DrawGeom(dGeomID geom, struct GraphicsContext* ctx)
+{
+    QueueGeom(geom, ctx);
+    FlushGeoms(ctx);
 }
 
 
@@ -1059,6 +1596,7 @@ dJointID CreateRotor(PhysicsContext* physCtx, entity* from, entity* to, Vector3
 {
 	// Use a Hinge to rotate around (no stops)
 	dJointID rotor = dJointCreateHinge(physCtx->world, 0);
+	RegisterJoint(physCtx, rotor, JOINT_ROTOR);
 	if (!to) {
 		dJointAttach(rotor, from->body, 0);
 	} else {
@@ -1118,32 +1656,74 @@ void SetEntitySurfaces(entity* ent, SurfaceMaterial* mat)
 	}
 }
 
+// only geoms that can be drawn are worth culling, baked ones are drawn
+// with their batch
+static void addCullGeom(struct GraphicsContext* ctx, dGeomID geom)
+{
+	geomInfo* gi = dGeomGetData(geom);
+	if (!gi || !gi->texture || gi->triggerOnCollide || gi->baked) return;
+
+	dReal aabb[6];
+	dGeomGetAABB(geom, aabb);
+	CullSetAdd(&ctx->culling, geom, aabb);
+}
+
+// cull the gathered geoms against the current 3D view and draw the rest,
+// returns how many were visible, fills lods with how many primitives
+// were drawn at each level of detail and reused with how many cached
+// transforms were used
+static int drawCulled(struct GraphicsContext* ctx, int* lods, int* reused)
+{
+	CullSet* cs = &ctx->culling;
+	Frustum f = FrustumFromMatrix(ctx->backend.viewProjection(&ctx->backend, ctx->camera));
+	int visible = CullSetTest(cs, &f);
+
+	for (int i = 0; i < cs->count; i++) {
+		if (cs->visible[i]) QueueGeom(cs->items[i], ctx);
+	}
+	memcpy(lods, ctx->lodCounts, sizeof(ctx->lodCounts));
+	*reused = ctx->reusedTransforms;
+	FlushGeoms(ctx);
+	return visible;
+}
+
 /**
  * @brief Draws all the dynamic bodies the framework is tracking
+ *
+ * Geoms outside the camera frustum are skipped before any of their
+ * transforms are built.
  * 
  * @param ctx the graphics context
  * @param pctx the physics context
  */
 void DrawBodies(struct GraphicsContext* ctx, PhysicsContext* pctx)
 {
-	cnode_t* node = pctx->objList->head;
+	UpdateAssetLoader(ctx->assets);		// textures that finished loading since last frame
 
-    while (node != NULL) {
-		entity* e = (entity*)node->data;
-		dBodyID bdy = e->body;
-		DrawBodyGeoms(bdy, ctx);
+	dBodyID* bodies = pctx->entities.bodies;
+	int count = pctx->entities.table.count;
 
-		node = node->next;
+	CullSetClear(&ctx->culling);
+	for (int i = 0; i < count; i++) {
+		DrawBodyGeoms(bodies[i], ctx);
 	}
+
+	int visible = drawCulled(ctx, ctx->renderStats.bodyLods, &ctx->renderStats.bodyReused);
+	ctx->renderStats.bodyGeoms = visible;
+	ctx->renderStats.bodyGeomsCulled = ctx->culling.count - visible;
+	ctx->renderStats.bodyDrawCalls = ctx->instancing.drawCalls;
+	ctx->renderStats.bodyTriangles = ctx->instancing.triangles;
+	ctx->renderStats.bodyStateChanges = ctx->instancing.stateChanges;
 }
 
+// gather a body's geoms for culling
 static void DrawBodyGeoms(dBodyID bdy, struct GraphicsContext* ctx)
 {
 	dGeomID geom = dBodyGetFirstGeom(bdy);
 	while(geom) {
 		dGeomID next = dBodyGetNextGeom(geom);
 
-		DrawGeom(geom, ctx);
+		addCullGeom(ctx, geom);
 		geom = next;
 	}
 
@@ -1154,7 +1734,10 @@ static void DrawBodyGeoms(dBodyID bdy, struct GraphicsContext* ctx)
  * 
  * As static geometries have no bodies they are handled a little different
  * this will draw all the dGeomID's that are registed on the physics context
- * static lists
+ * static lists, skipping those outside the camera frustum. Geoms merged
+ * by BakeStaticRenderBatches are drawn with their batches, which are
+ * baked again if geoms have been added to or removed from the statics
+ * list since.
  * @note all geoms on the statics list must have attached geomInfo
  * 
  * @param ctx the graphics context
@@ -1162,30 +1745,254 @@ static void DrawBodyGeoms(dBodyID bdy, struct GraphicsContext* ctx)
  */
 void DrawStatics(struct GraphicsContext* ctx, PhysicsContext* pctx)
 {
+	UpdateAssetLoader(ctx->assets);
+	StaticBatches* sb = &ctx->staticBatches;
+	if (sb->baked && sb->staticVersion != pctx->statics->version) BakeStaticRenderBatches(pctx, ctx);
+
 	cnode_t* node = pctx->statics->head;
 
+	CullSetClear(&ctx->culling);
     while (node != NULL) {
-		dGeomID geom = node->data;
-		DrawGeom(geom, ctx);
+		addCullGeom(ctx, node->data);
 		node = node->next;
 	}
+
+	int visible = drawCulled(ctx, ctx->renderStats.staticLods, &ctx->renderStats.staticReused);
+	ctx->renderStats.staticGeoms = visible;
+	ctx->renderStats.staticGeomsCulled = ctx->culling.count - visible;
+	ctx->renderStats.staticDrawCalls = ctx->instancing.drawCalls;
+	ctx->renderStats.staticTriangles = ctx->instancing.triangles;
+	ctx->renderStats.staticStateChanges = ctx->instancing.stateChanges;
+
+	DrawStaticRenderBatches(ctx);
 }
 
 /** @brief frees an entity
  *
  * this is essentially destroying the entity it is no longer part of the world
- * @note if iterrating through the global entity list while calling this,
- * ensure you have stored the next node in the chain, for use at the end of the
- * while loop as obviously node->next won't work
+ * @note the last entity in the dense array is moved into the freed entity's
+ * place, so when looping with GetEntityAt loop backwards. If iterating the
+ * compatibility objList instead, store the next node before calling this.
  *
  * @param physCtx physics context
  * @param ent the entity to destroy
  */
 void FreeEntity(PhysicsContext* physCtx, entity* ent)
 {
-	FreeBodyAndGeoms(ent->body);
+	FreeBodyAndGeoms(physCtx, ent->body);
 	clistDeleteNode(physCtx->objList, &ent->node);
-	free(ent);
+	EntityStoreRemove(&physCtx->entities, ent);
+}
+
+/** @brief take an entity out of the world but keep it for reuse
+ *
+ * A box, sphere, cylinder or capsule with no joints is parked, its body
+ * and geom are disabled and it's no longer an entity. The next CreateBox,
+ * CreateSphere etc (including from CreateRandomEntity) of the same shape
+ * reuses it, resizing the geom rather than destroying and recreating the
+ * body, geom and mass. Anything else is simply freed.
+ * @note like FreeEntity the last entity is moved into this one's place
+ *
+ * @param ctx physics context
+ * @param ent the entity to retire
+ */
+void RetireEntity(PhysicsContext* ctx, entity* ent)
+{
+	dBodyID bdy = ent->body;
+	dGeomID geom = dBodyGetFirstGeom(bdy);
+	int slot = geom ? retiredSlot(dGeomGetClass(geom)) : -1;
+
+	if (slot < 0 || dBodyGetNextGeom(geom) || dBodyGetNumJoints(bdy)) {
+		FreeEntity(ctx, ent);
+		return;
+	}
+
+	dGeomDisable(geom);
+	dBodyDisable(bdy);
+	dBodySetData(bdy, NULL);
+	clistDeleteNode(ctx->objList, &ent->node);
+	EntityStoreRemove(&ctx->entities, ent);
+	clistAddNode(ctx->retired[slot], bdy);
+}
+
+/** @brief reposition an entity as if it had just been created
+ *
+ * Cheaper than freeing an entity and creating another, the body keeps
+ * its shape and mass but is moved and woken with no velocity or pending
+ * forces, and any disabled geoms are enabled again. Entities that
+ * aren't live in this context are ignored.
+ *
+ * @param ctx physics context
+ * @param ent the entity to reuse
+ * @param pos new position
+ * @param rot new orientation (Euler angles)
+ */
+void RecycleEntity(PhysicsContext* ctx, entity* ent, Vector3 pos, Vector3 rot)
+{
+	dMatrix3 R;
+
+	if (EntityStoreGet(&ctx->entities, ent->handle) != ent) return;
+
+	dBodySetPosition(ent->body, pos.x, pos.y, pos.z);
+	dRFromEulerAngles(R, rot.x, rot.y, rot.z);
+	dBodySetRotation(ent->body, R);
+	resetBodyMotion(ent->body);
+
+	for (dGeomID g = dBodyGetFirstGeom(ent->body); g; g = dBodyGetNextGeom(g)) {
+		dGeomEnable(g);
+	}
+}
+
+/** @brief add a joint to the context's registry
+ *
+ * Joints made by the framework are registered for you, register your
+ * own so they can be found, iterated and freed along with the rest.
+ * The joint's data pointer is used to hold its handle.
+ *
+ * @param ctx physics context
+ * @param joint the joint
+ * @param kind what the joint belongs to, JOINT_USER for your own
+ * @return the joint's handle
+ */
+JointHandle RegisterJoint(PhysicsContext* ctx, dJointID joint, JointKind kind)
+{
+	JointHandle h = JointRegistryAdd(&ctx->joints, joint, kind);
+	dJointSetData(joint, (void*)(uintptr_t)h.id);
+	return h;
+}
+
+/** @brief get the handle of a registered joint
+ *
+ * @param joint the joint
+ * @return its handle, which won't resolve if it was never registered
+ */
+JointHandle GetJointHandle(dJointID joint)
+{
+	JointHandle h = { (uint32_t)(uintptr_t)dJointGetData(joint) };
+	return h;
+}
+
+/** @brief resolve a joint handle
+ *
+ * @param ctx physics context
+ * @param h the handle
+ * @return the joint or 0 if it has since been freed
+ */
+dJointID GetJoint(PhysicsContext* ctx, JointHandle h)
+{
+	return JointRegistryGet(&ctx->joints, h);
+}
+
+/** @brief number of registered joints, for use with GetJointAt
+ *
+ * @param ctx physics context
+ */
+int GetJointCount(PhysicsContext* ctx)
+{
+	return ctx->joints.table.count;
+}
+
+/** @brief get a registered joint by position
+ *
+ * Freeing a joint moves the last one into its place, loop backwards
+ * when freeing as you go
+ *
+ * @param ctx physics context
+ * @param i index from 0 to GetJointCount()-1
+ */
+dJointID GetJointAt(PhysicsContext* ctx, int i)
+{
+	return ctx->joints.joints[i];
+}
+
+/** @brief what kind of joint is at a position
+ *
+ * @param ctx physics context
+ * @param i index from 0 to GetJointCount()-1
+ */
+JointKind GetJointKindAt(PhysicsContext* ctx, int i)
+{
+	return (JointKind)ctx->joints.kinds[i];
+}
+
+/** @brief destroy a joint, removing it from the registry
+ *
+ * @param ctx physics context
+ * @param joint the joint, it doesn't have to be registered
+ */
+void FreeJoint(PhysicsContext* ctx, dJointID joint)
+{
+	JointHandle h = GetJointHandle(joint);
+	if (JointRegistryGet(&ctx->joints, h) == joint) {
+		JointRegistryRemove(&ctx->joints, h);
+	}
+	dJointDestroy(joint);
+}
+
+/** @brief destroy every registered joint of a kind
+ *
+ * @param ctx physics context
+ * @param kind the kind to destroy, JOINT_ANY for all of them
+ */
+void FreeJoints(PhysicsContext* ctx, JointKind kind)
+{
+	JointRegistry* jr = &ctx->joints;
+	for (int i = jr->table.count - 1; i >= 0; i--) {
+		if (kind != JOINT_ANY && jr->kinds[i] != kind) continue;
+		dJointID joint = jr->joints[i];
+		JointHandle h = { jr->table.handles[i] };
+		JointRegistryRemove(jr, h);
+		dJointDestroy(joint);
+	}
+}
+
+/** @brief set the motor of many joints in one go
+ *
+ * The parameters are parallel arrays, handle i gets velocity[i] and
+ * fmax[i]. Hinge, slider, piston and universal joints drive their
+ * first axis, hinge2 drives its second (the wheel axle). Stale handles
+ * are skipped and the joints' bodies are woken.
+ *
+ * @param ctx physics context
+ * @param handles the joints to drive
+ * @param velocity target velocity of each joint
+ * @param fmax maximum force (or torque) each joint can use, NULL to leave it as is
+ * @param n number of joints
+ */
+void SetJointMotors(PhysicsContext* ctx, const JointHandle* handles, const float* velocity, const float* fmax, int n)
+{
+	for (int i = 0; i < n; i++) {
+		dJointID j = JointRegistryGet(&ctx->joints, handles[i]);
+		if (!j) continue;
+		switch (dJointGetType(j)) {
+			case dJointTypeHinge:
+				dJointSetHingeParam(j, dParamVel, velocity[i]);
+				if (fmax) dJointSetHingeParam(j, dParamFMax, fmax[i]);
+				break;
+			case dJointTypeSlider:
+				dJointSetSliderParam(j, dParamVel, velocity[i]);
+				if (fmax) dJointSetSliderParam(j, dParamFMax, fmax[i]);
+				break;
+			case dJointTypePiston:
+				dJointSetPistonParam(j, dParamVel, velocity[i]);
+				if (fmax) dJointSetPistonParam(j, dParamFMax, fmax[i]);
+				break;
+			case dJointTypeUniversal:
+				dJointSetUniversalParam(j, dParamVel, velocity[i]);
+				if (fmax) dJointSetUniversalParam(j, dParamFMax, fmax[i]);
+				break;
+			case dJointTypeHinge2:
+				dJointSetHinge2Param(j, dParamVel2, velocity[i]);
+				if (fmax) dJointSetHinge2Param(j, dParamFMax2, fmax[i]);
+				break;
+			default:
+				continue;
+		}
+		for (int b = 0; b < 2; b++) {
+			dBodyID bdy = dJointGetBody(j, b);
+			if (bdy) dBodyEnable(bdy);
+		}
+	}
 }
 
 /** @brief creates a piston using two entities as its base on extending sections
@@ -1203,6 +2010,7 @@ void FreeEntity(PhysicsContext* physCtx, entity* ent)
 dJointID CreatePiston(PhysicsContext* physCtx, entity* entA, entity* entB, float strength)
 {
     dJointID joint = dJointCreateSlider(physCtx->world, 0);
+    RegisterJoint(physCtx, joint, JOINT_PISTON);
 
     dBodyID bodyA = entA->body;
     dBodyID bodyB = (entB != NULL) ? entB->body : 0; // 0 = world
@@ -1255,14 +2063,19 @@ void SetPistonLimits(dJointID joint, float min, float max)
 /**
  * @brief frees all the internal resources of a multipiston
  * 
+ * @param physCtx the physics context
  * @param mp the multipiston to free
  * 
  * @note this is not done automagically (like dynamic bodies for example)
  * when you create a multipiston add a call to this function in your
- * exit path
+ * exit path, its joints are destroyed, the sections are entities and
+ * are left in the world
  */
-void FreeMultiPiston(MultiPiston* mp)
+void FreeMultiPiston(PhysicsContext* physCtx, MultiPiston* mp)
 {
+	for (int i = 0; i < mp->count - 1; i++) {
+		FreeJoint(physCtx, mp->joints[i]);
+	}
 	free(mp->joints);
 	free(mp->sections);
 	free(mp);
@@ -1388,6 +2201,7 @@ void SetBodyOrientation(dBodyID body, Vector3 direction) {
 dJointID PinEntityToWorld(PhysicsContext* physCtx, entity* ent)
 {
 	dJointID pin = dJointCreateFixed (physCtx->world, 0);
+	RegisterJoint(physCtx, pin, JOINT_PIN);
     dJointAttach(pin, ent->body, 0);
     dJointSetFixed(pin);
     return pin;
@@ -1406,6 +2220,7 @@ dJointID PinEntityToWorld(PhysicsContext* physCtx, entity* ent)
 dJointID PinEntities(PhysicsContext* physCtx, entity* entA, entity* entB)
 {
 	dJointID pin = dJointCreateFixed (physCtx->world, 0);
+	RegisterJoint(physCtx, pin, JOINT_PIN);
     dJointAttach(pin, entA->body, entB->body);
     dJointSetFixed(pin);
     return pin;
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file renderBackend.c
+ * @brief The raylib and recording render backends
+ *
+ * The recording backend sorts and counts batches just as DrawInstances
+ * does, so the render stats read the same with either backend, then
+ * writes one record per instance.
+ *
+ * @author Chris Camacho (codifies - http://bedroomcoders.co.uk/)
+ * @date 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "renderBackend.h"
+#include "raymath.h"
+#include "rlgl.h"
+
+#define RECORD_GROW 1024
+
+static void* backendRealloc(void* ptr, size_t size)
+{
+	void* p = RL_REALLOC(ptr, size);
+	if (!p) {
+		printf("Couldn't allocate memory for draw records\n");
+		exit(-1);
+	}
+	return p;
+}
+
+static void raylibDrawInstances(RenderBackend* be, InstanceRenderer* r, Vector3 viewPos,
+								const Light* lights, const LightSet* sceneLights)
+{
+	(void)be;
+	DrawInstances(r, viewPos, lights, sceneLights);
+}
+
+static void raylibUploadLights(RenderBackend* be, LightUniforms* u, Shader shader, const Light* lights)
+{
+	(void)be;
+	UploadLights(u, shader, lights);
+}
+
+static void raylibDrawMesh(RenderBackend* be, const Mesh* mesh, Material material, Matrix transform)
+{
+	(void)be;
+	DrawMesh(*mesh, material, transform);
+}
+
+// whatever BeginMode3D set up
+static Matrix raylibViewProjection(RenderBackend* be, Camera camera)
+{
+	(void)be;
+	(void)camera;
+	return MatrixMultiply(rlGetMatrixModelview(), rlGetMatrixProjection());
+}
+
+static int raylibScreenHeight(RenderBackend* be)
+{
+	(void)be;
+	return GetScreenHeight();
+}
+
+/**
+ * @brief draw with raylib, CreateGraphics sets this up
+ */
+void InitRaylibBackend(RenderBackend* be)
+{
+	memset(be, 0, sizeof(*be));
+	be->drawInstances = raylibDrawInstances;
+	be->uploadLights = raylibUploadLights;
+	be->drawMesh = raylibDrawMesh;
+	be->viewProjection = raylibViewProjection;
+	be->screenHeight = raylibScreenHeight;
+}
+
+static DrawRecord* addRecord(RenderBackend* be)
+{
+	if (be->recordCount == be->recordCapacity) {
+		be->recordCapacity = be->recordCapacity ? be->recordCapacity * 2 : RECORD_GROW;
+		be->records = backendRealloc(be->records, be->recordCapacity * sizeof(DrawRecord));
+	}
+	return &be->records[be->recordCount++];
+}
+
+static unsigned char tintByte(float f)
+{
+	return (unsigned char)(f * 255.0f + 0.5f);
+}
+
+static void recordDrawInstances(RenderBackend* be, InstanceRenderer* r, Vector3 viewPos,
+								const Light* lights, const LightSet* sceneLights)
+{
+	(void)lights;
+	(void)sceneLights;
+	r->drawCalls = 0;
+	r->triangles = 0;
+	r->stateChanges = 0;
+	r->instanceCount = 0;
+	SortInstanceBatches(r, viewPos);
+
+	// the same binds DrawInstances would make, without a window every
+	// vertex array id is 0 so meshes are told apart by address
+	bool bound = false;
+	unsigned int texture = 0;
+	const Mesh* mesh = NULL;
+	for (int i = 0; i < r->queue.count; i++) {
+		InstanceBatch* b = &r->batches[r->queue.items[i]];
+
+		if (!bound || b->textureId != texture) {
+			texture = b->textureId;
+			r->stateChanges++;
+		}
+		if (!bound || b->mesh != mesh) {
+			mesh = b->mesh;
+			r->stateChanges++;
+		}
+		bound = true;
+
+		for (int k = 0; k < b->count; k++) {
+			const Instance* in = &b->instances[k];
+			DrawRecord* d = addRecord(be);
+			d->mesh = b->mesh;
+			d->textureId = b->textureId;
+			d->region = (int)in->region;
+			memcpy(d->transform, in->transform, sizeof(d->transform));
+			d->tint = (Color){ tintByte(in->tint[0]), tintByte(in->tint[1]),
+								tintByte(in->tint[2]), tintByte(in->tint[3]) };
+		}
+		r->drawCalls++;
+		r->instanceCount += b->count;
+		r->triangles += b->count * b->mesh->triangleCount;
+	}
+}
+
+// there are no shaders, nothing is sent
+static void recordUploadLights(RenderBackend* be, LightUniforms* u, Shader shader, const Light* lights)
+{
+	(void)be;
+	(void)u;
+	(void)shader;
+	(void)lights;
+}
+
+static void recordDrawMesh(RenderBackend* be, const Mesh* mesh, Material material, Matrix transform)
+{
+	const MaterialMap* diffuse = &material.maps[MATERIAL_MAP_DIFFUSE];
+	DrawRecord* d = addRecord(be);
+	d->mesh = mesh;
+	d->textureId = diffuse->texture.id;
+	d->region = 0;
+	memcpy(d->transform, MatrixToFloatV(transform).v, sizeof(d->transform));
+	d->tint = diffuse->color;
+}
+
+// the matrices BeginMode3D would make for the pretend view
+static Matrix recordViewProjection(RenderBackend* be, Camera camera)
+{
+	double aspect = (double)be->width / be->height;
+	Matrix projection;
+	if (camera.projection == CAMERA_ORTHOGRAPHIC) {
+		double top = camera.fovy / 2.0;
+		double right = top * aspect;
+		projection = MatrixOrtho(-right, right, -top, top, RL_CULL_DISTANCE_NEAR, RL_CULL_DISTANCE_FAR);
+	} else {
+		projection = MatrixPerspective(camera.fovy * DEG2RAD, aspect, RL_CULL_DISTANCE_NEAR, RL_CULL_DISTANCE_FAR);
+	}
+	return MatrixMultiply(MatrixLookAt(camera.position, camera.target, camera.up), projection);
+}
+
+static int recordScreenHeight(RenderBackend* be)
+{
+	return be->height;
+}
+
+/**
+ * @brief record draws instead of making them
+ *
+ * Nothing is drawn and no window is needed, every mesh drawn is added
+ * to the backend's records until ClearDrawRecords. Culling and levels
+ * of detail use the graphics context's camera as if it were looking
+ * through a view of the given size.
+ *
+ * @param be the backend
+ * @param width width of the pretend view in pixels
+ * @param height its height
+ */
+void InitRecordingBackend(RenderBackend* be, int width, int height)
+{
+	memset(be, 0, sizeof(*be));
+	be->drawInstances = recordDrawInstances;
+	be->uploadLights = recordUploadLights;
+	be->drawMesh = recordDrawMesh;
+	be->viewProjection = recordViewProjection;
+	be->screenHeight = recordScreenHeight;
+	be->width = width;
+	be->height = height;
+}
+
+/**
+ * @brief forget the recorded draws, the buffer is kept for the next frame
+ */
+void ClearDrawRecords(RenderBackend* be)
+{
+	be->recordCount = 0;
+}
+
+/**
+ * @brief free the recorded draws
+ */
+void FreeRenderBackend(RenderBackend* be)
+{
+	RL_FREE(be->records);
+	be->records = NULL;
+	be->recordCount = be->recordCapacity = 0;
+}
@@ -0,0 +1,349 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file renderPrep.c
+ * @brief Builds instance transforms in bulk from ODE poses
+ *
+ * A transform is the rotation with each column multiplied by the shape's
+ * scale on that axis, and a translation of the position. With the poses
+ * laid out as arrays, four entries make a 4x4 block: columns for four
+ * entries are computed side by side and transposed into each entry's
+ * matrix.
+ *
+ * @author Chris Camacho (codifies - http://bedroomcoders.co.uk/)
+ * @date 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#ifdef __SSE__
+#include <xmmintrin.h>
+#endif
+
+#include "raylib.h"
+#include "renderPrep.h"
+
+#define PREP_GROW 1024
+
+static void* prepRealloc(void* ptr, size_t size)
+{
+	void* p = RL_REALLOC(ptr, size);
+	if (!p) {
+		printf("Couldn't allocate memory for render prep\n");
+		exit(-1);
+	}
+	return p;
+}
+
+/**
+ * @brief empty the queue, keeping its storage
+ */
+void RenderPrepClear(RenderPrep* p)
+{
+	p->count = 0;
+}
+
+/**
+ * @brief queue a pose to be built into a transform
+ *
+ * @param p the render prep
+ * @param pos position, 3 floats as dGeomGetPosition gives
+ * @param rot rotation, 12 floats as dGeomGetRotation gives
+ * @param scale scale along the local axes
+ * @param slot the instance the transform is for
+ * @param cache where to keep a copy of the transform, or NULL
+ */
+void RenderPrepAdd(RenderPrep* p, const float* pos, const float* rot, Vector3 scale,
+					InstanceSlot slot, TransformCache* cache)
+{
+	if (p->count == p->capacity) {
+		p->capacity += PREP_GROW;
+		for (int i = 0; i < 9; i++) p->rot[i] = prepRealloc(p->rot[i], p->capacity * sizeof(float));
+		for (int i = 0; i < 3; i++) {
+			p->pos[i] = prepRealloc(p->pos[i], p->capacity * sizeof(float));
+			p->scale[i] = prepRealloc(p->scale[i], p->capacity * sizeof(float));
+		}
+		p->slots = prepRealloc(p->slots, p->capacity * sizeof(InstanceSlot));
+		p->dest = prepRealloc(p->dest, p->capacity * sizeof(float*));
+		p->cache = prepRealloc(p->cache, p->capacity * sizeof(TransformCache*));
+	}
+
+	int n = p->count++;
+	for (int row = 0; row < 3; row++) {
+		p->rot[row*3 + 0][n] = rot[row*4 + 0];
+		p->rot[row*3 + 1][n] = rot[row*4 + 1];
+		p->rot[row*3 + 2][n] = rot[row*4 + 2];
+	}
+	p->pos[0][n] = pos[0];
+	p->pos[1][n] = pos[1];
+	p->pos[2][n] = pos[2];
+	p->scale[0][n] = scale.x;
+	p->scale[1][n] = scale.y;
+	p->scale[2][n] = scale.z;
+	p->slots[n] = slot;
+	p->cache[n] = cache;
+}
+
+static void buildOne(RenderPrep* p, int i)
+{
+	float** r = p->rot;
+	float* m = p->dest[i];
+	float sx = p->scale[0][i], sy = p->scale[1][i], sz = p->scale[2][i];
+
+	m[0] = r[0][i] * sx;  m[1] = r[3][i] * sx;  m[2] = r[6][i] * sx;   m[3] = 0;
+	m[4] = r[1][i] * sy;  m[5] = r[4][i] * sy;  m[6] = r[7][i] * sy;   m[7] = 0;
+	m[8] = r[2][i] * sz;  m[9] = r[5][i] * sz;  m[10] = r[8][i] * sz;  m[11] = 0;
+	m[12] = p->pos[0][i];
+	m[13] = p->pos[1][i];
+	m[14] = p->pos[2][i];
+	m[15] = 1;
+}
+
+/**
+ * @brief build the transforms for entries from up to (not including) to
+ *
+ * The destinations must already be resolved, RenderPrepBuild does that
+ * and then calls this, possibly from several threads.
+ */
+void RenderPrepBuildRange(RenderPrep* p, int from, int to)
+{
+	int i = from;
+
+#ifdef __SSE__
+	float** r = p->rot;
+	__m128 zero = _mm_setzero_ps();
+	__m128 one = _mm_set1_ps(1);
+
+	for (; i + 4 <= to; i += 4) {
+		__m128 sx = _mm_loadu_ps(&p->scale[0][i]);
+		__m128 sy = _mm_loadu_ps(&p->scale[1][i]);
+		__m128 sz = _mm_loadu_ps(&p->scale[2][i]);
+
+		// rotation rows, each holding one element for four entries
+		__m128 r0 = _mm_loadu_ps(&r[0][i]), r1 = _mm_loadu_ps(&r[1][i]), r2 = _mm_loadu_ps(&r[2][i]);
+		__m128 r3 = _mm_loadu_ps(&r[3][i]), r4 = _mm_loadu_ps(&r[4][i]), r5 = _mm_loadu_ps(&r[5][i]);
+		__m128 r6 = _mm_loadu_ps(&r[6][i]), r7 = _mm_loadu_ps(&r[7][i]), r8 = _mm_loadu_ps(&r[8][i]);
+
+		// the four columns of all four matrices, element by element
+		__m128 c0x = _mm_mul_ps(r0, sx), c0y = _mm_mul_ps(r3, sx), c0z = _mm_mul_ps(r6, sx), c0w = zero;
+		__m128 c1x = _mm_mul_ps(r1, sy), c1y = _mm_mul_ps(r4, sy), c1z = _mm_mul_ps(r7, sy), c1w = zero;
+		__m128 c2x = _mm_mul_ps(r2, sz), c2y = _mm_mul_ps(r5, sz), c2z = _mm_mul_ps(r8, sz), c2w = zero;
+		__m128 c3x = _mm_loadu_ps(&p->pos[0][i]);
+		__m128 c3y = _mm_loadu_ps(&p->pos[1][i]);
+		__m128 c3z = _mm_loadu_ps(&p->pos[2][i]);
+		__m128 c3w = one;
+
+		// after transposing, register k holds a column of entry i + k
+		_MM_TRANSPOSE4_PS(c0x, c0y, c0z, c0w);
+		_MM_TRANSPOSE4_PS(c1x, c1y, c1z, c1w);
+		_MM_TRANSPOSE4_PS(c2x, c2y, c2z, c2w);
+		_MM_TRANSPOSE4_PS(c3x, c3y, c3z, c3w);
+
+		float** d = &p->dest[i];
+		_mm_storeu_ps(d[0], c0x); _mm_storeu_ps(d[0] + 4, c1x); _mm_storeu_ps(d[0] + 8, c2x); _mm_storeu_ps(d[0] + 12, c3x);
+		_mm_storeu_ps(d[1], c0y); _mm_storeu_ps(d[1] + 4, c1y); _mm_storeu_ps(d[1] + 8, c2y); _mm_storeu_ps(d[1] + 12, c3y);
+		_mm_storeu_ps(d[2], c0z); _mm_storeu_ps(d[2] + 4, c1z); _mm_storeu_ps(d[2] + 8, c2z); _mm_storeu_ps(d[2] + 12, c3z);
+		_mm_storeu_ps(d[3], c0w); _mm_storeu_ps(d[3] + 4, c1w); _mm_storeu_ps(d[3] + 8, c2w); _mm_storeu_ps(d[3] + 12, c3w);
+	}
+#endif
+
+	for (; i < to; i++) buildOne(p, i);
+
+	for (i = from; i < to; i++) {
+		if (!p->cache[i]) continue;
+		memcpy(p->cache[i]->transform, p->dest[i], sizeof(p->cache[i]->transform));
+		p->cache[i]->valid = true;
+	}
+}
+
+typedef struct PrepJob {
+	PrepPool* pool;
+	RenderPrep* prep;
+	int from;
+	int to;
+} PrepJob;
+
+// workers wait for the generation to change, build their job's range
+// and count themselves off
+struct PrepPool {
+	pthread_mutex_t lock;
+	pthread_cond_t start;
+	pthread_cond_t done;
+	pthread_t tid[RENDER_PREP_THREADS];
+	PrepJob jobs[RENDER_PREP_THREADS];	// the caller builds share 0, workers 1 on
+	int workers;			// started, they are jobs 1 to workers
+	int generation;
+	int busy;
+	bool quit;
+};
+
+static void* prepWorker(void* data)
+{
+	PrepJob* job = data;
+	PrepPool* pool = job->pool;
+	int seen = 0;
+
+	pthread_mutex_lock(&pool->lock);
+	for (;;) {
+		while (pool->generation == seen && !pool->quit) pthread_cond_wait(&pool->start, &pool->lock);
+		if (pool->quit) break;
+		seen = pool->generation;
+		PrepJob j = *job;
+		pthread_mutex_unlock(&pool->lock);
+
+		if (j.from < j.to) RenderPrepBuildRange(j.prep, j.from, j.to);
+
+		pthread_mutex_lock(&pool->lock);
+		if (--pool->busy == 0) pthread_cond_signal(&pool->done);
+	}
+	pthread_mutex_unlock(&pool->lock);
+	return NULL;
+}
+
+// start the workers, fewer if the system won't give us them all
+static PrepPool* startPool(void)
+{
+	PrepPool* pool = prepRealloc(NULL, sizeof(PrepPool));
+	memset(pool, 0, sizeof(PrepPool));
+	pthread_mutex_init(&pool->lock, NULL);
+	pthread_cond_init(&pool->start, NULL);
+	pthread_cond_init(&pool->done, NULL);
+
+	for (int t = 1; t < RENDER_PREP_THREADS; t++) {
+		pool->jobs[t].pool = pool;
+		if (pthread_create(&pool->tid[t], NULL, prepWorker, &pool->jobs[t])) break;
+		pool->workers = t;
+	}
+	return pool;
+}
+
+static void stopPool(PrepPool* pool)
+{
+	pthread_mutex_lock(&pool->lock);
+	pool->quit = true;
+	pthread_cond_broadcast(&pool->start);
+	pthread_mutex_unlock(&pool->lock);
+	for (int t = 1; t <= pool->workers; t++) pthread_join(pool->tid[t], NULL);
+
+	pthread_cond_destroy(&pool->done);
+	pthread_cond_destroy(&pool->start);
+	pthread_mutex_destroy(&pool->lock);
+	RL_FREE(pool);
+}
+
+/**
+ * @brief build every queued transform into its instance
+ *
+ * Must be called after the last AddInstance before drawing, as adding
+ * instances can move where they are stored. Big queues are split over
+ * RENDER_PREP_THREADS threads, the caller builds the first share. The
+ * first big build starts the worker threads, after that builds reuse
+ * them and allocate nothing.
+ *
+ * @param p the render prep, left as it is, clear it for the next frame
+ * @param r the renderer the slots belong to
+ */
+void RenderPrepBuild(RenderPrep* p, InstanceRenderer* r)
+{
+	for (int i = 0; i < p->count; i++) {
+		p->dest[i] = InstanceTransform(r, p->slots[i]);
+	}
+
+	p->threads = 1;
+	if (p->count >= RENDER_PREP_MT_THRESHOLD && !p->pool) p->pool = startPool();
+	PrepPool* pool = p->count >= RENDER_PREP_MT_THRESHOLD ? p->pool : NULL;
+	if (!pool || !pool->workers) {
+		RenderPrepBuildRange(p, 0, p->count);
+		return;
+	}
+
+	int threads = pool->workers + 1;
+	int share = (p->count + threads - 1) / threads;
+	share = (share + 3) & ~3;	// keep every share but the last a multiple of four
+
+	pthread_mutex_lock(&pool->lock);
+	for (int t = 1; t < threads; t++) {
+		PrepJob* job = &pool->jobs[t];
+		job->prep = p;
+		job->from = t * share < p->count ? t * share : p->count;
+		job->to = (t + 1) * share < p->count ? (t + 1) * share : p->count;
+		if (job->from < job->to) p->threads++;
+	}
+	pool->busy = pool->workers;
+	pool->generation++;
+	pthread_cond_broadcast(&pool->start);
+	pthread_mutex_unlock(&pool->lock);
+
+	RenderPrepBuildRange(p, 0, share < p->count ? share : p->count);
+
+	pthread_mutex_lock(&pool->lock);
+	while (pool->busy) pthread_cond_wait(&pool->done, &pool->lock);
+	pthread_mutex_unlock(&pool->lock);
+}
+
+/**
+ * @brief stop the worker threads and release the queue's storage
+ */
+void FreeRenderPrep(RenderPrep* p)
+{
+	if (p->pool) stopPool(p->pool);
+	for (int i = 0; i < 9; i++) RL_FREE(p->rot[i]);
+	for (int i = 0; i < 3; i++) {
+		RL_FREE(p->pos[i]);
+		RL_FREE(p->scale[i]);
+	}
+	RL_FREE(p->slots);
+	RL_FREE(p->dest);
+	RL_FREE(p->cache);
+	*p = (RenderPrep){ 0 };
+}
+
+/**
+ * @brief can a cached transform be used for this pose
+ *
+ * When it can't the pose is remembered, queue the geom with the cache
+ * and the build refreshes the transform.
+ *
+ * @param c the geom's cache
+ * @param pos position, 3 floats as dGeomGetPosition gives
+ * @param rot rotation, 12 floats as dGeomGetRotation gives
+ * @param scale scale along the local axes
+ * @return true if c->transform is the transform for this pose
+ */
+bool TransformCacheMatch(TransformCache* c, const float* pos, const float* rot, Vector3 scale)
+{
+	float pose[15] = {
+		pos[0], pos[1], pos[2],
+		rot[0], rot[1], rot[2], rot[4], rot[5], rot[6], rot[8], rot[9], rot[10],
+		scale.x, scale.y, scale.z
+	};
+	if (c->valid && !memcmp(pose, c->pose, sizeof(pose))) return true;
+
+	memcpy(c->pose, pose, sizeof(pose));
+	c->valid = false;
+	return false;
+}
@@ -0,0 +1,167 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file renderQueue.c
+ * @brief Draw items ordered by packed 64 bit sort keys
+ *
+ * The sort is a least significant byte first radix sort, stable so
+ * items with equal keys stay in the order they were pushed. A byte that
+ * is the same in every key is skipped, as the framework's keys share
+ * most of their top bits a typical frame only needs a few passes.
+ *
+ * @author Chris Camacho (codifies - http://bedroomcoders.co.uk/)
+ * @date 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "raylib.h"
+#include "renderQueue.h"
+
+#define QUEUE_GROW 64
+
+static void* queueRealloc(void* ptr, size_t size)
+{
+	void* p = RL_REALLOC(ptr, size);
+	if (!p) {
+		printf("Couldn't allocate memory for the render queue\n");
+		exit(-1);
+	}
+	return p;
+}
+
+static uint64_t field(unsigned int value, int bits)
+{
+	return (uint64_t)value & ((1ull << bits) - 1);
+}
+
+/**
+ * @brief pack a sort key, fields wider than their bits are truncated
+ *
+ * @param pass RENDER_PASS_OPAQUE and so on, drawn in increasing order
+ * @param shader shader id
+ * @param texture texture id
+ * @param mesh mesh id, its vertex array id for example
+ * @param depthSq squared distance from the camera, nearer sorts first
+ */
+uint64_t RenderKey(unsigned int pass, unsigned int shader, unsigned int texture, unsigned int mesh, float depthSq)
+{
+	// a positive float's bits sort the same way as its value, the top
+	// ones are kept
+	uint32_t bits = 0;
+	if (depthSq > 0) memcpy(&bits, &depthSq, sizeof(bits));
+	uint64_t depth = bits >> (32 - RENDER_KEY_DEPTH_BITS);
+
+	uint64_t key = field(pass, RENDER_KEY_PASS_BITS);
+	key = (key << RENDER_KEY_SHADER_BITS) | field(shader, RENDER_KEY_SHADER_BITS);
+	key = (key << RENDER_KEY_TEXTURE_BITS) | field(texture, RENDER_KEY_TEXTURE_BITS);
+	key = (key << RENDER_KEY_MESH_BITS) | field(mesh, RENDER_KEY_MESH_BITS);
+	key = (key << RENDER_KEY_DEPTH_BITS) | depth;
+	return key;
+}
+
+/**
+ * @brief empty the queue, keeping its storage
+ */
+void RenderQueueClear(RenderQueue* q)
+{
+	q->count = 0;
+}
+
+/**
+ * @brief add a draw item
+ *
+ * @param q the queue
+ * @param key from RenderKey
+ * @param item what the caller draws for it, an index into its own list
+ */
+void RenderQueuePush(RenderQueue* q, uint64_t key, int item)
+{
+	if (q->count == q->capacity) {
+		q->capacity = q->capacity ? q->capacity * 2 : QUEUE_GROW;
+		q->keys = queueRealloc(q->keys, q->capacity * sizeof(uint64_t));
+		q->items = queueRealloc(q->items, q->capacity * sizeof(int));
+		q->spareKeys = queueRealloc(q->spareKeys, q->capacity * sizeof(uint64_t));
+		q->spareItems = queueRealloc(q->spareItems, q->capacity * sizeof(int));
+	}
+	q->keys[q->count] = key;
+	q->items[q->count] = item;
+	q->count++;
+}
+
+/**
+ * @brief sort the queue into increasing key order
+ */
+void RenderQueueSort(RenderQueue* q)
+{
+	int counts[8][256];
+	memset(counts, 0, sizeof(counts));
+
+	// all eight histograms in one read of the keys
+	for (int i = 0; i < q->count; i++) {
+		uint64_t k = q->keys[i];
+		for (int b = 0; b < 8; b++) counts[b][(k >> (b * 8)) & 0xff]++;
+	}
+
+	q->sortPasses = 0;
+	for (int b = 0; b < 8; b++) {
+		int* c = counts[b];
+		// every key has the same byte here, nothing would move
+		if (q->count && c[(q->keys[0] >> (b * 8)) & 0xff] == q->count) continue;
+
+		int offset = 0;
+		for (int d = 0; d < 256; d++) {
+			int n = c[d];
+			c[d] = offset;
+			offset += n;
+		}
+		for (int i = 0; i < q->count; i++) {
+			int dst = c[(q->keys[i] >> (b * 8)) & 0xff]++;
+			q->spareKeys[dst] = q->keys[i];
+			q->spareItems[dst] = q->items[i];
+		}
+
+		uint64_t* keys = q->keys;
+		q->keys = q->spareKeys;
+		q->spareKeys = keys;
+		int* items = q->items;
+		q->items = q->spareItems;
+		q->spareItems = items;
+		q->sortPasses++;
+	}
+}
+
+/**
+ * @brief release the queue's storage
+ */
+void FreeRenderQueue(RenderQueue* q)
+{
+	RL_FREE(q->keys);
+	RL_FREE(q->items);
+	RL_FREE(q->spareKeys);
+	RL_FREE(q->spareItems);
+	*q = (RenderQueue){ 0 };
+}
@@ -10,9 +10,15 @@
  * Copyright (c) 2017-2023 Victor Fisac (@victorfisac) and Ramon Santamaria (@raysan5)
  */
 #include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
 #include "raylib.h"
 #include "rlights.h"
 
+#define LIGHT_SET_GROW 16
+
 //----------------------------------------------------------------------------------
 // Global Variables Definition
 //----------------------------------------------------------------------------------
@@ -50,7 +56,7 @@ Light CreateLight(int type, Vector3 position, Vector3 target, Color color, Shade
     return light;
 }
 
-// Send light properties to shader
+// Send light properties to shader, all of them, UploadLights only sends what changed
 // NOTE: Light shader locations should be available
 void UpdateLightValues(Shader shader, Light light)
 {
@@ -71,3 +77,183 @@ void UpdateLightValues(Shader shader, Light light)
                        (float)light.color.b/(float)255, (float)light.color.a/(float)255 };
     SetShaderValue(shader, light.colorLoc, color, SHADER_UNIFORM_VEC4);
 }
+
+// Get the uniform locations of MAX_LIGHTS lights, the values are sent on
+// the first UploadLights
+void InitLightUniforms(LightUniforms* u, Shader shader)
+{
+    memset(u, 0, sizeof(*u));
+    for (int i = 0; i < MAX_LIGHTS; i++)
+    {
+        Light* l = &u->slots[i];
+        l->enabledLoc = GetShaderLocation(shader, TextFormat("lights[%i].enabled", i));
+        l->typeLoc = GetShaderLocation(shader, TextFormat("lights[%i].type", i));
+        l->positionLoc = GetShaderLocation(shader, TextFormat("lights[%i].position", i));
+        l->targetLoc = GetShaderLocation(shader, TextFormat("lights[%i].target", i));
+        l->colorLoc = GetShaderLocation(shader, TextFormat("lights[%i].color", i));
+    }
+}
+
+static bool sameVector(Vector3 a, Vector3 b)
+{
+    return a.x == b.x && a.y == b.y && a.z == b.z;
+}
+
+static bool sameColor(Color a, Color b)
+{
+    return a.r == b.r && a.g == b.g && a.b == b.b && a.a == b.a;
+}
+
+// Send MAX_LIGHTS lights to the shader, a uniform is only sent if its
+// value differs from what was last sent, nothing but the enabled flag is
+// sent for a disabled light. Returns how many uniforms were sent
+// NOTE: only valid while nothing else sets the same uniforms, otherwise
+// clear valid first
+int UploadLights(LightUniforms* u, Shader shader, const Light* lights)
+{
+    int sent = 0;
+    bool all = !u->valid;
+
+    for (int i = 0; i < MAX_LIGHTS; i++)
+    {
+        Light* s = &u->slots[i];
+        const Light* l = &lights[i];
+
+        if (all || s->enabled != l->enabled)
+        {
+            int enabled = l->enabled;
+            SetShaderValue(shader, s->enabledLoc, &enabled, SHADER_UNIFORM_INT);
+            s->enabled = l->enabled;
+            sent++;
+        }
+        if (!l->enabled && !all) continue;
+
+        if (all || s->type != l->type)
+        {
+            SetShaderValue(shader, s->typeLoc, &l->type, SHADER_UNIFORM_INT);
+            s->type = l->type;
+            sent++;
+        }
+        if (all || !sameVector(s->position, l->position))
+        {
+            SetShaderValue(shader, s->positionLoc, &l->position, SHADER_UNIFORM_VEC3);
+            s->position = l->position;
+            sent++;
+        }
+        if (all || !sameVector(s->target, l->target))
+        {
+            SetShaderValue(shader, s->targetLoc, &l->target, SHADER_UNIFORM_VEC3);
+            s->target = l->target;
+            sent++;
+        }
+        if (all || !sameColor(s->color, l->color))
+        {
+            float color[4] = { (float)l->color.r/(float)255, (float)l->color.g/(float)255,
+                               (float)l->color.b/(float)255, (float)l->color.a/(float)255 };
+            SetShaderValue(shader, s->colorLoc, color, SHADER_UNIFORM_VEC4);
+            s->color = l->color;
+            sent++;
+        }
+    }
+
+    u->valid = true;
+    u->uniformsSent += sent;
+    return sent;
+}
+
+// Add a light to a set, returns its index, the set's array may move
+int AddSetLight(LightSet* set, int type, Vector3 position, Vector3 target, Color color)
+{
+    if (set->count == set->capacity)
+    {
+        int capacity = set->capacity ? set->capacity*2 : LIGHT_SET_GROW;
+        Light* lights = RL_REALLOC(set->lights, capacity*sizeof(Light));
+        if (!lights)
+        {
+            printf("Couldn't allocate memory for light set\n");
+            exit(-1);
+        }
+        set->lights = lights;
+        set->capacity = capacity;
+    }
+
+    Light* l = &set->lights[set->count];
+    memset(l, 0, sizeof(*l));
+    l->enabled = true;
+    l->type = type;
+    l->position = position;
+    l->target = target;
+    l->color = color;
+    return set->count++;
+}
+
+// How much a light matters to a region, directional lights reach
+// everything so always come first, point lights by brightness falling
+// off with distance from the region's surface
+static float lightScore(const Light* l, Vector3 centre, float radius)
+{
+    float brightness = (l->color.r + l->color.g + l->color.b)/765.0f;
+    if (l->type == LIGHT_DIRECTIONAL) return 1e6f + brightness;
+
+    float dx = l->position.x - centre.x;
+    float dy = l->position.y - centre.y;
+    float dz = l->position.z - centre.z;
+    float d = sqrtf(dx*dx + dy*dy + dz*dz) - radius;
+    if (d < 0) d = 0;
+    return brightness/(1.0f + d*d);
+}
+
+// Pick the MAX_LIGHTS lights that matter most to a sphere around centre,
+// out gets them in the order they are in the set so the same choice
+// fills the same slots, slots left over are disabled
+void SelectLights(const LightSet* set, Vector3 centre, float radius, Light* out)
+{
+    int best[MAX_LIGHTS];
+    float score[MAX_LIGHTS];
+    int found = 0;
+
+    for (int i = 0; i < set->count; i++)
+    {
+        const Light* l = &set->lights[i];
+        if (!l->enabled) continue;
+
+        float s = lightScore(l, centre, radius);
+        if (found == MAX_LIGHTS && s <= score[found - 1]) continue;
+
+        // insert keeping the best first, dropping the worst when full
+        int k = (found < MAX_LIGHTS) ? found++ : found - 1;
+        while (k > 0 && score[k - 1] < s)
+        {
+            best[k] = best[k - 1];
+            score[k] = score[k - 1];
+            k--;
+        }
+        best[k] = i;
+        score[k] = s;
+    }
+
+    // back into set order
+    for (int i = 1; i < found; i++)
+    {
+        int b = best[i];
+        int k = i;
+        while (k > 0 && best[k - 1] > b)
+        {
+            best[k] = best[k - 1];
+            k--;
+        }
+        best[k] = b;
+    }
+
+    for (int i = 0; i < MAX_LIGHTS; i++)
+    {
+        if (i < found) out[i] = set->lights[best[i]];
+        else memset(&out[i], 0, sizeof(Light));
+    }
+}
+
+void FreeLightSet(LightSet* set)
+{
+    RL_FREE(set->lights);
+    memset(set, 0, sizeof(*set));
+}
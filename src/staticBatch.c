@@ -0,0 +1,287 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file staticBatch.c
+ * @brief Static primitives merged into a few meshes
+ *
+ * Baking is done in two passes over the statics list, the first finds
+ * each geom's batch and counts the vertices it will add, the second
+ * fills the exactly sized arrays. Indexed meshes are expanded, so the
+ * merged meshes have no index limit.
+ *
+ * @author Chris Camacho (codifies - http://bedroomcoders.co.uk/)
+ * @date 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <string.h>
+
+#include "raylibODE.h"
+
+#define BATCH_GROW 16
+
+// DrawMesh goes through this many material maps, it is in raylib's config.h
+#ifndef MAX_MATERIAL_MAPS
+#define MAX_MATERIAL_MAPS 12
+#endif
+
+static void* batchRealloc(void* ptr, size_t size)
+{
+	void* p = RL_REALLOC(ptr, size);
+	if (!p) {
+		printf("Couldn't allocate memory for static batches\n");
+		exit(-1);
+	}
+	return p;
+}
+
+/**
+ * @brief unload every batch's mesh and release the batches
+ */
+void FreeStaticBatches(StaticBatches* sb)
+{
+	for (int i = 0; i < sb->count; i++) UnloadMesh(sb->batches[i].mesh);
+	RL_FREE(sb->batches);
+	*sb = (StaticBatches){ 0 };
+}
+
+// the framework mesh a static geom is drawn with and its scale, NULL if
+// the geom can't be baked
+static Mesh* bakeSource(GraphicsContext* gfxCtx, dGeomID geom, Vector3* scale)
+{
+	geomInfo* gi = dGeomGetData(geom);
+	if (!gi || !gi->texture || gi->triggerOnCollide || gi->visual.meshCount) return NULL;
+
+	dReal r, l;
+	dVector3 size;
+	switch (dGeomGetClass(geom)) {
+		case dBoxClass:
+			dGeomBoxGetLengths(geom, size);
+			*scale = (Vector3){ size[0], size[1], size[2] };
+			return &gfxCtx->box.meshes[0];
+		case dSphereClass:
+			r = dGeomSphereGetRadius(geom);
+			*scale = (Vector3){ r*2, r*2, r*2 };
+			return gfxCtx->ballLod.levels[0];
+		case dCylinderClass:
+			dGeomCylinderGetParams(geom, &r, &l);
+			*scale = (Vector3){ r*2, r*2, l };
+			return gfxCtx->cylinderLod.levels[0];
+		case dCapsuleClass:
+			dGeomCapsuleGetParams(geom, &r, &l);
+			*scale = (Vector3){ r, r, r };
+			return GetCapsuleMesh(&gfxCtx->capsules, r, l, 0);
+		default:
+			return NULL;
+	}
+}
+
+// the batch for a geom's texture and cell, made if there isn't one yet
+static StaticBatch* findBatch(StaticBatches* sb, const Texture* texture, const dReal* pos)
+{
+	int cell[3];
+	for (int a = 0; a < 3; a++) cell[a] = (int)floorf(pos[a] / STATIC_BATCH_CELL);
+
+	for (int i = 0; i < sb->count; i++) {
+		StaticBatch* b = &sb->batches[i];
+		if (b->texture == texture && !memcmp(b->cell, cell, sizeof(cell))) return b;
+	}
+
+	if (sb->count == sb->capacity) {
+		sb->capacity += BATCH_GROW;
+		sb->batches = batchRealloc(sb->batches, sb->capacity * sizeof(StaticBatch));
+	}
+	StaticBatch* b = &sb->batches[sb->count++];
+	memset(b, 0, sizeof(*b));
+	b->texture = texture;
+	memcpy(b->cell, cell, sizeof(cell));
+	for (int a = 0; a < 3; a++) {
+		b->aabb[a*2] = INFINITY;
+		b->aabb[a*2 + 1] = -INFINITY;
+	}
+	return b;
+}
+
+static int sourceVertices(const Mesh* m)
+{
+	return m->indices ? m->triangleCount * 3 : m->vertexCount;
+}
+
+// append a geom's mesh to its batch in world space
+static void bakeGeom(StaticBatch* b, const Mesh* m, dGeomID geom, Vector3 scale)
+{
+	geomInfo* gi = dGeomGetData(geom);
+	const dReal* pos = dGeomGetPosition(geom);
+	const dReal* R = dGeomGetRotation(geom);
+	float s[3] = { scale.x, scale.y, scale.z };
+	int n = sourceVertices(m);
+	Mesh* out = &b->mesh;
+
+	for (int k = 0; k < n; k++) {
+		int src = m->indices ? m->indices[k] : k;
+		int dst = out->vertexCount++;
+		float p[3], nrm[3];
+		for (int a = 0; a < 3; a++) {
+			p[a] = m->vertices[src*3 + a] * s[a];
+			// normals scale inversely, so they stay at right angles to the surface
+			nrm[a] = m->normals ? m->normals[src*3 + a] / (s[a] != 0 ? s[a] : 1) : 0;
+		}
+
+		float len = 0;
+		for (int row = 0; row < 3; row++) {
+			float w = pos[row] + R[row*4]*p[0] + R[row*4 + 1]*p[1] + R[row*4 + 2]*p[2];
+			float wn = R[row*4]*nrm[0] + R[row*4 + 1]*nrm[1] + R[row*4 + 2]*nrm[2];
+			out->vertices[dst*3 + row] = w;
+			out->normals[dst*3 + row] = wn;
+			len += wn * wn;
+			if (w < b->aabb[row*2]) b->aabb[row*2] = w;
+			if (w > b->aabb[row*2 + 1]) b->aabb[row*2 + 1] = w;
+		}
+		len = len > 0 ? 1.0f / sqrtf(len) : 0;
+		for (int a = 0; a < 3; a++) out->normals[dst*3 + a] *= len;
+
+		out->texcoords[dst*2] = m->texcoords ? m->texcoords[src*2] * gi->uvScaleU : 0;
+		out->texcoords[dst*2 + 1] = m->texcoords ? m->texcoords[src*2 + 1] * gi->uvScaleV : 0;
+		out->colors[dst*4] = gi->hew.r;
+		out->colors[dst*4 + 1] = gi->hew.g;
+		out->colors[dst*4 + 2] = gi->hew.b;
+		out->colors[dst*4 + 3] = gi->hew.a;
+	}
+	out->triangleCount = out->vertexCount / 3;
+	b->geoms++;
+}
+
+/**
+ * @brief merge the static primitives into a few meshes
+ *
+ * Static boxes, spheres, cylinders and capsules are merged per texture
+ * and grid cell, DrawStatics then draws each batch in one call instead
+ * of culling and queuing every geom. Trimeshes and other geoms with
+ * their own model are drawn as before.
+ *
+ * The batches are baked again by DrawStatics when geoms are added to or
+ * removed from the statics list, even if as many went as came. Call
+ * this again after moving, resizing or tinting a static geom that has
+ * been baked.
+ *
+ * @param ctx the physics context, its statics list is baked
+ * @param gfxCtx the graphics context the batches belong to
+ */
+void BakeStaticRenderBatches(PhysicsContext* ctx, GraphicsContext* gfxCtx)
+{
+	StaticBatches* sb = &gfxCtx->staticBatches;
+	FreeStaticBatches(sb);
+	sb->baked = true;
+	sb->staticVersion = ctx->statics->version;
+
+	// work out which batch every geom goes in and how big the batches get
+	for (cnode_t* node = ctx->statics->head; node; node = node->next) {
+		dGeomID geom = node->data;
+		geomInfo* gi = dGeomGetData(geom);
+		if (gi) gi->baked = false;
+
+		Vector3 scale;
+		Mesh* m = bakeSource(gfxCtx, geom, &scale);
+		if (!m) continue;
+		StaticBatch* b = findBatch(sb, gi->texture, dGeomGetPosition(geom));
+		b->mesh.vertexCount += sourceVertices(m);
+	}
+
+	for (int i = 0; i < sb->count; i++) {
+		Mesh* mesh = &sb->batches[i].mesh;
+		mesh->vertices = RL_CALLOC(mesh->vertexCount * 3, sizeof(float));
+		mesh->normals = RL_CALLOC(mesh->vertexCount * 3, sizeof(float));
+		mesh->texcoords = RL_CALLOC(mesh->vertexCount * 2, sizeof(float));
+		mesh->colors = RL_CALLOC(mesh->vertexCount * 4, sizeof(unsigned char));
+		if (!mesh->vertices || !mesh->normals || !mesh->texcoords || !mesh->colors) {
+			printf("Couldn't allocate memory for static batches\n");
+			exit(-1);
+		}
+		mesh->vertexCount = 0;	// counted again as the geoms go in
+	}
+
+	for (cnode_t* node = ctx->statics->head; node; node = node->next) {
+		dGeomID geom = node->data;
+		Vector3 scale;
+		Mesh* m = bakeSource(gfxCtx, geom, &scale);
+		if (!m) continue;
+		geomInfo* gi = dGeomGetData(geom);
+		bakeGeom(findBatch(sb, gi->texture, dGeomGetPosition(geom)), m, geom, scale);
+		gi->baked = true;
+	}
+
+	if (!IsWindowReady()) return;	// recording graphics, there is nothing to upload to
+	for (int i = 0; i < sb->count; i++) UploadMesh(&sb->batches[i].mesh, false);
+}
+
+/**
+ * @brief draw the baked static batches inside the current 3D view
+ *
+ * Called by DrawStatics, which adds what was drawn to the render stats.
+ * With scene lights each batch is lit by the ones that matter most to
+ * its cell, the context's own lights are put back afterwards.
+ *
+ * @param gfxCtx the graphics context
+ */
+void DrawStaticRenderBatches(GraphicsContext* gfxCtx)
+{
+	StaticBatches* sb = &gfxCtx->staticBatches;
+	RenderStats* stats = &gfxCtx->renderStats;
+	Frustum f = FrustumFromMatrix(gfxCtx->backend.viewProjection(&gfxCtx->backend, gfxCtx->camera));
+
+	// tint and uv scale are in the vertices, the material only needs the texture
+	MaterialMap maps[MAX_MATERIAL_MAPS] = { 0 };
+	Material material = { gfxCtx->shader, maps, { 0 } };
+	maps[MATERIAL_MAP_DIFFUSE].color = WHITE;
+
+	// anything may have sent lights to this shader since the last frame
+	RenderBackend* be = &gfxCtx->backend;
+	bool perBatch = gfxCtx->sceneLights.count && sb->count;
+	if (perBatch) gfxCtx->lightUniforms.valid = false;
+
+	for (int i = 0; i < sb->count; i++) {
+		StaticBatch* b = &sb->batches[i];
+		if (!FrustumTestBox(&f, b->aabb)) {
+			stats->staticGeomsCulled += b->geoms;
+			continue;
+		}
+		if (perBatch) {
+			const float* a = b->aabb;
+			Vector3 lo = { a[0], a[2], a[4] }, hi = { a[1], a[3], a[5] };
+			Light chosen[MAX_LIGHTS];
+			SelectLights(&gfxCtx->sceneLights, Vector3Scale(Vector3Add(lo, hi), 0.5f),
+						Vector3Distance(lo, hi) * 0.5f, chosen);
+			be->uploadLights(be, &gfxCtx->lightUniforms, gfxCtx->shader, chosen);
+		}
+		maps[MATERIAL_MAP_DIFFUSE].texture = *b->texture;
+		be->drawMesh(be, &b->mesh, material, MatrixIdentity());
+		stats->staticGeoms += b->geoms;
+		stats->staticDrawCalls++;
+		stats->staticStateChanges += 2;	// DrawMesh binds the texture and mesh every time
+		stats->staticTriangles += b->mesh.triangleCount;
+	}
+	if (perBatch) be->uploadLights(be, &gfxCtx->lightUniforms, gfxCtx->shader, gfxCtx->lights);
+}
@@ -0,0 +1,245 @@
+/*
+ * Copyright (c) 2026 Chris Camacho (codifies -  http://bedroomcoders.co.uk/)
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy
+ * of this software and associated documentation files (the "Software"), to deal
+ * in the Software without restriction, including without limitation the rights
+ * to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+ * copies of the Software, and to permit persons to whom the Software is
+ * furnished to do so, subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in
+ * all copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+ * FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+ * AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+ * LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+ * OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+ * SOFTWARE.
+ *
+ */
+
+/**
+ * @file textureAtlas.c
+ * @brief Small textures packed into a few big pages
+ *
+ * Pages are filled shelf by shelf, a texture goes on the first shelf
+ * with room that is tall enough or starts a new one under the rest.
+ * Textures arrive one at a time as the asset loader decodes them, so
+ * there is no sorting them by size first, a little space is wasted
+ * instead. Pages have no mipmaps, as the framework's own textures don't.
+ *
+ * @author Chris Camacho (codifies - http://bedroomcoders.co.uk/)
+ * @date 2026
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "textureAtlas.h"
+#include "rlgl.h"
+
+#define SHELF_GROW 8
+
+// made up page ids for an atlas that doesn't upload, clear of the loader's
+#define ATLAS_RECORDING_ID 0xff00
+
+static void* atlasRealloc(void* ptr, size_t size)
+{
+	void* p = RL_REALLOC(ptr, size);
+	if (!p) {
+		printf("Couldn't allocate memory for texture atlas\n");
+		exit(-1);
+	}
+	return p;
+}
+
+/**
+ * @brief an empty atlas, pages are made as textures need them
+ *
+ * @param atlas the atlas to set up
+ * @param pageSize width and height of each page, ATLAS_PAGE_SIZE
+ * @param upload false for an atlas that never touches the GPU, regions
+ * are placed as normal but the pages only have made up ids
+ */
+void InitTextureAtlas(TextureAtlas* atlas, int pageSize, bool upload)
+{
+	memset(atlas, 0, sizeof(TextureAtlas));
+	atlas->pageSize = pageSize;
+	atlas->upload = upload;
+}
+
+/**
+ * @brief unload the pages, every texture goes back to drawing with its own
+ */
+void FreeTextureAtlas(TextureAtlas* atlas)
+{
+	for (int i = 0; i < atlas->pageCount; i++) {
+		if (atlas->upload) rlUnloadTexture(atlas->pages[i].texture.id);
+		RL_FREE(atlas->pages[i].shelves);
+	}
+	InitTextureAtlas(atlas, atlas->pageSize, atlas->upload);
+}
+
+// a blank page, NULL if there can't be another
+static AtlasPage* addPage(TextureAtlas* atlas)
+{
+	if (atlas->pageCount == ATLAS_MAX_PAGES) return NULL;
+	AtlasPage* p = &atlas->pages[atlas->pageCount];
+	memset(p, 0, sizeof(AtlasPage));
+
+	int size = atlas->pageSize;
+	unsigned int id = ATLAS_RECORDING_ID + atlas->pageCount;
+	if (atlas->upload) id = rlLoadTexture(NULL, size, size, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, 1);
+	if (!id) return NULL;
+	p->texture = (Texture){ id, size, size, 1, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8 };
+	atlas->pageCount++;
+	return p;
+}
+
+// find room for a w by h block on a page
+static bool placeOnPage(AtlasPage* p, int size, int w, int h, int* x, int* y)
+{
+	for (int i = 0; i < p->shelfCount; i++) {
+		AtlasShelf* s = &p->shelves[i];
+		if (h <= s->height && s->used + w <= size) {
+			*x = s->used;
+			*y = s->y;
+			s->used += w;
+			return true;
+		}
+	}
+
+	if (p->top + h > size) return false;
+	if (p->shelfCount == p->shelfCapacity) {
+		p->shelfCapacity += SHELF_GROW;
+		p->shelves = atlasRealloc(p->shelves, p->shelfCapacity * sizeof(AtlasShelf));
+	}
+	p->shelves[p->shelfCount++] = (AtlasShelf){ p->top, h, w };
+	*x = 0;
+	*y = p->top;
+	p->top += h;
+	return true;
+}
+
+// place a texture and give it a region, 0 if it can't be packed, x and y
+// are the corner of its gutter
+static int reserve(TextureAtlas* atlas, const Texture* texture, int width, int height, int* x, int* y)
+{
+	if (AtlasFind(atlas, texture).index || atlas->count == ATLAS_MAX_REGIONS - 1) return 0;
+
+	// anything over half a page keeps its own texture rather than hog one
+	int size = atlas->pageSize;
+	int w = width + ATLAS_GUTTER * 2;
+	int h = height + ATLAS_GUTTER * 2;
+	if (width < 1 || height < 1 || w > size / 2 || h > size / 2) return 0;
+
+	int page = 0;
+	while (page < atlas->pageCount && !placeOnPage(&atlas->pages[page], size, w, h, x, y)) page++;
+	if (page == atlas->pageCount) {
+		AtlasPage* p = addPage(atlas);
+		if (!p || !placeOnPage(p, size, w, h, x, y)) return 0;
+	}
+
+	atlas->entries[atlas->count] = (AtlasEntry){ texture, page };
+	int index = ++atlas->count;
+	float* r = atlas->regions[index];
+	r[0] = (float)(*x + ATLAS_GUTTER) / size;
+	r[1] = (float)(*y + ATLAS_GUTTER) / size;
+	r[2] = (float)width / size;
+	r[3] = (float)height / size;
+	atlas->version++;
+	return index;
+}
+
+/**
+ * @brief give a texture a region without putting anything in it
+ *
+ * For an atlas that doesn't upload, so batching can be checked without
+ * a window.
+ *
+ * @param atlas the atlas
+ * @param texture the texture as its users hold it, it is looked up by
+ * this pointer
+ * @param width its width in texels
+ * @param height its height in texels
+ * @return false if it is too big, already packed or there is no room
+ */
+bool AtlasReserve(TextureAtlas* atlas, const Texture* texture, int width, int height)
+{
+	int x, y;
+	return reserve(atlas, texture, width, height, &x, &y) != 0;
+}
+
+// wrap a texel coordinate into 0 to n-1 the way repeat would
+static int wrapTexel(int v, int n)
+{
+	v %= n;
+	return v < 0 ? v + n : v;
+}
+
+/**
+ * @brief pack a texture's image into the atlas
+ *
+ * The texture itself is left alone, only the instanced draws use the
+ * atlas so everything else still needs it.
+ *
+ * @param atlas the atlas
+ * @param texture the texture as its users hold it, it is looked up by
+ * this pointer
+ * @param image its pixels, any uncompressed format, they are copied
+ * @return false if it wasn't packed, it is drawn with its own texture
+ */
+bool AtlasAddImage(TextureAtlas* atlas, const Texture* texture, Image image)
+{
+	if (!image.data || image.format >= PIXELFORMAT_COMPRESSED_DXT1) return false;
+
+	int x, y;
+	int index = reserve(atlas, texture, image.width, image.height, &x, &y);
+	if (!index || !atlas->upload) return index != 0;
+
+	Image rgba = ImageCopy(image);
+	ImageFormat(&rgba, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8);
+	const unsigned char* src = rgba.data;
+
+	// the gutter is what tiling would put next to each edge
+	int w = image.width + ATLAS_GUTTER * 2;
+	int h = image.height + ATLAS_GUTTER * 2;
+	unsigned char* pixels = atlasRealloc(NULL, (size_t)w * h * 4);
+	for (int j = 0; j < h; j++) {
+		int sy = wrapTexel(j - ATLAS_GUTTER, image.height);
+		for (int i = 0; i < w; i++) {
+			int sx = wrapTexel(i - ATLAS_GUTTER, image.width);
+			memcpy(&pixels[((size_t)j * w + i) * 4], &src[((size_t)sy * image.width + sx) * 4], 4);
+		}
+	}
+
+	const AtlasPage* p = &atlas->pages[atlas->entries[index - 1].page];
+	rlUpdateTexture(p->texture.id, x, y, w, h, PIXELFORMAT_UNCOMPRESSED_R8G8B8A8, pixels);
+	RL_FREE(pixels);
+	UnloadImage(rgba);
+	return true;
+}
+
+/**
+ * @brief what to bind for a texture and which region to use
+ *
+ * There are only ever a handful of textures so they are looked up by
+ * walking the entries.
+ *
+ * @param atlas the atlas
+ * @param texture the texture as its users hold it
+ * @return its page and region, or the texture itself and region 0 if it
+ * isn't packed
+ */
+AtlasRegion AtlasFind(const TextureAtlas* atlas, const Texture* texture)
+{
+	for (int i = 0; i < atlas->count; i++) {
+		const AtlasEntry* e = &atlas->entries[i];
+		if (e->texture == texture) return (AtlasRegion){ atlas->pages[e->page].texture.id, i + 1 };
+	}
+	return (AtlasRegion){ texture->id, 0 };
+}
@@ -1,4 +1,6 @@
 #include "vehicle.h"
+#include "prefab.h"
+#include <stdio.h>
 #include <stdlib.h>
 #include <math.h>
 
@@ -30,6 +32,10 @@
  * - steer: Steering angle
  */
 
+// builds a vehicle by hand, only done once for each size of vehicle to
+// make the template CreateVehicle stamps copies from
+static vehicle* buildVehicle(PhysicsContext* pctx, struct GraphicsContext* ctx, Vector3 pos, Vector3 carScale, float wheelRadius, float wheelWidth);
+
 
 /**
  * @brief Create a physics-based vehicle
@@ -49,11 +55,42 @@
  * @note Front wheels are driving wheels
  * @note Front wheels also provide steering
  * @note Anti-sway mass lowers center of gravity to prevent tipping
+ * @note vehicles are stamped out from a prefab per size, named
+ * vehicle_LxHxW_radius_width, the first of a size builds it
  *
  * @see UpdateVehicle
  * @see FreeVehicle
  */
 vehicle* CreateVehicle(PhysicsContext* pctx, struct GraphicsContext* ctx, Vector3 pos, Vector3 carScale, float wheelRadius, float wheelWidth)
+{
+    char name[64];
+    snprintf(name, sizeof(name), "vehicle_%gx%gx%g_%g_%g",
+             carScale.x, carScale.y, carScale.z, wheelRadius, wheelWidth);
+
+    Prefab* pf = GetPrefab(pctx, name);
+    if (!pf) {
+        vehicle* proto = buildVehicle(pctx, ctx, Vector3Zero(), carScale, wheelRadius, wheelWidth);
+        pf = CapturePrefab(pctx, ctx, name, Vector3Zero(),
+                           proto->bodies, proto->bodyCount, proto->joints, WHEEL_COUNT, NULL, 0);
+        FreeVehicle(pctx, proto);
+        pf = AddPrefab(pctx, pf);
+    }
+
+    vehicle* car = RL_MALLOC(sizeof(vehicle));
+    car->bodyCount = 6;
+
+    // prefab geoms are chassis, front marker then the wheels
+    dGeomID geoms[VEH_PART_COUNT - 1];
+    StampPrefab(pctx, ctx, pf, pos, QuaternionIdentity(), car->bodies, geoms, car->joints);
+    car->geoms[0] = geoms[0];
+    for (int i = 1; i <= 4; i++) car->geoms[i] = geoms[i + 1];
+    car->geoms[5] = 0; // the balance mass has no geom
+    car->geoms[6] = geoms[1];
+
+    return car;
+}
+
+static vehicle* buildVehicle(PhysicsContext* pctx, struct GraphicsContext* ctx, Vector3 pos, Vector3 carScale, float wheelRadius, float wheelWidth)
 {
     // Extract ODE world and space from the framework context
     dWorldID world = pctx->world;
@@ -64,9 +101,9 @@ vehicle* CreateVehicle(PhysicsContext* pctx, struct GraphicsContext* ctx, Vector
     car->bodyCount = 6; 
 
     // Get textures for vehicle parts
-    Texture* chassisTex = &ctx->boxTextures[0];      // crate.png
-    Texture* wheelTex = &ctx->cylinderTextures[1];   // cylinder2.png
-    Texture* markerTex = &ctx->boxTextures[1];       // grid.png
+    Texture* chassisTex = UseTexture(ctx->assets, ctx->boxTextures[0]);     // crate.png
+    Texture* wheelTex = UseTexture(ctx->assets, ctx->cylinderTextures[1]);  // cylinder2.png
+    Texture* markerTex = UseTexture(ctx->assets, ctx->boxTextures[1]);      // grid.png
 
     // Calculate wheel radius relative to car height if not explicitly specified
     // Don't scale down wheels that are appropriately sized
@@ -84,13 +121,13 @@ vehicle* CreateVehicle(PhysicsContext* pctx, struct GraphicsContext* ctx, Vector
 
     car->geoms[0] = dCreateBox(space, carScale.x, carScale.y, carScale.z);
     dGeomSetBody(car->geoms[0], car->bodies[0]);
-    dGeomSetData(car->geoms[0], CreateGeomInfo(true, chassisTex, 1.0f, 1.0f));
+    dGeomSetData(car->geoms[0], CreateGeomInfo(pctx, true, chassisTex, 1.0f, 1.0f));
     
     // Front indicator (visual aid to tell front from back)
     dGeomID frontGeom = dCreateBox(space, 0.2, 0.2, 0.2);
     dGeomSetBody(frontGeom, car->bodies[0]);
     dGeomSetOffsetPosition(frontGeom, carScale.x/2 - 0.1, carScale.y/2 + 0.1, 0);
-    dGeomSetData(frontGeom, CreateGeomInfo(true, markerTex, 1.0f, 1.0f));
+    dGeomSetData(frontGeom, CreateGeomInfo(pctx, true, markerTex, 1.0f, 1.0f));
     car->geoms[6] = frontGeom;
     
     // Anti-Sway / Low CoG Mass (Body 5)
@@ -135,7 +172,7 @@ vehicle* CreateVehicle(PhysicsContext* pctx, struct GraphicsContext* ctx, Vector
 
 		car->geoms[bIdx] = dCreateCylinder(space, scaledWheelRadius, wheelWidth);
 		dGeomSetBody(car->geoms[bIdx], car->bodies[bIdx]);
-		dGeomSetData(car->geoms[bIdx], CreateGeomInfo(true, wheelTex, 1.0f, 1.0f));
+		dGeomSetData(car->geoms[bIdx], CreateGeomInfo(pctx, true, wheelTex, 1.0f, 1.0f));
 		geomInfo* gi = dGeomGetData(car->geoms[bIdx]);
 		gi->surface = &gSurfaces[SURFACE_RUBBER];
 
@@ -165,10 +202,10 @@ vehicle* CreateVehicle(PhysicsContext* pctx, struct GraphicsContext* ctx, Vector
 
     // Link bodies to entities so drawBodies and FreeVehicle function correctly
     for (int i = 0; i < 6; i++) {
-        entity* ent = RL_MALLOC(sizeof(entity));
-        ent->body = car->bodies[i];
-        dBodySetData(car->bodies[i], ent);
-        ent->node = clistAddNode(pctx->objList, ent); //
+        AttachEntity(pctx, car->bodies[i]);
+    }
+    for (int i = 0; i < WHEEL_COUNT; i++) {
+        RegisterJoint(pctx, car->joints[i], JOINT_VEHICLE);
     }
 
     return car;
@@ -234,15 +271,18 @@ void FreeVehicle(PhysicsContext* pctx, vehicle* car)
 {
     if (!car) return;
 
+    // the wheel and marker joints would otherwise linger in the world
+    for (int i = 0; i < WHEEL_COUNT; i++) {
+        FreeJoint(pctx, car->joints[i]);
+    }
+
     for (int i = 0; i < car->bodyCount; i++) {
         // Get the entity wrapper attached to the ODE body
-        entity* ent = (entity*)dBodyGetData(car->bodies[i]);
+        entity* ent = GetBodyEntity(pctx, car->bodies[i]);
         
         if (ent) {
-            // Remove the node from the framework's render list
-            clistDeleteNode(pctx->objList, &ent->node);
-            FreeBodyAndGeoms(car->bodies[i]); 
-            RL_FREE(ent);
+            // Removes the body, its geoms and the framework's tracking
+            FreeEntity(pctx, ent);
         }
     }
     RL_FREE(car);